@@ -0,0 +1,74 @@
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include "../src/musictrack.h"
+#include "../src/durationformat.h"
+#include "benchsupport.h"
+
+using namespace std;
+
+/*
+ * Accessor Benchmark - Maître Gims Studio Management System
+ *
+ * Reads every field of many tracks the way displayTrackInfo() in
+ * main.cpp does, and reports time and heap allocations per track.
+ * Built as C++98 it measures the copying getters; built as C++17 it
+ * also measures the string_view getters and buffer formatting.
+ *
+ * Output: see benchsupport.h; one line per case.
+ */
+
+int main() {
+    const int NUM_TRACKS = 200000;
+    const int ROUNDS = 5;
+
+    vector<MusicTrack> tracks;
+    tracks.reserve(NUM_TRACKS);
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "Est-ce que tu m'aimes (Live Version " << i << ")";
+        tracks.push_back(MusicTrack(ss.str(), 120 + i % 300, (i % 2 == 0) ? "Hip-Hop" : "Pop"));
+    }
+
+    cout << "# bench_accessors std=" << __cplusplus << " tracks=" << NUM_TRACKS << endl;
+
+    // displayTrackInfo-style read with by-value getters
+    BenchCase readCopy;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            string title = tracks[i].getTitle();
+            string formatted = tracks[i].getFormattedDuration();
+            string genre = tracks[i].getGenre();
+            sink += title.size() + formatted.size() + genre.size()
+                  + tracks[i].getPlayCount() + tracks[i].isPopular();
+        }
+    }
+    readCopy.report("read_copy", NUM_TRACKS * ROUNDS);
+
+#if __cplusplus >= 201703L
+    // Same read through views and a stack buffer
+    BenchCase readView;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            char formatted[DURATION_TEXT_SIZE];
+            std::string_view title = tracks[i].getTitleView();
+            int formattedLength = tracks[i].getFormattedDuration(formatted, DURATION_TEXT_SIZE);
+            std::string_view genre = tracks[i].getGenreView();
+            sink += title.size() + formattedLength + genre.size()
+                  + tracks[i].getPlayCount() + tracks[i].isPopular();
+        }
+    }
+    readView.report("read_view", NUM_TRACKS * ROUNDS);
+
+    // Setting titles from temporaries: the one allocation per op is the
+    // temporary itself, which is then moved in instead of copied
+    BenchCase setTitle;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        tracks[i].setTitle(string(40, 'a' + i % 26));
+    }
+    setTitle.report("set_title_temporary", NUM_TRACKS);
+#endif
+
+    return 0;
+}
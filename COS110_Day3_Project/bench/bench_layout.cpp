@@ -0,0 +1,108 @@
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include "../src/musictrack.h"
+#include "../src/compacttrack.h"
+#include "benchsupport.h"
+
+using namespace std;
+
+/*
+ * Track Layout Benchmark - Maître Gims Studio Management System
+ *
+ * Compares a vector of MusicTrack objects with a CompactTrackStore
+ * (8-byte hot records plus a cold title/genre table): memory per track,
+ * and the speed of the scans reports run over every track (total plays,
+ * popular count, total runtime).
+ *
+ * Output: see benchsupport.h; the layout lines add bytes_per_track,
+ * hot_bytes_per_track and cold_bytes_per_track.
+ */
+
+int main() {
+    const int NUM_TRACKS = 2000000;
+    const int ROUNDS = 10;
+
+    vector<MusicTrack> tracks;
+    CompactTrackStore store;
+    tracks.reserve(NUM_TRACKS);
+    store.reserve(NUM_TRACKS);
+    size_t titleHeapBytes = 0;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "Est-ce que tu m'aimes (Live " << i << ")";
+        tracks.push_back(MusicTrack(ss.str(), 120 + i % 300, (i % 2 == 0) ? "Hip-Hop" : "Pop"));
+        tracks[i].setPlayCount((int)((long long)i * 7919 % 2000000));
+        store.addTrack(tracks[i]);
+        int titleLength = 0;
+        tracks[i].getTitleData(&titleLength);
+        if (titleLength > 15) {   // longer than the small-string buffer, stored with its '\0'
+            titleHeapBytes += titleLength + 1;
+        }
+    }
+
+    cout << "# bench_layout std=" << __cplusplus << " tracks=" << NUM_TRACKS
+         << " sizeof_musictrack=" << sizeof(MusicTrack) << " sizeof_compacttrack=" << sizeof(CompactTrack) << endl;
+
+    double objectBytes = (double)(tracks.capacity() * sizeof(MusicTrack) + titleHeapBytes) / NUM_TRACKS;
+    cout << "layout_musictrack bytes_per_track=" << objectBytes
+         << " hot_bytes_per_track=" << sizeof(MusicTrack)
+         << " cold_bytes_per_track=" << (double)titleHeapBytes / NUM_TRACKS << endl;
+    cout << "layout_compact bytes_per_track=" << (double)(store.hotBytes() + store.coldBytes()) / NUM_TRACKS
+         << " hot_bytes_per_track=" << (double)store.hotBytes() / NUM_TRACKS
+         << " cold_bytes_per_track=" << (double)store.coldBytes() / NUM_TRACKS << endl;
+
+    // Total plays, popular tracks and total runtime in one pass
+    {
+        BenchCase bench;
+        for (int round = 0; round < ROUNDS; round++) {
+            long long plays = 0;
+            long long seconds = 0;
+            int popular = 0;
+            for (int i = 0; i < NUM_TRACKS; i++) {
+                plays += tracks[i].getPlayCount();
+                seconds += tracks[i].getDuration();
+                popular += tracks[i].isPopular() ? 1 : 0;
+            }
+            sink += plays + seconds + popular;
+        }
+        bench.report("scan_musictrack", (long)NUM_TRACKS * ROUNDS,
+                     (double)NUM_TRACKS * ROUNDS * sizeof(MusicTrack));
+    }
+    {
+        const CompactTrack* hot = store.records();
+        BenchCase bench;
+        for (int round = 0; round < ROUNDS; round++) {
+            long long plays = 0;
+            long long seconds = 0;
+            int popular = 0;
+            for (int i = 0; i < NUM_TRACKS; i++) {
+                plays += hot[i].getPlayCount();
+                seconds += hot[i].getDuration();
+                popular += hot[i].isPopular() ? 1 : 0;
+            }
+            sink += plays + seconds + popular;
+        }
+        bench.report("scan_compact", (long)NUM_TRACKS * ROUNDS,
+                     (double)NUM_TRACKS * ROUNDS * sizeof(CompactTrack));
+    }
+
+    // Playing every track once
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            tracks[i].play();
+        }
+        bench.report("play_musictrack", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            store[i].play();
+        }
+        bench.report("play_compact", NUM_TRACKS);
+    }
+
+    return 0;
+}
@@ -0,0 +1,525 @@
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../src/musictrack.h"
+#include "../src/trackcatalog.h"
+#include "../src/catalogimporter.h"
+#include "../src/durationformat.h"
+#include "../src/trackreport.h"
+#include "../src/genreaggregator.h"
+#include "../src/columnkernels.h"
+#include "../src/playlog.h"
+#include "../src/checkpoint.h"
+#include "../src/playsketch.h"
+#include "../src/seedcatalog.h"
+#include "../src/trackpool.h"
+#include "benchsupport.h"
+
+using namespace std;
+
+/*
+ * MusicTrack Benchmark - Maître Gims Studio Management System
+ *
+ * Times every MusicTrack operation over a catalog-sized set of tracks:
+ * construction (including from the compile-time seed), copying,
+ * short-lived tracks from new/delete vs a MusicTrackPool (one at a
+ * time and in batches), each getter and setter, play(),
+ * getFormattedDuration() and isPopular(), then the TrackCatalog and
+ * CatalogImporter paths that do the same work in bulk, and the full
+ * catalog report (displayTrackInfo-style endl output vs the buffered
+ * TrackReportWriter, both into /dev/null), per-genre totals and the
+ * column kernels at each level the CPU supports. catalog_play is also
+ * timed with a PlayLog attached in each durability mode (sync-each
+ * over fewer plays, since every play waits for the disk), and with
+ * minute/hour/day play windows enabled. The raw-stream sketch is
+ * timed per play, and merging one per-thread sketch into another.
+ * Checkpoints are timed as a full base image, a delta holding 1% of
+ * the tracks, and a restart that loads both.
+ *
+ * Output: see benchsupport.h; one line per case.
+ */
+
+int main() {
+    const int NUM_TRACKS = 1000000;
+    const char* GENRES[] = { "Hip-Hop", "Pop", "R&B", "Rap" };
+
+    // Inputs are built up front so the cases only time the track itself
+    vector<string> titles(NUM_TRACKS);
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "Sapés comme jamais (Live " << i << ")";
+        titles[i] = ss.str();
+    }
+    string genreNames[4];
+    for (int g = 0; g < 4; g++) {
+        genreNames[g] = GENRES[g];
+    }
+
+    cout << "# bench_musictrack std=" << __cplusplus << " tracks=" << NUM_TRACKS << endl;
+
+    // Construction
+
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            MusicTrack track;
+            sink += track.duration;
+        }
+        bench.report("construct_default", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            MusicTrack track(titles[i], 120 + i % 300, genreNames[i % 4]);
+            sink += track.duration;
+        }
+        bench.report("construct_params", NUM_TRACKS);
+    }
+    {
+        TitleArena arena;
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            MusicTrack track(arena, titles[i], 120 + i % 300, genreNames[i % 4]);
+            sink += track.duration;
+        }
+        bench.report("construct_arena", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            MusicTrack track(GIMS_SEED_TRACKS[i % GIMS_SEED_COUNT]);
+            sink += track.duration;
+        }
+        bench.report("construct_seed", NUM_TRACKS);
+    }
+    {
+        const int SEED_LOADS = NUM_TRACKS / GIMS_SEED_COUNT;
+        BenchCase bench;
+        for (int i = 0; i < SEED_LOADS; i++) {
+            TrackCatalog seeded;
+            seeded.addSeedTracks(GIMS_SEED_TRACKS, GIMS_SEED_COUNT);
+            sink += seeded.size();
+        }
+        bench.report("catalog_add_seed", SEED_LOADS * GIMS_SEED_COUNT);
+    }
+
+    vector<MusicTrack> tracks;
+    tracks.reserve(NUM_TRACKS);
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        tracks.push_back(MusicTrack(titles[i], 120 + i % 300, genreNames[i % 4]));
+        tracks[i].playCount = (int)((long long)i * 7919 % 2000000);
+    }
+
+    {
+        vector<MusicTrack> copies;
+        copies.reserve(NUM_TRACKS);
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            copies.push_back(tracks[i]);
+        }
+        bench.report("copy", NUM_TRACKS);
+    }
+
+    // Short-lived tracks: batches of requests built and thrown away
+
+    const int BATCH = 1000;
+    {
+        vector<MusicTrack*> batch(BATCH);
+        BenchCase bench;
+        for (int first = 0; first < NUM_TRACKS; first += BATCH) {
+            for (int i = 0; i < BATCH; i++) {
+                batch[i] = new MusicTrack(tracks[first + i]);
+            }
+            for (int i = 0; i < BATCH; i++) {
+                sink += batch[i]->duration;
+                delete batch[i];
+            }
+        }
+        bench.report("new_delete_batch", NUM_TRACKS);
+    }
+    {
+        MusicTrackPool pool;
+        vector<MusicTrack*> batch(BATCH);
+        BenchCase bench;
+        for (int first = 0; first < NUM_TRACKS; first += BATCH) {
+            for (int i = 0; i < BATCH; i++) {
+                batch[i] = pool.create(tracks[first + i]);
+            }
+            for (int i = 0; i < BATCH; i++) {
+                sink += batch[i]->duration;
+                pool.release(batch[i]);
+            }
+        }
+        bench.report("pool_create_release", NUM_TRACKS);
+    }
+    {
+        MusicTrackPool pool;
+        vector<MusicTrack*> batch(BATCH);
+        BenchCase bench;
+        for (int first = 0; first < NUM_TRACKS; first += BATCH) {
+            pool.createMany(&tracks[first], BATCH, &batch[0]);
+            for (int i = 0; i < BATCH; i++) {
+                sink += batch[i]->duration;
+            }
+            pool.releaseAll();
+        }
+        bench.report("pool_bulk_batch", NUM_TRACKS);
+    }
+
+    // Getters
+
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            sink += tracks[i].getTitle().size();
+        }
+        bench.report("get_title", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            sink += tracks[i].getDuration();
+        }
+        bench.report("get_duration", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            sink += tracks[i].getGenre().size();
+        }
+        bench.report("get_genre", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            sink += tracks[i].getGenreId();
+        }
+        bench.report("get_genre_id", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            sink += tracks[i].getPlayCount();
+        }
+        bench.report("get_play_count", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            sink += tracks[i].getFormattedDuration().size();
+        }
+        bench.report("formatted_duration", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            char formatted[DURATION_TEXT_SIZE];
+            sink += tracks[i].getFormattedDuration(formatted, DURATION_TEXT_SIZE);
+        }
+        bench.report("formatted_duration_buffer", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            sink += tracks[i].isPopular();
+        }
+        bench.report("is_popular", NUM_TRACKS);
+    }
+
+    // Setters and play counting
+
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            tracks[i].setTitle(titles[NUM_TRACKS - 1 - i]);
+        }
+        bench.report("set_title", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            tracks[i].setDuration(180 + i % 60);
+        }
+        bench.report("set_duration", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            tracks[i].setGenre(genreNames[(i + 1) % 4]);
+        }
+        bench.report("set_genre", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            tracks[i].setPlayCount(i);
+        }
+        bench.report("set_play_count", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            tracks[i].play();
+        }
+        bench.report("play", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            tracks[i].resetPlayCount();
+        }
+        bench.report("reset_play_count", NUM_TRACKS);
+    }
+    tracks.clear();
+
+    // The same work through TrackCatalog's columns
+
+    TrackCatalog catalog;
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            catalog.addTrack(titles[i], 120 + i % 300, genreNames[i % 4]);
+        }
+        bench.report("catalog_add_track", NUM_TRACKS);
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            catalog.play(i);
+        }
+        bench.report("catalog_play", NUM_TRACKS);
+    }
+    {
+        TrackCatalog windowed;
+        windowed.reserve(NUM_TRACKS);
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            windowed.addTrack(titles[i], 120 + i % 300, genreNames[i % 4]);
+        }
+        windowed.enablePlayWindows();
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            windowed.play(i);
+        }
+        bench.report("catalog_play_windows", NUM_TRACKS);
+    }
+    {
+        TrackCatalog windowed;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            windowed.addTrack(titles[i], 120 + i % 300, genreNames[i % 4]);
+            windowed.setPlayCount(i, i);
+        }
+        windowed.enablePlayWindows();
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            windowed.play((int)((long long)i * 7919 % NUM_TRACKS) / 2);
+        }
+        BenchCase bench;
+        vector<int> trending = windowed.trendingTracks(100);
+        bench.report("catalog_trending_top100", NUM_TRACKS);
+    }
+    {
+        const char* LOG_PATH = "bench_playlog.log";
+        const char* MODE_NAMES[] = { "catalog_play_log_buffered", "catalog_play_log_group_commit",
+                                     "catalog_play_log_sync_each" };
+        for (int mode = PLAYLOG_BUFFERED; mode <= PLAYLOG_SYNC_EACH; mode++) {
+            int plays = (mode == PLAYLOG_SYNC_EACH) ? NUM_TRACKS / 1000 : NUM_TRACKS;
+            remove(LOG_PATH);
+            PlayLog log;
+            log.open(LOG_PATH, (PlayLogDurability)mode);
+            catalog.attachPlayLog(&log);
+            BenchCase bench;
+            for (int i = 0; i < plays; i++) {
+                catalog.play(i);
+            }
+            log.sync();
+            bench.report(MODE_NAMES[mode], plays);
+            catalog.attachPlayLog(NULL);
+        }
+
+        // Batched ingest, the way a play-event feed arrives
+        const int BATCH_SIZE = 4096;
+        vector<PlayEvent> stream(NUM_TRACKS);
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            stream[i].trackId = (int)((long long)i * 7919 % NUM_TRACKS);
+            stream[i].count = 1;
+        }
+        for (int logged = 0; logged < 2; logged++) {
+            remove(LOG_PATH);
+            PlayLog log;
+            if (logged) {
+                log.open(LOG_PATH, PLAYLOG_GROUP_COMMIT);
+                catalog.attachPlayLog(&log);
+            }
+            vector<PlayEvent> batch(stream);
+            BenchCase bench;
+            for (int start = 0; start < NUM_TRACKS; start += BATCH_SIZE) {
+                int count = (NUM_TRACKS - start < BATCH_SIZE) ? NUM_TRACKS - start : BATCH_SIZE;
+                catalog.applyPlayEvents(&batch[start], count);
+            }
+            log.sync();
+            bench.report(logged ? "catalog_apply_events_log_group_commit" : "catalog_apply_events", NUM_TRACKS);
+            catalog.attachPlayLog(NULL);
+        }
+        remove(LOG_PATH);
+    }
+    {
+        const string BASE_PATH = "bench_checkpoint.bin";
+        remove(BASE_PATH.c_str());
+        remove((BASE_PATH + ".delta").c_str());
+        TrackCatalog saved;
+        CatalogCheckpoint checkpoints(BASE_PATH);
+        checkpoints.load(saved);
+        saved.enableChangeTracking();
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            saved.addTrack(titles[i], 120 + i % 300, genreNames[i % 4]);
+        }
+        {
+            BenchCase bench;
+            checkpoints.compact(saved);
+            bench.report("checkpoint_full", NUM_TRACKS);
+        }
+        const int CHANGED = NUM_TRACKS / 100;
+        for (int i = 0; i < CHANGED; i++) {
+            saved.play((int)((long long)i * 7919 % NUM_TRACKS));
+        }
+        {
+            BenchCase bench;
+            checkpoints.checkpoint(saved);
+            bench.report("checkpoint_delta_1pct", checkpoints.getLastEntryCount());
+        }
+        {
+            TrackCatalog restarted;
+            BenchCase bench;
+            CatalogCheckpoint(BASE_PATH).load(restarted);
+            bench.report("checkpoint_restart", restarted.size());
+        }
+        remove(BASE_PATH.c_str());
+        remove((BASE_PATH + ".delta").c_str());
+    }
+    {
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            sink += catalog.isPopular(i);
+        }
+        bench.report("catalog_is_popular", NUM_TRACKS);
+    }
+
+    // Per-genre totals: object loop vs GenreAggregator on 1 and 4 threads
+    {
+        BenchCase bench;
+        long long genrePlays[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            MusicTrack track = catalog.getTrack(i);
+            for (int g = 0; g < 4; g++) {
+                if (track.getGenre() == genreNames[g]) {
+                    genrePlays[g] += track.getPlayCount();
+                }
+            }
+        }
+        sink += genrePlays[0];
+        bench.report("genre_totals_objects", NUM_TRACKS);
+    }
+    for (int threads = 1; threads <= 4; threads *= 4) {
+        GenreAggregator aggregator(catalog);
+        aggregator.setThreadCount(threads);
+        BenchCase bench;
+        sink += aggregator.aggregate().size();
+        bench.report(threads == 1 ? "genre_totals_1_thread" : "genre_totals_4_threads", NUM_TRACKS);
+    }
+
+    // Popularity scans: isPopular() per track vs the column kernels
+    {
+        BenchCase bench;
+        int popular = 0;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            popular += catalog.isPopular(i) ? 1 : 0;
+        }
+        sink += popular;
+        bench.report("count_popular_loop", NUM_TRACKS);
+    }
+    vector<int> popularIds(NUM_TRACKS);
+    for (int level = KERNEL_SCALAR; level <= (int)getSupportedKernelLevel(); level++) {
+        setKernelLevel((KernelLevel)level);
+        string suffix = string("_") + kernelLevelName((KernelLevel)level);
+        {
+            BenchCase bench;
+            sink += catalog.countPopular();
+            bench.report(("count_popular" + suffix).c_str(), NUM_TRACKS);
+        }
+        {
+            BenchCase bench;
+            sink += selectAbove(catalog.playCountData(), NUM_TRACKS, NUM_TRACKS / 2, &popularIds[0]);
+            bench.report(("select_half" + suffix).c_str(), NUM_TRACKS);
+        }
+        {
+            BenchCase bench;
+            sink += catalog.playCountStats().sum + catalog.durationStats().sum;
+            bench.report(("column_stats" + suffix).c_str(), 2 * NUM_TRACKS);
+        }
+    }
+    setKernelLevel(getSupportedKernelLevel());
+
+    // Bulk import of the same rows
+    string csv;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << titles[i] << "," << 120 + i % 300 << "," << GENRES[i % 4] << "," << i << "\n";
+        csv += ss.str();
+    }
+    {
+        TrackCatalog imported;
+        CatalogImporter importer(imported);
+        BenchCase bench;
+        importer.importBuffer(csv.data(), csv.size());
+        bench.report("import_csv", NUM_TRACKS, (double)csv.size());
+    }
+
+    // Full catalog report, one record per track
+    {
+        ofstream devNull("/dev/null");
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            MusicTrack track = catalog.getTrack(i);
+            devNull << "🎵 Track: " << track.getTitle() << endl;
+            devNull << "   Duration: " << track.getFormattedDuration()
+                    << " (" << track.getDuration() << " seconds)" << endl;
+            devNull << "   Genre: " << track.getGenre() << endl;
+            devNull << "   Play Count: " << track.getPlayCount() << endl;
+            devNull << "   Popular: " << (track.isPopular() ? "Yes" : "No") << endl;
+            devNull << endl;
+        }
+        bench.report("report_endl", NUM_TRACKS);
+    }
+    {
+        int fd = open("/dev/null", O_WRONLY);
+        TrackReportWriter report(fd);
+        BenchCase bench;
+        report.writeCatalog(catalog);
+        report.flush();
+        bench.report("report_buffered", NUM_TRACKS, (double)report.getBytesWritten());
+        close(fd);
+    }
+
+    // Raw play stream with mostly unknown keys
+    {
+        PlayStreamSketch sketch;
+        PlayStreamSketch other;
+        BenchCase bench;
+        for (int i = 0; i < NUM_TRACKS; i++) {
+            uint64_t key = (i % 4 == 0) ? (uint64_t)(i % 1000) : (uint64_t)i * 7919;
+            sketch.record(key, (uint64_t)i);
+        }
+        bench.report("sketch_record", NUM_TRACKS);
+        for (int i = 0; i < NUM_TRACKS / 10; i++) {
+            other.record((uint64_t)(i % 1000), (uint64_t)i);
+        }
+        BenchCase merge;
+        sketch.merge(other);
+        merge.report("sketch_merge", 1, (double)sketch.memoryBytes());
+    }
+
+    return 0;
+}
@@ -0,0 +1,218 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <pthread.h>
+#include <time.h>
+#include "../src/trackcatalog.h"
+#include "../src/catalogserver.h"
+#include "../src/catalogclient.h"
+
+using namespace std;
+
+/*
+ * Catalog Server Load Generator - Maître Gims Studio Management System
+ *
+ * Loopback clients against a CatalogServer. Each case runs C client
+ * connections, one thread each, that keep sending batches of D
+ * pipelined requests and wait for the D answers before the next batch.
+ * A request's latency runs from the flush of its batch to its answer.
+ * The mix is 90% PLAY, 8% GET, 1% POPULAR and 1% TOP 10 over random
+ * tracks.
+ *
+ *   bench_server                   in-process server, TCP and Unix socket
+ *   bench_server <port>            running catalog_server on 127.0.0.1
+ *   bench_server <socket path>     running catalog_server on a Unix socket
+ *
+ * Output: one line per case, in the key=value style of benchsupport.h:
+ *
+ *   name req_per_sec=... p50_us=... p99_us=... max_us=...
+ */
+
+static double nowMicroseconds() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+struct Target {
+    int port;               // 0 for a Unix socket
+    string socketPath;
+    int trackCount;
+};
+
+struct LoadWorker {
+    const Target* target;
+    int depth;
+    int requestCount;
+    unsigned int seed;
+    vector<float> latencies;
+    bool ok;
+};
+
+static bool connectTo(CatalogClient& client, const Target& target) {
+    return target.port > 0 ? client.connectTcp("127.0.0.1", target.port) : client.connectUnix(target.socketPath);
+}
+
+/**
+ * Build the request mix up front so the timed loop only does I/O
+ */
+static vector<string> buildRequests(int count, int trackCount, unsigned int seed) {
+    vector<string> requests(count);
+    for (int i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int id = (int)((seed >> 8) % (unsigned int)trackCount);
+        int kind = (int)((seed >> 4) % 100);
+        stringstream ss;
+        if (kind < 90) {
+            ss << "PLAY " << id;
+        } else if (kind < 98) {
+            ss << "GET " << id;
+        } else if (kind < 99) {
+            ss << "POPULAR " << id;
+        } else {
+            ss << "TOP 10";
+        }
+        requests[i] = ss.str();
+    }
+    return requests;
+}
+
+static void* generateLoad(void* arg) {
+    LoadWorker* worker = (LoadWorker*)arg;
+    vector<string> requests = buildRequests(worker->requestCount, worker->target->trackCount, worker->seed);
+    worker->latencies.reserve(worker->requestCount);
+
+    CatalogClient client;
+    worker->ok = connectTo(client, *worker->target);
+    string response;
+    for (int first = 0; first < worker->requestCount && worker->ok; first += worker->depth) {
+        int last = min(first + worker->depth, worker->requestCount);
+        for (int i = first; i < last; i++) {
+            client.send(requests[i]);
+        }
+        double sent = nowMicroseconds();
+        worker->ok = client.flush();
+        for (int i = first; i < last && worker->ok; i++) {
+            worker->ok = client.receive(response) && response.compare(0, 3, "OK ") == 0;
+            worker->latencies.push_back((float)(nowMicroseconds() - sent));
+        }
+    }
+    return NULL;
+}
+
+static double percentile(vector<float>& values, double fraction) {
+    if (values.empty()) {
+        return 0;
+    }
+    size_t index = (size_t)(fraction * (values.size() - 1));
+    nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static void runCase(const string& name, const Target& target, int connections, int depth, int totalRequests) {
+    vector<LoadWorker> workers(connections);
+    vector<pthread_t> threads(connections);
+    double start = nowMicroseconds();
+    for (int i = 0; i < connections; i++) {
+        workers[i].target = &target;
+        workers[i].depth = depth;
+        workers[i].requestCount = totalRequests / connections;
+        workers[i].seed = 7919u * (i + 1);
+        workers[i].ok = false;
+        pthread_create(&threads[i], NULL, generateLoad, &workers[i]);
+    }
+
+    vector<float> latencies;
+    bool ok = true;
+    for (int i = 0; i < connections; i++) {
+        pthread_join(threads[i], NULL);
+        latencies.insert(latencies.end(), workers[i].latencies.begin(), workers[i].latencies.end());
+        ok = ok && workers[i].ok;
+    }
+    double seconds = (nowMicroseconds() - start) / 1e6;
+
+    if (!ok) {
+        cout << name << " failed" << endl;
+        return;
+    }
+    double p50 = percentile(latencies, 0.50);
+    double p99 = percentile(latencies, 0.99);
+    double worst = percentile(latencies, 1.0);
+    cout << name << " req_per_sec=" << latencies.size() / seconds << " p50_us=" << p50
+         << " p99_us=" << p99 << " max_us=" << worst << endl;
+}
+
+static void runSuite(const Target& target, const string& prefix) {
+    const int REQUESTS = 200000;
+    runCase(prefix + "_c1_d1", target, 1, 1, REQUESTS / 4);
+    runCase(prefix + "_c4_d1", target, 4, 1, REQUESTS / 2);
+    runCase(prefix + "_c4_d16", target, 4, 16, REQUESTS * 2);
+    runCase(prefix + "_c16_d64", target, 16, 64, REQUESTS * 4);
+}
+
+struct ServerThread {
+    CatalogServer* server;
+};
+
+static void* runServer(void* arg) {
+    ((ServerThread*)arg)->server->run();
+    return NULL;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        // A server that is already running
+        string where = argv[1];
+        Target target;
+        bool tcp = where.find_first_not_of("0123456789") == string::npos;
+        target.port = tcp ? atoi(where.c_str()) : 0;
+        target.socketPath = tcp ? "" : where;
+
+        CatalogClient client;
+        string size;
+        if (!connectTo(client, target) || !client.call("SIZE", size) || size.compare(0, 3, "OK ") != 0) {
+            cerr << "❌ No catalog server at " << where << endl;
+            return 1;
+        }
+        target.trackCount = atoi(size.c_str() + 3);
+        if (target.trackCount <= 0) {
+            cerr << "❌ The catalog at " << where << " is empty" << endl;
+            return 1;
+        }
+        cout << "# bench_server external=" << where << " tracks=" << target.trackCount << endl;
+        runSuite(target, tcp ? "tcp" : "unix");
+        return 0;
+    }
+
+    const int NUM_TRACKS = 100000;
+    TrackCatalog catalog;
+    catalog.reserve(NUM_TRACKS);
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "Sapés comme jamais (Live " << i << ")";
+        catalog.addTrack(ss.str(), 120 + i % 300, i % 2 == 0 ? "Hip-Hop" : "Pop");
+    }
+
+    CatalogServer server(catalog);
+    string socketPath = "/tmp/bench_server_catalog.sock";
+    if (!server.listenTcp(0) || !server.listenUnix(socketPath)) {
+        cerr << "❌ Could not start the catalog server" << endl;
+        return 1;
+    }
+    ServerThread context = { &server };
+    pthread_t thread;
+    pthread_create(&thread, NULL, runServer, &context);
+
+    cout << "# bench_server std=" << __cplusplus << " tracks=" << NUM_TRACKS << " server_threads=1" << endl;
+    Target tcp = { server.getPort(), "", NUM_TRACKS };
+    Target local = { 0, socketPath, NUM_TRACKS };
+    runSuite(tcp, "tcp");
+    runSuite(local, "unix");
+
+    server.stop();
+    pthread_join(thread, NULL);
+    return 0;
+}
@@ -0,0 +1,102 @@
+#ifndef BENCHSUPPORT_H
+#define BENCHSUPPORT_H
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <time.h>
+using namespace std;
+
+/*
+ * Benchmark Support - Maître Gims Studio Management System
+ *
+ * Shared timing, allocation counting and reporting for the programs in
+ * bench/. Every case prints one line of space-separated key=value pairs:
+ *
+ *   name ns_per_op=... allocs_per_op=... ops_per_sec=... [mb_per_sec=...]
+ *
+ * so results can be diffed or collected between releases. Lines starting
+ * with '#' describe the run (build mode, sizes).
+ *
+ * This header replaces the global operator new and delete, so include it
+ * from exactly one source file of each benchmark program.
+ */
+
+// GCC cannot tell that the replacement operators below pair malloc/free
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+// Count every heap allocation made by the benchmark. Server and play log
+// cases allocate from several threads, so the count is updated atomically.
+static long allocationCount = 0;
+
+#if __cplusplus >= 201103L
+void* operator new(size_t size) {
+#else
+void* operator new(size_t size) throw(bad_alloc) {
+#endif
+    __atomic_fetch_add(&allocationCount, 1, __ATOMIC_RELAXED);
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == NULL) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) throw() {
+    free(memory);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+#endif
+
+static double nowNanoseconds() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Keeps the compiler from optimizing the measured work away
+static volatile size_t sink = 0;
+
+/**
+ * BenchCase - times one case from construction to report()
+ * Usage:
+ *   BenchCase bench;
+ *   for (...) { ... }
+ *   bench.report("play", ops);
+ */
+class BenchCase {
+public:
+    BenchCase() : allocationsAtStart(__atomic_load_n(&allocationCount, __ATOMIC_RELAXED)), startNanoseconds(nowNanoseconds()) {}
+
+    /**
+     * Print the case's result line
+     * @param name Case name (no spaces)
+     * @param ops Number of operations performed
+     * @param bytes Bytes processed, for throughput cases (0 to omit)
+     */
+    void report(const char* name, long ops, double bytes = 0) const {
+        double elapsed = nowNanoseconds() - startNanoseconds;
+        long allocations = __atomic_load_n(&allocationCount, __ATOMIC_RELAXED) - allocationsAtStart;
+        if (ops <= 0 || elapsed <= 0) {
+            return;
+        }
+        cout << name
+             << " ns_per_op=" << elapsed / ops
+             << " allocs_per_op=" << (double)allocations / ops
+             << " ops_per_sec=" << ops / (elapsed / 1e9);
+        if (bytes > 0) {
+            cout << " mb_per_sec=" << bytes / (1024.0 * 1024.0) / (elapsed / 1e9);
+        }
+        cout << endl;
+    }
+
+private:
+    long allocationsAtStart;
+    double startNanoseconds;
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "catalogclient.h"
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <stdint.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+using namespace std;
+
+CatalogClient::CatalogClient() : fd(-1), inputStart(0) {
+}
+
+CatalogClient::~CatalogClient() {
+    disconnect();
+}
+
+// Connecting
+
+bool CatalogClient::connectTo(int domain, const void* address, unsigned int addressLength) {
+    disconnect();
+    int socketFd = socket(domain, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socketFd < 0) {
+        return false;
+    }
+    int result;
+    do {
+        result = connect(socketFd, (const sockaddr*)address, addressLength);
+    } while (result != 0 && errno == EINTR);
+    if (result != 0) {
+        close(socketFd);
+        return false;
+    }
+    if (domain == AF_INET) {
+        // Requests are already batched by flush(), so don't let Nagle hold them back
+        int on = 1;
+        setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    }
+    fd = socketFd;
+    return true;
+}
+
+bool CatalogClient::connectTcp(const string& host, int port) {
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port);
+    if (port <= 0 || port > 65535 || inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        return false;
+    }
+    return connectTo(AF_INET, &address, sizeof(address));
+}
+
+bool CatalogClient::connectUnix(const string& path) {
+    sockaddr_un address;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size());
+    return connectTo(AF_UNIX, &address, sizeof(address));
+}
+
+bool CatalogClient::isConnected() const {
+    return fd >= 0;
+}
+
+void CatalogClient::disconnect() {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+    output.clear();
+    input.clear();
+    inputStart = 0;
+}
+
+// Requests and responses
+
+bool CatalogClient::send(const string& request) {
+    if (fd < 0) {
+        return false;
+    }
+    output += request;
+    output += '\n';
+    return output.size() < MAX_QUEUED_BYTES || flush();
+}
+
+/**
+ * Flush
+ * Loop over short writes and EINTR; any other error closes the connection
+ */
+bool CatalogClient::flush() {
+    size_t done = 0;
+    while (fd >= 0 && done < output.size()) {
+        ssize_t sent = ::send(fd, output.data() + done, output.size() - done, MSG_NOSIGNAL);
+        if (sent > 0) {
+            done += sent;
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else {
+            disconnect();
+            return false;
+        }
+    }
+    output.clear();
+    return fd >= 0;
+}
+
+bool CatalogClient::receive(string& response) {
+    if (!output.empty() && !flush()) {
+        return false;
+    }
+    while (fd >= 0) {
+        const char* start = input.data() + inputStart;
+        const char* newline = (const char*)memchr(start, '\n', input.size() - inputStart);
+        if (newline != NULL) {
+            response.assign(start, newline - start);
+            inputStart += (newline - start) + 1;
+            if (inputStart == input.size()) {
+                input.clear();
+                inputStart = 0;
+            }
+            return true;
+        }
+
+        // Keep only the unfinished line, then read more
+        input.erase(0, inputStart);
+        inputStart = 0;
+        char buffer[16 * 1024];
+        ssize_t got = recv(fd, buffer, sizeof(buffer), 0);
+        if (got > 0) {
+            input.append(buffer, got);
+        } else if (got < 0 && errno == EINTR) {
+            continue;
+        } else {
+            disconnect();
+        }
+    }
+    return false;
+}
+
+bool CatalogClient::call(const string& request, string& response) {
+    return send(request) && receive(response);
+}
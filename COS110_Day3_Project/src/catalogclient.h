@@ -0,0 +1,106 @@
+#ifndef CATALOGCLIENT_H
+#define CATALOGCLIENT_H
+
+#include <string>
+using namespace std;
+
+/**
+ * CatalogClient Class - Maître Gims Studio Management System
+ *
+ * Blocking client for a CatalogServer (see catalogserver.h for the
+ * protocol), over TCP or a Unix socket.
+ *
+ * Requests are queued by send() and go out together on flush(), and
+ * receive() returns the answers in the same order, so a batch of N
+ * requests costs one round trip instead of N:
+ *
+ *   client.send("PLAY 12");
+ *   client.send("GET 12");
+ *   client.flush();
+ *   client.receive(first);    // "OK 1001"
+ *   client.receive(second);   // "OK 1001"
+ *
+ * Keep a batch to a few thousand requests before receiving: the server
+ * stops reading from a client whose unread answers pile up, and a
+ * client still sending would then wait forever.
+ *
+ * call() does the same for a single request. Any I/O error closes the
+ * connection and makes every later call return false. Not thread-safe;
+ * use one client per thread.
+ */
+class CatalogClient {
+public:
+    CatalogClient();
+
+    /**
+     * Destructor
+     * Closes the connection
+     */
+    ~CatalogClient();
+
+    /**
+     * Connect over TCP
+     * @param host IPv4 address, e.g. "127.0.0.1"
+     * @param port Server port
+     * @return true on success
+     */
+    bool connectTcp(const string& host, int port);
+
+    /**
+     * Connect over a Unix socket
+     * @param path Socket path given to CatalogServer::listenUnix()
+     * @return true on success
+     */
+    bool connectUnix(const string& path);
+
+    bool isConnected() const;
+
+    /**
+     * Close the connection; queued requests are dropped
+     */
+    void disconnect();
+
+    /**
+     * Queue one request; it is sent by flush() or when the queue is full
+     * @param request Request line without the '\n'
+     * @return false if not connected
+     */
+    bool send(const string& request);
+
+    /**
+     * Send every queued request
+     * @return false if the connection failed
+     */
+    bool flush();
+
+    /**
+     * Wait for the next response, flushing queued requests first
+     * @param response Receives the response line without the '\n'
+     * @return false if the connection failed or was closed
+     */
+    bool receive(string& response);
+
+    /**
+     * Send one request and wait for its response
+     * @param request Request line without the '\n'
+     * @param response Receives the response line
+     * @return false if the connection failed
+     */
+    bool call(const string& request, string& response);
+
+private:
+    static const size_t MAX_QUEUED_BYTES = 64 * 1024;
+
+    int fd;
+    string output;          // queued requests
+    string input;           // received bytes not yet returned, from inputStart
+    size_t inputStart;
+
+    bool connectTo(int domain, const void* address, unsigned int addressLength);
+
+    // A client owns a socket - disable copying
+    CatalogClient(const CatalogClient&);
+    CatalogClient& operator=(const CatalogClient&);
+};
+
+#endif
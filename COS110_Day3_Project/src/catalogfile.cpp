@@ -0,0 +1,411 @@
+#include "catalogfile.h"
+#include "durationformat.h"
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+using namespace std;
+
+static const char CATALOG_MAGIC[8] = { 'G', 'I', 'M', 'S', 'C', 'A', 'T', '\0' };
+
+/**
+ * Round a section size up to the next 8-byte boundary
+ */
+static uint64_t alignTo8(uint64_t value) {
+    return (value + 7) & ~(uint64_t)7;
+}
+
+/**
+ * Write bytes followed by zero padding up to an 8-byte boundary
+ */
+static bool writeSection(FILE* file, const void* data, uint64_t size) {
+    static const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    if (size > 0 && fwrite(data, 1, size, file) != size) {
+        return false;
+    }
+    uint64_t padSize = alignTo8(size) - size;
+    return padSize == 0 || fwrite(padding, 1, padSize, file) == padSize;
+}
+
+/**
+ * Write Catalog File
+ * Build the offset tables, then stream every section to a temporary
+ * file and rename it over the destination
+ */
+bool writeCatalogFile(const TrackCatalog& catalog, const string& path) {
+    uint32_t trackCount = catalog.size();
+    uint32_t genreCount = catalog.genreCount();
+
+    // String heap layout: every title, then every genre name
+    vector<uint64_t> titleOffsets(trackCount + 1);
+    uint64_t heapSize = 0;
+    for (uint32_t i = 0; i < trackCount; i++) {
+        int length = 0;
+        catalog.getTitleData(i, &length);
+        titleOffsets[i] = heapSize;
+        heapSize += length;
+    }
+    titleOffsets[trackCount] = heapSize;
+
+    vector<string> genreNames(genreCount);
+    vector<uint64_t> genreOffsets(genreCount + 1);
+    for (uint32_t g = 0; g < genreCount; g++) {
+        genreNames[g] = catalog.genreName(g);
+        genreOffsets[g] = heapSize;
+        heapSize += genreNames[g].size();
+    }
+    genreOffsets[genreCount] = heapSize;
+
+    CatalogFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CATALOG_MAGIC, sizeof(header.magic));
+    header.version = CATALOG_FILE_VERSION;
+    header.headerSize = sizeof(CatalogFileHeader);
+    header.trackCount = trackCount;
+    header.genreCount = genreCount;
+
+    uint64_t columnSize = (uint64_t)trackCount * sizeof(int32_t);
+    header.durationsOffset = alignTo8(sizeof(CatalogFileHeader));
+    header.playCountsOffset = header.durationsOffset + alignTo8(columnSize);
+    header.genreIdsOffset = header.playCountsOffset + alignTo8(columnSize);
+    header.titleOffsetsOffset = header.genreIdsOffset + alignTo8(columnSize);
+    header.genreOffsetsOffset = header.titleOffsetsOffset + (trackCount + 1) * sizeof(uint64_t);
+    header.stringHeapOffset = header.genreOffsetsOffset + (genreCount + 1) * sizeof(uint64_t);
+    header.stringHeapSize = heapSize;
+    header.fileSize = header.stringHeapOffset + alignTo8(heapSize);
+
+    string tempPath = path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == NULL) {
+        return false;
+    }
+
+    // Play counts are written from getPlayCount() so uncollected
+    // concurrent plays are included
+    vector<int32_t> playCounts(trackCount);
+    for (uint32_t i = 0; i < trackCount; i++) {
+        playCounts[i] = catalog.getPlayCount(i);
+    }
+
+    bool ok = writeSection(file, &header, sizeof(header))
+           && writeSection(file, catalog.durationData(), columnSize)
+           && writeSection(file, trackCount > 0 ? &playCounts[0] : NULL, columnSize)
+           && writeSection(file, catalog.genreIdData(), columnSize)
+           && writeSection(file, &titleOffsets[0], titleOffsets.size() * sizeof(uint64_t))
+           && writeSection(file, &genreOffsets[0], genreOffsets.size() * sizeof(uint64_t));
+
+    for (uint32_t i = 0; ok && i < trackCount; i++) {
+        int length = 0;
+        const char* title = catalog.getTitleData(i, &length);
+        ok = length == 0 || fwrite(title, 1, length, file) == (size_t)length;
+    }
+    for (uint32_t g = 0; ok && g < genreCount; g++) {
+        ok = genreNames[g].empty() || fwrite(genreNames[g].data(), 1, genreNames[g].size(), file) == genreNames[g].size();
+    }
+    if (ok && alignTo8(heapSize) != heapSize) {
+        static const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        size_t padSize = alignTo8(heapSize) - heapSize;
+        ok = fwrite(padding, 1, padSize, file) == padSize;
+    }
+
+    ok = (fflush(file) == 0) && ok;
+    ok = (fsync(fileno(file)) == 0) && ok;
+    ok = (fclose(file) == 0) && ok;
+
+    if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Load Catalog File
+ * Map the file, size the columns once, then append every track
+ */
+bool loadCatalogFile(const string& path, TrackCatalog& catalog) {
+    MappedCatalog mapped;
+    if (!mapped.open(path)) {
+        return false;
+    }
+
+    int trackCount = mapped.size();
+    size_t titleBytes = 0;
+    for (int id = 0; id < trackCount; id++) {
+        int length = 0;
+        mapped.getTitleData(id, &length);
+        titleBytes += length;
+    }
+    catalog.reserve(catalog.size() + trackCount, titleBytes);
+
+    vector<string> genreNames(mapped.genreCount());
+    for (int g = 0; g < mapped.genreCount(); g++) {
+        int length = 0;
+        const char* name = mapped.getGenreData(g, &length);
+        genreNames[g].assign(name, length);
+    }
+
+    string title;
+    for (int id = 0; id < trackCount; id++) {
+        int length = 0;
+        const char* data = mapped.getTitleData(id, &length);
+        title.assign(data, length);
+        int genreId = mapped.getGenreId(id);
+        int added = catalog.addTrack(title, mapped.getDuration(id),
+                                     genreId >= 0 && genreId < (int)genreNames.size() ? genreNames[genreId] : string());
+        catalog.setPlayCount(added, mapped.getPlayCount(id));
+    }
+    return true;
+}
+
+// CatalogTrackView
+
+CatalogTrackView::CatalogTrackView(const MappedCatalog* owner, int trackId)
+    : catalog(owner), id(trackId) {
+}
+
+int CatalogTrackView::getId() const {
+    return id;
+}
+
+string CatalogTrackView::getTitle() const {
+    int length = 0;
+    const char* data = catalog->getTitleData(id, &length);
+    return length > 0 ? string(data, length) : "";
+}
+
+int CatalogTrackView::getDuration() const {
+    return catalog->getDuration(id);
+}
+
+string CatalogTrackView::getGenre() const {
+    int length = 0;
+    const char* data = catalog->getGenreData(catalog->getGenreId(id), &length);
+    return length > 0 ? string(data, length) : "";
+}
+
+int CatalogTrackView::getPlayCount() const {
+    return catalog->getPlayCount(id);
+}
+
+string CatalogTrackView::getFormattedDuration() const {
+    char buffer[DURATION_TEXT_SIZE];
+    int length = formatDuration(getDuration(), buffer, DURATION_TEXT_SIZE);
+    return string(buffer, length);
+}
+
+int CatalogTrackView::getFormattedDuration(char* buffer, int bufferSize) const {
+    return formatDuration(getDuration(), buffer, bufferSize);
+}
+
+bool CatalogTrackView::isPopular() const {
+    return catalog->isPopular(id);
+}
+
+const char* CatalogTrackView::getTitleData(int* length) const {
+    return catalog->getTitleData(id, length);
+}
+
+#if __cplusplus >= 201703L
+std::string_view CatalogTrackView::getTitleView() const {
+    int length = 0;
+    const char* data = catalog->getTitleData(id, &length);
+    return std::string_view(data, length);
+}
+
+std::string_view CatalogTrackView::getGenreView() const {
+    int length = 0;
+    const char* data = catalog->getGenreData(catalog->getGenreId(id), &length);
+    return std::string_view(data, length);
+}
+#endif
+
+// MappedCatalog
+
+/**
+ * Check that size bytes at offset lie inside the file, written so that
+ * a huge offset cannot wrap the sum around and pass
+ */
+static bool fitsInFile(uint64_t offset, uint64_t size, uint64_t fileSize) {
+    return offset <= fileSize && size <= fileSize - offset;
+}
+
+MappedCatalog::MappedCatalog()
+    : mapping(NULL), mappingSize(0), header(NULL), durations(NULL), playCounts(NULL),
+      genreIds(NULL), titleOffsets(NULL), genreOffsets(NULL), stringHeap(NULL) {
+}
+
+MappedCatalog::~MappedCatalog() {
+    close();
+}
+
+/**
+ * Open
+ * Map the whole file read-only, then check that the header describes
+ * sections that really fit inside it. Only the header and the last
+ * entry of each offset table are read here.
+ */
+bool MappedCatalog::open(const string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(CatalogFileHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* memory = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    mapping = memory;
+    mappingSize = info.st_size;
+    const CatalogFileHeader* h = (const CatalogFileHeader*)memory;
+
+    uint64_t columnSize = (uint64_t)h->trackCount * sizeof(int32_t);
+    bool valid = memcmp(h->magic, CATALOG_MAGIC, sizeof(CATALOG_MAGIC)) == 0
+              && h->version == CATALOG_FILE_VERSION
+              && h->headerSize == sizeof(CatalogFileHeader)
+              && h->fileSize == (uint64_t)info.st_size
+              && h->trackCount <= (uint32_t)INT_MAX
+              && h->genreCount <= (uint32_t)INT_MAX
+              && h->durationsOffset % 8 == 0
+              && h->playCountsOffset % 8 == 0
+              && h->genreIdsOffset % 8 == 0
+              && h->titleOffsetsOffset % 8 == 0
+              && h->genreOffsetsOffset % 8 == 0
+              && h->durationsOffset >= sizeof(CatalogFileHeader)
+              && fitsInFile(h->durationsOffset, columnSize, h->fileSize)
+              && fitsInFile(h->playCountsOffset, columnSize, h->fileSize)
+              && fitsInFile(h->genreIdsOffset, columnSize, h->fileSize)
+              && fitsInFile(h->titleOffsetsOffset, (h->trackCount + 1ULL) * sizeof(uint64_t), h->fileSize)
+              && fitsInFile(h->genreOffsetsOffset, (h->genreCount + 1ULL) * sizeof(uint64_t), h->fileSize)
+              && fitsInFile(h->stringHeapOffset, h->stringHeapSize, h->fileSize);
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    const char* base = (const char*)memory;
+    header = h;
+    durations = (const int32_t*)(base + h->durationsOffset);
+    playCounts = (const int32_t*)(base + h->playCountsOffset);
+    genreIds = (const int32_t*)(base + h->genreIdsOffset);
+    titleOffsets = (const uint64_t*)(base + h->titleOffsetsOffset);
+    genreOffsets = (const uint64_t*)(base + h->genreOffsetsOffset);
+    stringHeap = base + h->stringHeapOffset;
+
+    if (titleOffsets[h->trackCount] > h->stringHeapSize || genreOffsets[h->genreCount] > h->stringHeapSize) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedCatalog::close() {
+    if (mapping != NULL) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = NULL;
+    mappingSize = 0;
+    header = NULL;
+    durations = NULL;
+    playCounts = NULL;
+    genreIds = NULL;
+    titleOffsets = NULL;
+    genreOffsets = NULL;
+    stringHeap = NULL;
+}
+
+bool MappedCatalog::isOpen() const {
+    return header != NULL;
+}
+
+int MappedCatalog::size() const {
+    return header != NULL ? (int)header->trackCount : 0;
+}
+
+bool MappedCatalog::isValidId(int id) const {
+    return id >= 0 && id < size();
+}
+
+CatalogTrackView MappedCatalog::getTrack(int id) const {
+    return CatalogTrackView(this, id);
+}
+
+int MappedCatalog::getDuration(int id) const {
+    return isValidId(id) ? durations[id] : 0;
+}
+
+int MappedCatalog::getPlayCount(int id) const {
+    return isValidId(id) ? playCounts[id] : 0;
+}
+
+int MappedCatalog::getGenreId(int id) const {
+    return isValidId(id) ? genreIds[id] : -1;
+}
+
+bool MappedCatalog::isPopular(int id) const {
+    return getPlayCount(id) > 1000000;
+}
+
+const char* MappedCatalog::getTitleData(int id, int* length) const {
+    if (!isValidId(id)) {
+        *length = 0;
+        return NULL;
+    }
+    return heapSlice(titleOffsets, id, length);
+}
+
+const char* MappedCatalog::getGenreData(int genreId, int* length) const {
+    if (genreId < 0 || genreId >= genreCount()) {
+        *length = 0;
+        return NULL;
+    }
+    return heapSlice(genreOffsets, genreId, length);
+}
+
+int MappedCatalog::genreCount() const {
+    return header != NULL ? (int)header->genreCount : 0;
+}
+
+const int32_t* MappedCatalog::durationData() const {
+    return durations;
+}
+
+const int32_t* MappedCatalog::playCountData() const {
+    return playCounts;
+}
+
+const int32_t* MappedCatalog::genreIdData() const {
+    return genreIds;
+}
+
+/**
+ * Heap Slice
+ * Bounds-check one offset pair at access time, so a damaged file can
+ * never make a view read outside the mapping
+ */
+const char* MappedCatalog::heapSlice(const uint64_t* offsets, int index, int* length) const {
+    uint64_t start = offsets[index];
+    uint64_t end = offsets[index + 1];
+    if (start > end || end > header->stringHeapSize || end - start > (uint64_t)INT_MAX) {
+        *length = 0;
+        return NULL;
+    }
+    *length = (int)(end - start);
+    return stringHeap + start;
+}
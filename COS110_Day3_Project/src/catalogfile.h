@@ -0,0 +1,175 @@
+#ifndef CATALOGFILE_H
+#define CATALOGFILE_H
+
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+#include "trackcatalog.h"
+using namespace std;
+
+/**
+ * Binary Catalog File - Maître Gims Studio Management System
+ *
+ * On-disk layout (version 1, native byte order, every section starts
+ * on an 8-byte boundary):
+ *
+ *   CatalogFileHeader
+ *   int32  durations[trackCount]
+ *   int32  playCounts[trackCount]
+ *   int32  genreIds[trackCount]
+ *   uint64 titleOffsets[trackCount + 1]   title i = heap[off[i] .. off[i+1])
+ *   uint64 genreOffsets[genreCount + 1]   genre g = heap[off[g] .. off[g+1])
+ *   char   stringHeap[stringHeapSize]     all titles, then all genre names
+ *
+ * Because the columns are stored exactly as they are used in memory,
+ * MappedCatalog can mmap() the file and read tracks straight from the
+ * page cache: opening a multi-million track catalog only reads the
+ * header, and each query touches just the pages it needs.
+ */
+
+const uint32_t CATALOG_FILE_VERSION = 1;
+
+struct CatalogFileHeader {
+    char magic[8];                 // "GIMSCAT" + '\0'
+    uint32_t version;              // CATALOG_FILE_VERSION
+    uint32_t headerSize;           // sizeof(CatalogFileHeader)
+    uint32_t trackCount;
+    uint32_t genreCount;
+    uint64_t durationsOffset;
+    uint64_t playCountsOffset;
+    uint64_t genreIdsOffset;
+    uint64_t titleOffsetsOffset;
+    uint64_t genreOffsetsOffset;
+    uint64_t stringHeapOffset;
+    uint64_t stringHeapSize;
+    uint64_t fileSize;
+};
+
+/**
+ * Write a catalog to a binary catalog file.
+ * The file is written under a temporary name and renamed into place,
+ * so readers never see a half-written catalog.
+ * @param catalog Catalog to save (concurrent plays should be collected first)
+ * @param path Destination file
+ * @return true on success
+ */
+bool writeCatalogFile(const TrackCatalog& catalog, const string& path);
+
+/**
+ * Load a binary catalog file into a TrackCatalog, e.g. to change it.
+ * Tracks are appended with their file ids when the catalog is empty.
+ * @param path File written by writeCatalogFile()
+ * @param catalog Catalog to add the tracks to
+ * @return true if the file is a valid catalog
+ */
+bool loadCatalogFile(const string& path, TrackCatalog& catalog);
+
+class MappedCatalog;
+
+/**
+ * CatalogTrackView - read-only view of one track in a MappedCatalog
+ *
+ * Offers the same read functions as MusicTrack, answered straight from
+ * the mapped file. A view is only valid while its MappedCatalog is open.
+ */
+class CatalogTrackView {
+public:
+    CatalogTrackView(const MappedCatalog* owner, int trackId);
+
+    int getId() const;
+    string getTitle() const;
+    int getDuration() const;
+    string getGenre() const;
+    int getPlayCount() const;
+    string getFormattedDuration() const;
+    int getFormattedDuration(char* buffer, int bufferSize) const;
+    bool isPopular() const;
+
+    /**
+     * Get the title bytes inside the mapping (not '\0' terminated)
+     * @param length Receives the title length in bytes
+     * @return Pointer to the first byte, or NULL
+     */
+    const char* getTitleData(int* length) const;
+
+#if __cplusplus >= 201703L
+    std::string_view getTitleView() const;
+    std::string_view getGenreView() const;
+#endif
+
+private:
+    const MappedCatalog* catalog;
+    int id;
+};
+
+/**
+ * MappedCatalog Class - Maître Gims Studio Management System
+ *
+ * Read-only catalog backed by a memory-mapped catalog file. Nothing is
+ * parsed or copied on open(); all accessors read the mapping directly.
+ * Invalid ids return empty values ("" or 0), like TrackCatalog.
+ */
+class MappedCatalog {
+public:
+    MappedCatalog();
+    ~MappedCatalog();
+
+    /**
+     * Map a catalog file and check its header
+     * @param path File written by writeCatalogFile()
+     * @return true if the file is a valid catalog of a supported version
+     */
+    bool open(const string& path);
+
+    /**
+     * Unmap the file; all views become invalid
+     */
+    void close();
+
+    bool isOpen() const;
+    int size() const;
+    bool isValidId(int id) const;
+
+    /**
+     * Get a MusicTrack-style view of one track
+     * @param id Track id
+     * @return View of the track
+     */
+    CatalogTrackView getTrack(int id) const;
+
+    // Same accessors as TrackCatalog
+    int getDuration(int id) const;
+    int getPlayCount(int id) const;
+    int getGenreId(int id) const;
+    bool isPopular(int id) const;
+    const char* getTitleData(int id, int* length) const;
+    const char* getGenreData(int genreId, int* length) const;
+    int genreCount() const;
+
+    // Raw column access for scans - each array has size() entries
+    const int32_t* durationData() const;
+    const int32_t* playCountData() const;
+    const int32_t* genreIdData() const;
+
+private:
+    void* mapping;
+    size_t mappingSize;
+    const CatalogFileHeader* header;
+    const int32_t* durations;
+    const int32_t* playCounts;
+    const int32_t* genreIds;
+    const uint64_t* titleOffsets;
+    const uint64_t* genreOffsets;
+    const char* stringHeap;
+
+    const char* heapSlice(const uint64_t* offsets, int index, int* length) const;
+
+    // A mapping can only have one owner - disable copying
+    MappedCatalog(const MappedCatalog&);
+    MappedCatalog& operator=(const MappedCatalog&);
+};
+
+#endif
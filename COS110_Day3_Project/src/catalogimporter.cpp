@@ -0,0 +1,524 @@
+#include "catalogimporter.h"
+#include <string>
+#include <vector>
+#include <cstring>
+#include <climits>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+using namespace std;
+
+const int CatalogImporter::MAX_REPORTED_ERRORS;
+const size_t CatalogImporter::DEFAULT_CHUNK_SIZE;
+
+/**
+ * FieldText - where the text of one parsed field lives
+ * Unquoted fields point into the chunk; quoted fields with "" escapes
+ * are unescaped into the chunk's side buffer
+ */
+struct FieldText {
+    bool unescaped;   // true: offset is into ImportChunk::text
+    size_t offset;
+    int length;
+};
+
+struct ParsedRow {
+    FieldText title;
+    FieldText genre;
+    int duration;
+    int plays;
+};
+
+struct RowError {
+    long long line;       // line number inside the chunk (1-based)
+    const char* reason;
+};
+
+/**
+ * ImportChunk - a run of whole lines and everything parsed out of it
+ * Filled in by one parser thread, read by the appending thread
+ */
+struct ImportChunk {
+    const char* data;
+    size_t size;
+    char delimiter;
+
+    long long lineCount;
+    long long rejected;
+    vector<ParsedRow> rows;
+    vector<char> text;
+    vector<RowError> errors;
+};
+
+/**
+ * Trim spaces, tabs and '\r' from both ends of [begin, end)
+ */
+static void trimField(const char*& begin, const char*& end) {
+    while (begin < end && (*begin == ' ' || *begin == '\t' || *begin == '\r')) {
+        begin++;
+    }
+    while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) {
+        end--;
+    }
+}
+
+/**
+ * Parse a whole number (optional sign, digits only)
+ * @return false if the text isn't a number or doesn't fit in an int
+ */
+static bool parseWholeNumber(const char* begin, const char* end, int* value) {
+    bool negative = false;
+    if (begin < end && (*begin == '-' || *begin == '+')) {
+        negative = (*begin == '-');
+        begin++;
+    }
+    if (begin == end) {
+        return false;
+    }
+
+    long long result = 0;
+    for (const char* p = begin; p < end; p++) {
+        if (*p < '0' || *p > '9') {
+            return false;
+        }
+        result = result * 10 + (*p - '0');
+        if (result > (long long)INT_MAX + 1) {
+            return false;
+        }
+    }
+
+    if (negative) {
+        result = -result;
+    }
+    if (result > INT_MAX || result < INT_MIN) {
+        return false;
+    }
+    *value = (int)result;
+    return true;
+}
+
+/**
+ * Read one field starting at p and move p past its delimiter
+ * @return NULL on success, otherwise the reason the field is broken
+ */
+static const char* readField(ImportChunk& chunk, const char*& p, const char* lineEnd,
+                             const char** fieldBegin, const char** fieldEnd, FieldText* text) {
+    const char delimiter = chunk.delimiter;
+
+    // Unquoted field: everything up to the next delimiter
+    const char* start = p;
+    while (start < lineEnd && (*start == ' ' || (*start == '\t' && delimiter != '\t'))) {
+        start++;
+    }
+    if (start == lineEnd || *start != '"') {
+        const char* stop = (const char*)memchr(p, delimiter, lineEnd - p);
+        if (stop == NULL) {
+            stop = lineEnd;
+        }
+        const char* b = p;
+        const char* e = stop;
+        trimField(b, e);
+
+        *fieldBegin = b;
+        *fieldEnd = e;
+        text->unescaped = false;
+        text->offset = b - chunk.data;
+        text->length = (int)(e - b);
+        p = stop + 1;
+        return NULL;
+    }
+
+    // Quoted field: copy into the side buffer only if it has "" escapes
+    const char* q = start + 1;
+    const char* close = NULL;
+    bool escaped = false;
+    while (q < lineEnd) {
+        if (*q == '"') {
+            if (q + 1 < lineEnd && q[1] == '"') {
+                escaped = true;
+                q += 2;
+                continue;
+            }
+            close = q;
+            break;
+        }
+        q++;
+    }
+    if (close == NULL) {
+        return "unterminated quote";
+    }
+
+    const char* after = close + 1;
+    while (after < lineEnd && (*after == ' ' || *after == '\r' || (*after == '\t' && delimiter != '\t'))) {
+        after++;
+    }
+    if (after < lineEnd && *after != delimiter) {
+        return "unexpected text after a closing quote";
+    }
+
+    *fieldBegin = start + 1;
+    *fieldEnd = close;
+    if (!escaped) {
+        text->unescaped = false;
+        text->offset = (start + 1) - chunk.data;
+        text->length = (int)(close - (start + 1));
+    } else {
+        text->unescaped = true;
+        text->offset = chunk.text.size();
+        for (const char* c = start + 1; c < close; c++) {
+            chunk.text.push_back(*c);
+            if (*c == '"') {
+                c++;   // skip the second quote of ""
+            }
+        }
+        text->length = (int)(chunk.text.size() - text->offset);
+    }
+    p = after + 1;
+    return NULL;
+}
+
+/**
+ * Parse Line
+ * Split one line into fields and validate them
+ * @return NULL if the row was parsed, otherwise the rejection reason
+ */
+static const char* parseLine(ImportChunk& chunk, const char* begin, const char* end,
+                             ParsedRow* row) {
+    const char* fieldBegin[5];
+    const char* fieldEnd[5];
+    FieldText text[5];
+    int fieldCount = 0;
+
+    const char* p = begin;
+    while (true) {
+        if (fieldCount == 5) {
+            return "too many fields (expected title, duration, genre[, plays])";
+        }
+        const char* reason = readField(chunk, p, end, &fieldBegin[fieldCount],
+                                       &fieldEnd[fieldCount], &text[fieldCount]);
+        if (reason != NULL) {
+            return reason;
+        }
+        fieldCount++;
+        if (p > end) {
+            break;
+        }
+    }
+
+    if (fieldCount < 3) {
+        return "too few fields (expected title, duration, genre[, plays])";
+    }
+    if (fieldCount > 4) {
+        return "too many fields (expected title, duration, genre[, plays])";
+    }
+    if (!parseWholeNumber(fieldBegin[1], fieldEnd[1], &row->duration)) {
+        return "duration is not a whole number of seconds";
+    }
+
+    row->plays = 0;
+    if (fieldCount == 4 && fieldBegin[3] != fieldEnd[3] &&
+        !parseWholeNumber(fieldBegin[3], fieldEnd[3], &row->plays)) {
+        return "play count is not a whole number";
+    }
+
+    row->title = text[0];
+    row->genre = text[2];
+    return NULL;
+}
+
+/**
+ * Parse Chunk (thread entry point)
+ * Walk the chunk line by line, keeping good rows and rejected lines
+ */
+static void* parseChunk(void* arg) {
+    ImportChunk& chunk = *(ImportChunk*)arg;
+    chunk.lineCount = 0;
+    chunk.rejected = 0;
+    chunk.rows.clear();
+    chunk.text.clear();
+    chunk.errors.clear();
+
+    const char* p = chunk.data;
+    const char* end = chunk.data + chunk.size;
+    while (p < end) {
+        const char* newline = (const char*)memchr(p, '\n', end - p);
+        const char* lineEnd = (newline != NULL) ? newline : end;
+        chunk.lineCount++;
+
+        const char* b = p;
+        const char* e = lineEnd;
+        trimField(b, e);
+        if (b != e) {
+            ParsedRow row;
+            const char* reason = parseLine(chunk, p, lineEnd, &row);
+            if (reason == NULL) {
+                chunk.rows.push_back(row);
+            } else {
+                chunk.rejected++;
+                if (chunk.errors.size() < (size_t)CatalogImporter::MAX_REPORTED_ERRORS) {
+                    RowError error = { chunk.lineCount, reason };
+                    chunk.errors.push_back(error);
+                }
+            }
+        }
+        p = lineEnd + 1;
+    }
+    return NULL;
+}
+
+/**
+ * Find the end of the last complete line in [data, data + size)
+ * @return Number of bytes up to and including the last '\n', or 0
+ */
+static size_t wholeLinesLength(const char* data, size_t size) {
+    for (size_t i = size; i > 0; i--) {
+        if (data[i - 1] == '\n') {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Constructor
+ * Use one parser thread per online CPU
+ */
+CatalogImporter::CatalogImporter(TrackCatalog& target)
+    : catalog(target), delimiter(','), threadCount(1), chunkSize(DEFAULT_CHUNK_SIZE),
+      skipHeader(false) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    setThreadCount(cpus > 0 ? (int)cpus : 1);
+    startReport();
+}
+
+void CatalogImporter::setDelimiter(char d) {
+    if (d != '"' && d != '\n' && d != '\r' && d != '\0') {
+        delimiter = d;
+    }
+}
+
+void CatalogImporter::setThreadCount(int count) {
+    if (count < 1) {
+        count = 1;
+    } else if (count > 64) {
+        count = 64;
+    }
+    threadCount = count;
+}
+
+void CatalogImporter::setChunkSize(size_t bytes) {
+    chunkSize = (bytes < 1) ? 1 : bytes;
+}
+
+void CatalogImporter::setSkipHeader(bool skip) {
+    skipHeader = skip;
+}
+
+char CatalogImporter::getDelimiter() const {
+    return delimiter;
+}
+
+int CatalogImporter::getThreadCount() const {
+    return threadCount;
+}
+
+const ImportReport& CatalogImporter::getReport() const {
+    return report;
+}
+
+/**
+ * Import File
+ * Read chunkSize bytes per thread, cut each read at its last newline
+ * and carry the partial line over into the next chunk
+ */
+bool CatalogImporter::importFile(const string& path) {
+    startReport();
+
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    vector<ImportChunk> chunks(threadCount);
+    vector< vector<char> > buffers(threadCount);
+    vector<char> carry;
+    bool headerPending = skipHeader;
+    bool atEnd = false;
+    bool ok = true;
+
+    while (!atEnd) {
+        int count = 0;
+        while (count < threadCount && !atEnd) {
+            vector<char>& buffer = buffers[count];
+            buffer.swap(carry);
+            carry.clear();
+
+            // Keep reading until the buffer holds at least one whole line
+            size_t lineBytes = 0;
+            while (lineBytes == 0 && !atEnd) {
+                size_t used = buffer.size();
+                buffer.resize(used + chunkSize);
+                ssize_t got = read(fd, &buffer[used], chunkSize);
+                while (got < 0 && errno == EINTR) {
+                    got = read(fd, &buffer[used], chunkSize);
+                }
+                if (got < 0) {
+                    ok = false;
+                    got = 0;
+                }
+                buffer.resize(used + got);
+                report.bytesRead += got;
+                if (got == 0) {
+                    atEnd = true;
+                    lineBytes = buffer.size();
+                } else {
+                    lineBytes = wholeLinesLength(&buffer[0] + used, got);
+                    if (lineBytes > 0) {
+                        lineBytes += used;
+                    }
+                }
+            }
+            carry.assign(buffer.begin() + lineBytes, buffer.end());
+            buffer.resize(lineBytes);
+
+            const char* data = buffer.empty() ? "" : &buffer[0];
+            size_t size = buffer.size();
+            if (headerPending && size > 0) {
+                size_t skipped = headerLength(data, size);
+                data += skipped;
+                size -= skipped;
+                report.linesRead++;
+                headerPending = false;
+            }
+
+            if (size > 0) {
+                chunks[count].data = data;
+                chunks[count].size = size;
+                chunks[count].delimiter = delimiter;
+                count++;
+            }
+        }
+        parseBatch(chunks, count);
+    }
+
+    close(fd);
+    return ok;
+}
+
+/**
+ * Import Buffer
+ * Same as importFile(), cutting the caller's bytes into chunks in place
+ */
+void CatalogImporter::importBuffer(const char* data, size_t size) {
+    startReport();
+    if (data == NULL || size == 0) {
+        return;
+    }
+    report.bytesRead = size;
+
+    if (skipHeader) {
+        size_t skipped = headerLength(data, size);
+        data += skipped;
+        size -= skipped;
+        report.linesRead++;
+    }
+
+    vector<ImportChunk> chunks(threadCount);
+    while (size > 0) {
+        int count = 0;
+        while (count < threadCount && size > 0) {
+            size_t length = size;
+            if (length > chunkSize) {
+                // Cut after the first newline at or past chunkSize bytes
+                const char* newline = (const char*)memchr(data + chunkSize - 1, '\n', size - chunkSize + 1);
+                length = (newline != NULL) ? (size_t)(newline - data) + 1 : size;
+            }
+            chunks[count].data = data;
+            chunks[count].size = length;
+            chunks[count].delimiter = delimiter;
+            count++;
+            data += length;
+            size -= length;
+        }
+        parseBatch(chunks, count);
+    }
+}
+
+// Private helpers
+
+void CatalogImporter::startReport() {
+    report.bytesRead = 0;
+    report.linesRead = 0;
+    report.tracksImported = 0;
+    report.rowsRejected = 0;
+    report.errors.clear();
+}
+
+/**
+ * Header Length
+ * Number of bytes in the first line, including its '\n'
+ */
+size_t CatalogImporter::headerLength(const char* data, size_t size) const {
+    const char* newline = (const char*)memchr(data, '\n', size);
+    return (newline != NULL) ? (size_t)(newline - data) + 1 : size;
+}
+
+/**
+ * Parse Batch
+ * Parse chunks 1..count-1 on their own threads and chunk 0 on the
+ * calling thread, then add every chunk's rows in order
+ */
+void CatalogImporter::parseBatch(vector<ImportChunk>& chunks, int count) {
+    vector<pthread_t> threads(count);
+    vector<bool> started(count, false);
+
+    for (int i = 1; i < count; i++) {
+        started[i] = pthread_create(&threads[i], NULL, parseChunk, &chunks[i]) == 0;
+    }
+    if (count > 0) {
+        parseChunk(&chunks[0]);
+    }
+    for (int i = 1; i < count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            parseChunk(&chunks[i]);
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        appendChunk(chunks[i]);
+    }
+}
+
+/**
+ * Append Chunk
+ * Add the chunk's rows through addTrack()/setPlayCount() so they get
+ * exactly the catalog's validation, and number its rejected lines
+ */
+void CatalogImporter::appendChunk(const ImportChunk& chunk) {
+    for (size_t i = 0; i < chunk.rows.size(); i++) {
+        const ParsedRow& row = chunk.rows[i];
+        const char* title = (row.title.unescaped ? &chunk.text[0] : chunk.data) + row.title.offset;
+        const char* genre = (row.genre.unescaped ? &chunk.text[0] : chunk.data) + row.genre.offset;
+
+        titleBuffer.assign(title, row.title.length);
+        genreBuffer.assign(genre, row.genre.length);
+        int id = catalog.addTrack(titleBuffer, row.duration, genreBuffer);
+        if (row.plays != 0) {
+            catalog.setPlayCount(id, row.plays);
+        }
+    }
+
+    for (size_t i = 0; i < chunk.errors.size() && report.errors.size() < (size_t)MAX_REPORTED_ERRORS; i++) {
+        ImportError error;
+        error.line = report.linesRead + chunk.errors[i].line;
+        error.reason = chunk.errors[i].reason;
+        report.errors.push_back(error);
+    }
+
+    report.tracksImported += chunk.rows.size();
+    report.rowsRejected += chunk.rejected;
+    report.linesRead += chunk.lineCount;
+}
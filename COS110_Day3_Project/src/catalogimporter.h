@@ -0,0 +1,138 @@
+#ifndef CATALOGIMPORTER_H
+#define CATALOGIMPORTER_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "trackcatalog.h"
+using namespace std;
+
+/**
+ * ImportError - one rejected row of an import
+ */
+struct ImportError {
+    long long line;   // 1-based line number in the input
+    string reason;    // why the row was rejected
+};
+
+/**
+ * ImportReport - what happened during the last import
+ */
+struct ImportReport {
+    long long bytesRead;
+    long long linesRead;        // including blank lines and the header
+    long long tracksImported;
+    long long rowsRejected;
+    vector<ImportError> errors; // the first MAX_REPORTED_ERRORS rejections
+};
+
+struct ImportChunk;
+
+/**
+ * CatalogImporter Class - Maître Gims Studio Management System
+ *
+ * Streams delimited catalog exports (CSV or TSV) into a TrackCatalog.
+ * Each row is:
+ *
+ *   title, duration, genre[, plays]
+ *
+ * The input is read in large chunks that are cut at the last newline,
+ * and a batch of chunks is parsed on several threads at once. The
+ * parsed rows are then added to the catalog in file order, so track
+ * ids follow the line order no matter how many threads are used.
+ *
+ * Rows go through the same validation as MusicTrack:
+ * - empty title  -> "Untitled Track"
+ * - duration <= 0 -> 180 seconds
+ * - empty genre  -> "Unknown"
+ * - negative plays -> 0
+ *
+ * Rows that can't be read at all (wrong number of fields, a duration
+ * or play count that isn't a whole number, a broken quote) are skipped
+ * and reported with their line number. Blank lines are ignored.
+ *
+ * Fields may be wrapped in double quotes to hold the delimiter, with
+ * "" standing for one quote. Quoted fields can't span lines.
+ */
+class CatalogImporter {
+public:
+    static const int MAX_REPORTED_ERRORS = 100;
+    static const size_t DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+    /**
+     * Constructor
+     * Defaults: comma delimiter, no header, one thread per CPU
+     * @param target Catalog that imported tracks are added to
+     */
+    CatalogImporter(TrackCatalog& target);
+
+    /**
+     * Set the field delimiter (',' for CSV, '\t' for TSV)
+     * @param d Delimiter character (quotes and newlines are ignored)
+     */
+    void setDelimiter(char d);
+
+    /**
+     * Set the number of parser threads (1 parses on the calling thread)
+     * @param count Thread count, clamped to 1..64
+     */
+    void setThreadCount(int count);
+
+    /**
+     * Set how many bytes each parser thread gets at a time
+     * @param bytes Chunk size (at least 1)
+     */
+    void setChunkSize(size_t bytes);
+
+    /**
+     * Skip the first line of the input (a column header)
+     * @param skip true to skip it
+     */
+    void setSkipHeader(bool skip);
+
+    char getDelimiter() const;
+    int getThreadCount() const;
+
+    /**
+     * Import a file
+     * @param path File to read
+     * @return false if the file could not be opened or read
+     */
+    bool importFile(const string& path);
+
+    /**
+     * Import rows that are already in memory
+     * @param data Input bytes
+     * @param size Number of bytes
+     */
+    void importBuffer(const char* data, size_t size);
+
+    /**
+     * Get the report of the last import
+     * @return Counters and rejected rows
+     */
+    const ImportReport& getReport() const;
+
+private:
+    TrackCatalog& catalog;
+    char delimiter;
+    int threadCount;
+    size_t chunkSize;
+    bool skipHeader;
+    ImportReport report;
+
+    // Reused between rows so adding a track doesn't allocate
+    string titleBuffer;
+    string genreBuffer;
+
+    void startReport();
+    size_t headerLength(const char* data, size_t size) const;
+    void parseBatch(vector<ImportChunk>& chunks, int count);
+    void appendChunk(const ImportChunk& chunk);
+
+    // The importer holds a reference to its catalog - disable copying
+    CatalogImporter(const CatalogImporter&);
+    CatalogImporter& operator=(const CatalogImporter&);
+};
+
+#endif
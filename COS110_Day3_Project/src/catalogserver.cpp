@@ -0,0 +1,634 @@
+#include "catalogserver.h"
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+using namespace std;
+
+static const int MAX_EVENTS = 64;
+static const int READ_CHUNK = 64 * 1024;
+
+// Request parsing - words are read in place, nothing is copied
+
+/**
+ * Read the next space-separated word
+ * @return false if only spaces are left
+ */
+static bool nextWord(const char*& cursor, const char* end, const char*& word, int& length) {
+    while (cursor < end && *cursor == ' ') {
+        cursor++;
+    }
+    word = cursor;
+    while (cursor < end && *cursor != ' ') {
+        cursor++;
+    }
+    length = (int)(cursor - word);
+    return length > 0;
+}
+
+static bool wordIs(const char* word, int length, const char* literal) {
+    return (int)strlen(literal) == length && memcmp(word, literal, length) == 0;
+}
+
+/**
+ * Parse a non-negative decimal int
+ * @return false for anything else, including values above INT_MAX
+ */
+static bool parseNumber(const char* word, int length, int& value) {
+    if (length <= 0 || length > 10) {
+        return false;
+    }
+    long long result = 0;
+    for (int i = 0; i < length; i++) {
+        if (word[i] < '0' || word[i] > '9') {
+            return false;
+        }
+        result = result * 10 + (word[i] - '0');
+    }
+    if (result > 0x7fffffffLL) {
+        return false;
+    }
+    value = (int)result;
+    return true;
+}
+
+/**
+ * Append a text field; line breaks and tabs would split the response,
+ * so they are sent as spaces
+ */
+static void appendText(string& out, const char* text, int length) {
+    for (int i = 0; i < length; i++) {
+        char c = text[i];
+        out += (c == '\n' || c == '\r' || c == '\t') ? ' ' : c;
+    }
+}
+
+static void appendNumber(string& out, long long value) {
+    char digits[24];
+    int count = 0;
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        out += '-';
+    }
+    while (count > 0) {
+        out += digits[--count];
+    }
+}
+
+// Construction and destruction
+
+CatalogServer::CatalogServer(TrackCatalog& catalog)
+    : catalog(catalog), tcpFd(-1), unixFd(-1), port(0), stopping(false), requests(0) {
+    if (!catalog.hasPopularityIndex()) {
+        catalog.enablePopularityIndex();
+    }
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    addListener(wakeFd);
+}
+
+CatalogServer::~CatalogServer() {
+    while (!connections.empty()) {
+        closeConnection(connections.begin()->second);
+    }
+    if (tcpFd >= 0) {
+        close(tcpFd);
+    }
+    if (unixFd >= 0) {
+        close(unixFd);
+        unlink(unixPath.c_str());
+    }
+    if (wakeFd >= 0) {
+        close(wakeFd);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+}
+
+// Listening
+
+bool CatalogServer::addListener(int fd) {
+    if (epollFd < 0 || fd < 0) {
+        return false;
+    }
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    return epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+bool CatalogServer::listenTcp(int port) {
+    if (tcpFd >= 0 || port < 0 || port > 65535) {
+        return false;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0 ||
+        getsockname(fd, (sockaddr*)&address, &length) != 0 || !addListener(fd)) {
+        close(fd);
+        return false;
+    }
+    tcpFd = fd;
+    this->port = ntohs(address.sin_port);
+    return true;
+}
+
+bool CatalogServer::listenUnix(const string& path) {
+    sockaddr_un address;
+    if (unixFd >= 0 || path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    memcpy(address.sun_path, path.c_str(), path.size());
+    unlink(path.c_str());
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0 || !addListener(fd)) {
+        close(fd);
+        return false;
+    }
+    unixFd = fd;
+    unixPath = path;
+    return true;
+}
+
+int CatalogServer::getPort() const {
+    return port;
+}
+
+// Event loop
+
+void CatalogServer::run() {
+    while (!stopping) {
+        if (poll(-1) < 0) {
+            break;
+        }
+    }
+    stopping = false;
+}
+
+/**
+ * Poll
+ * Events carry the socket's fd; connections are looked up by it
+ */
+int CatalogServer::poll(int timeoutMs) {
+    epoll_event events[MAX_EVENTS];
+    int count = epoll_wait(epollFd, events, MAX_EVENTS, timeoutMs);
+    if (count < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int fd = events[i].data.fd;
+        if (fd == wakeFd) {
+            uint64_t wakeups;
+            ssize_t ignored = read(wakeFd, &wakeups, sizeof(wakeups));
+            (void)ignored;
+            stopping = true;
+            continue;
+        }
+        if (fd == tcpFd || fd == unixFd) {
+            acceptAll(fd);
+            continue;
+        }
+
+        // A connection closed earlier in this round is no longer in the map
+        map<int, Connection*>::iterator it = connections.find(fd);
+        if (it == connections.end()) {
+            continue;
+        }
+        Connection* connection = it->second;
+        if (events[i].events & EPOLLERR) {
+            closeConnection(connection);
+        } else if (events[i].events & (EPOLLIN | EPOLLHUP)) {
+            readRequests(connection);
+        } else if (events[i].events & EPOLLOUT) {
+            finishWrite(connection);
+        }
+    }
+    return count;
+}
+
+/**
+ * Stop
+ * Only an eventfd write, which is async-signal-safe; the event loop
+ * sets its own flag when it sees the wakeup, so no state is shared
+ */
+void CatalogServer::stop() {
+    uint64_t one = 1;
+    ssize_t ignored = write(wakeFd, &one, sizeof(one));
+    (void)ignored;
+}
+
+void CatalogServer::acceptAll(int listenFd) {
+    while (true) {
+        int fd = accept4(listenFd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return;   // EAGAIN, or out of descriptors until a client leaves
+        }
+        if (listenFd == tcpFd) {
+            int on = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+
+        Connection* connection = new Connection();
+        connection->fd = fd;
+        connection->inputStart = 0;
+        connection->outputStart = 0;
+        connection->events = EPOLLIN;
+        connection->readPaused = false;
+        connection->closeAfterWrite = false;
+
+        epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = connection->events;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            delete connection;
+            continue;
+        }
+        connections[fd] = connection;
+    }
+}
+
+/**
+ * Read Requests
+ * Reads until the socket would block, answering complete lines as
+ * they arrive, then sends the answers. A short read means the socket
+ * is drained for now, which saves the read() that would return EAGAIN.
+ */
+void CatalogServer::readRequests(Connection* connection) {
+    char buffer[READ_CHUNK];
+    bool peerClosed = false;
+
+    while (!connection->readPaused && !connection->closeAfterWrite) {
+        ssize_t got = recv(connection->fd, buffer, sizeof(buffer), 0);
+        if (got > 0) {
+            connection->input.append(buffer, got);
+            answerRequests(connection);
+            if (got < (ssize_t)sizeof(buffer)) {
+                break;
+            }
+        } else if (got == 0) {
+            peerClosed = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            closeConnection(connection);
+            return;
+        }
+    }
+
+    // A client that closed its side still gets the answers it asked for
+    if (peerClosed) {
+        connection->closeAfterWrite = true;
+    }
+    finishWrite(connection);
+}
+
+/**
+ * Answer Requests
+ * Every complete line in the input gets its answer appended to the
+ * output; an unfinished line waits for the next read
+ */
+void CatalogServer::answerRequests(Connection* connection) {
+    string& input = connection->input;
+    while (connection->inputStart < input.size()) {
+        const char* start = input.data() + connection->inputStart;
+        size_t available = input.size() - connection->inputStart;
+        const char* newline = (const char*)memchr(start, '\n', available);
+        if (newline == NULL) {
+            if (available > (size_t)MAX_REQUEST_BYTES) {
+                connection->output += "ERR request too long\n";
+                connection->closeAfterWrite = true;
+                input.clear();
+                connection->inputStart = 0;
+            }
+            break;
+        }
+        int length = (int)(newline - start);
+        if (length > MAX_REQUEST_BYTES) {
+            connection->output += "ERR request too long\n";
+            connection->closeAfterWrite = true;
+            input.clear();
+            connection->inputStart = 0;
+            break;
+        }
+        handleRequest(start, length, connection->output);
+        connection->inputStart += length + 1;
+    }
+
+    // Drop answered bytes so the buffer only holds the unfinished line
+    if (connection->inputStart == input.size()) {
+        input.clear();
+        connection->inputStart = 0;
+    } else if (connection->inputStart > input.size() / 2) {
+        input.erase(0, connection->inputStart);
+        connection->inputStart = 0;
+    }
+
+    if (connection->output.size() - connection->outputStart > MAX_PENDING_OUTPUT) {
+        connection->readPaused = true;
+    }
+}
+
+/**
+ * Write Answers
+ * @return false if the connection failed
+ */
+bool CatalogServer::writeAnswers(Connection* connection) {
+    string& output = connection->output;
+    while (connection->outputStart < output.size()) {
+        ssize_t sent = send(connection->fd, output.data() + connection->outputStart,
+                            output.size() - connection->outputStart, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection->outputStart += sent;
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+
+    size_t pending = output.size() - connection->outputStart;
+    if (pending == 0) {
+        output.clear();
+        connection->outputStart = 0;
+    } else if (connection->outputStart > output.size() / 2) {
+        output.erase(0, connection->outputStart);
+        connection->outputStart = 0;
+    }
+    if (connection->readPaused && !connection->closeAfterWrite && pending <= MAX_PENDING_OUTPUT / 2) {
+        connection->readPaused = false;
+    }
+    return true;
+}
+
+/**
+ * Finish Write
+ * Send what can be sent, then either close the connection (failed, or
+ * done after a bad request or the client's close) or wait for the
+ * next event
+ */
+void CatalogServer::finishWrite(Connection* connection) {
+    if (!writeAnswers(connection)) {
+        closeConnection(connection);
+        return;
+    }
+    if (connection->closeAfterWrite) {
+        if (connection->outputStart == connection->output.size()) {
+            closeConnection(connection);
+            return;
+        }
+        connection->readPaused = true;
+    }
+    updateEvents(connection);
+}
+
+/**
+ * Update Events
+ * Wait for EPOLLOUT only while answers are pending, and stop waiting
+ * for EPOLLIN while reading is paused
+ */
+void CatalogServer::updateEvents(Connection* connection) {
+    unsigned int wanted = 0;
+    if (!connection->readPaused) {
+        wanted |= EPOLLIN;
+    }
+    if (connection->outputStart < connection->output.size()) {
+        wanted |= EPOLLOUT;
+    }
+    if (wanted == connection->events) {
+        return;
+    }
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = wanted;
+    event.data.fd = connection->fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->fd, &event) == 0) {
+        connection->events = wanted;
+    }
+}
+
+void CatalogServer::closeConnection(Connection* connection) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, NULL);
+    close(connection->fd);
+    connections.erase(connection->fd);
+    delete connection;
+}
+
+// Requests
+
+void CatalogServer::handleRequest(const char* line, int length, string& response) {
+    requests++;
+    const char* end = line + length;
+    if (length > 0 && line[length - 1] == '\r') {
+        end--;
+    }
+    const char* cursor = line;
+    const char* command;
+    int commandLength;
+    if (!nextWord(cursor, end, command, commandLength)) {
+        response += "ERR empty request\n";
+        return;
+    }
+    if (wordIs(command, commandLength, "ADD")) {
+        addTrack(cursor, end, response);
+        return;
+    }
+
+    // Up to two numeric arguments, and nothing after them
+    const char* word;
+    int wordLength;
+    int arguments[2] = { 0, 0 };
+    int argumentCount = 0;
+    while (nextWord(cursor, end, word, wordLength)) {
+        if (argumentCount == 2) {
+            response += "ERR too many arguments\n";
+            return;
+        }
+        if (!parseNumber(word, wordLength, arguments[argumentCount])) {
+            response += "ERR bad number\n";
+            return;
+        }
+        argumentCount++;
+    }
+
+    if (wordIs(command, commandLength, "PING")) {
+        response += "OK PONG\n";
+        return;
+    }
+    if (wordIs(command, commandLength, "SIZE")) {
+        response += "OK ";
+        appendNumber(response, catalog.size());
+        response += '\n';
+        return;
+    }
+    if (wordIs(command, commandLength, "STATS")) {
+        if (argumentCount != 0) {
+            response += "ERR too many arguments\n";
+            return;
+        }
+        response += "OK ";
+        appendNumber(response, catalog.size());
+        response += ' ';
+        appendNumber(response, catalog.playCountStats().sum);
+        response += ' ';
+        appendNumber(response, catalog.countPopular());
+        response += '\n';
+        return;
+    }
+    if (wordIs(command, commandLength, "TOP")) {
+        if (argumentCount != 1) {
+            response += "ERR usage: TOP <k>\n";
+            return;
+        }
+        int k = arguments[0] < MAX_TOP_TRACKS ? arguments[0] : MAX_TOP_TRACKS;
+        vector<int> top = catalog.topTracks(k);
+        response += "OK ";
+        appendNumber(response, (long long)top.size());
+        for (size_t i = 0; i < top.size(); i++) {
+            response += ' ';
+            appendNumber(response, top[i]);
+            response += ':';
+            appendNumber(response, catalog.getPlayCount(top[i]));
+        }
+        response += '\n';
+        return;
+    }
+
+    // Every other command names a track first
+    bool play = wordIs(command, commandLength, "PLAY");
+    bool set = wordIs(command, commandLength, "SET");
+    bool get = wordIs(command, commandLength, "GET");
+    bool popular = wordIs(command, commandLength, "POPULAR");
+    bool title = wordIs(command, commandLength, "TITLE");
+    bool track = wordIs(command, commandLength, "TRACK");
+    if (!play && !set && !get && !popular && !title && !track) {
+        response += "ERR unknown command\n";
+        return;
+    }
+    int wanted = set ? 2 : 1;
+    if (argumentCount < wanted || argumentCount > (play ? 2 : wanted)) {
+        response += set ? "ERR usage: SET <id> <count>\n" : "ERR wrong number of arguments\n";
+        return;
+    }
+    int id = arguments[0];
+    if (!catalog.isValidId(id)) {
+        response += "ERR bad track id\n";
+        return;
+    }
+
+    if (play) {
+        int count = argumentCount == 2 ? arguments[1] : 1;
+        if (count == 1) {
+            catalog.play(id);
+        } else if (count > 1) {
+            PlayEvent event = { id, count };
+            catalog.applyPlayEvents(&event, 1);
+        }
+    } else if (set) {
+        catalog.setPlayCount(id, arguments[1]);
+    }
+
+    response += "OK ";
+    if (popular) {
+        response += catalog.isPopular(id) ? '1' : '0';
+    } else if (title || track) {
+        if (track) {
+            appendNumber(response, catalog.getDuration(id));
+            response += ' ';
+            appendNumber(response, catalog.getPlayCount(id));
+            response += ' ';
+            const string& genre = catalog.getGenre(id);
+            appendText(response, genre.data(), (int)genre.size());
+            response += '\t';
+        }
+        int titleLength;
+        const char* text = catalog.getTitleData(id, &titleLength);
+        appendText(response, text, titleLength);
+    } else {
+        appendNumber(response, catalog.getPlayCount(id));
+    }
+    response += '\n';
+}
+
+/**
+ * Add Track
+ * ADD <duration> <plays> <genre>\t<title>: the genre runs from after
+ * the play count to the tab, the title from the tab to the end
+ */
+void CatalogServer::addTrack(const char* cursor, const char* end, string& response) {
+    const char* word;
+    int wordLength;
+    int duration;
+    int plays;
+    if (!nextWord(cursor, end, word, wordLength) || !parseNumber(word, wordLength, duration) ||
+        !nextWord(cursor, end, word, wordLength) || !parseNumber(word, wordLength, plays) ||
+        cursor == end) {
+        response += "ERR usage: ADD <duration> <plays> <genre>\\t<title>\n";
+        return;
+    }
+    cursor++;
+    const char* tab = (const char*)memchr(cursor, '\t', end - cursor);
+    if (tab == NULL) {
+        response += "ERR usage: ADD <duration> <plays> <genre>\\t<title>\n";
+        return;
+    }
+
+    int id = catalog.addTrack(string(tab + 1, end - tab - 1), duration, string(cursor, tab - cursor));
+    if (plays > 0) {
+        catalog.setPlayCount(id, plays);
+    }
+    response += "OK ";
+    appendNumber(response, id);
+    response += '\n';
+}
+
+// Statistics
+
+int CatalogServer::connectionCount() const {
+    return (int)connections.size();
+}
+
+long long CatalogServer::requestCount() const {
+    return requests;
+}
@@ -0,0 +1,155 @@
+#ifndef CATALOGSERVER_H
+#define CATALOGSERVER_H
+
+#include <string>
+#include <map>
+#include <cstddef>
+#include "trackcatalog.h"
+using namespace std;
+
+/**
+ * CatalogServer Class - Maître Gims Studio Management System
+ *
+ * Serves one TrackCatalog to many local clients over TCP (127.0.0.1)
+ * and/or a Unix socket, so the catalog can live in one long-running
+ * process instead of being linked into every program.
+ *
+ * Protocol: text, one request per line, one response line per request
+ * in the same order. A client may send many requests before reading
+ * any response (pipelining); they are answered in batches.
+ *
+ *   PING                  -> OK PONG
+ *   SIZE                  -> OK <number of tracks>
+ *   PLAY <id> [count]     -> OK <play count>       (count defaults to 1)
+ *   SET <id> <count>      -> OK <play count>       (setPlayCount)
+ *   GET <id>              -> OK <play count>
+ *   POPULAR <id>          -> OK 1 | OK 0
+ *   TITLE <id>            -> OK <title>
+ *   TOP <k>               -> OK <n> <id>:<plays> ...   (k is capped at 1000)
+ *   TRACK <id>            -> OK <duration> <plays> <genre>\t<title>
+ *   STATS                 -> OK <tracks> <total plays> <popular tracks>
+ *   ADD <duration> <plays> <genre>\t<title>   -> OK <id>
+ *
+ * Text fields are the rest of the line after the numbers, with a tab
+ * between genre and title; tabs and line breaks inside them are sent
+ * as spaces.
+ * Anything else is answered with "ERR <reason>" and the connection
+ * stays open, except after a line longer than MAX_REQUEST_BYTES.
+ * Numbers are decimal; words are separated by spaces.
+ *
+ * One thread runs the event loop (run() or poll()) and is the only one
+ * that touches the catalog, so the catalog needs no locking. Sockets
+ * are non-blocking and watched with epoll: a readable socket is read
+ * until it would block, every complete line is answered, and the
+ * answers go out in as few write() calls as possible. A client that
+ * stops reading its answers is not read from until its output drains.
+ * stop() may be called from any thread or a signal handler.
+ */
+class CatalogServer {
+public:
+    static const int MAX_REQUEST_BYTES = 4096;
+    static const int MAX_TOP_TRACKS = 1000;
+    static const size_t MAX_PENDING_OUTPUT = 1 << 20;
+
+    /**
+     * Constructor
+     * Enables the catalog's popularity index (for TOP) if needed
+     * @param catalog Catalog to serve; must outlive the server
+     */
+    explicit CatalogServer(TrackCatalog& catalog);
+
+    /**
+     * Destructor
+     * Closes every connection and listening socket
+     */
+    ~CatalogServer();
+
+    /**
+     * Listen for TCP connections on 127.0.0.1
+     * @param port Port number, or 0 for any free port (see getPort())
+     * @return true on success
+     */
+    bool listenTcp(int port);
+
+    /**
+     * Listen for connections on a Unix socket, replacing a stale one
+     * @param path Socket path, removed again by the destructor
+     * @return true on success
+     */
+    bool listenUnix(const string& path);
+
+    /**
+     * Get the TCP port being listened on
+     * @return Port number, or 0 if not listening on TCP
+     */
+    int getPort() const;
+
+    /**
+     * Handle events until stop() is called
+     */
+    void run();
+
+    /**
+     * Handle one round of events
+     * @param timeoutMs Longest wait for an event, -1 for no limit
+     * @return Number of events handled, or -1 on error
+     */
+    int poll(int timeoutMs);
+
+    /**
+     * Make run() return after the current round; safe from any thread
+     * and from signal handlers
+     */
+    void stop();
+
+    /**
+     * Answer one request
+     * @param line Request text, without the '\n'
+     * @param length Length of the request
+     * @param response Receives the response line, '\n' included
+     */
+    void handleRequest(const char* line, int length, string& response);
+
+    // Statistics - read them from the event loop thread
+    int connectionCount() const;
+    long long requestCount() const;
+
+private:
+    struct Connection {
+        int fd;
+        string input;           // bytes read but not yet answered, from inputStart
+        size_t inputStart;
+        string output;          // answers not yet written, from outputStart
+        size_t outputStart;
+        unsigned int events;    // epoll events being waited for
+        bool readPaused;        // too much unsent output, not reading requests
+        bool closeAfterWrite;   // close once the output is sent
+    };
+
+    TrackCatalog& catalog;
+    int epollFd;
+    int tcpFd;
+    int unixFd;
+    int wakeFd;
+    int port;
+    string unixPath;
+    bool stopping;              // set by the loop when stop() wakes it
+    map<int, Connection*> connections;
+    long long requests;
+
+    bool addListener(int fd);
+    void addTrack(const char* cursor, const char* end, string& response);
+    void acceptAll(int listenFd);
+    void readRequests(Connection* connection);
+    void answerRequests(Connection* connection);
+    bool writeAnswers(Connection* connection);
+    void finishWrite(Connection* connection);
+    void updateEvents(Connection* connection);
+    void closeConnection(Connection* connection);
+
+    // A server owns sockets - disable copying
+    CatalogServer(const CatalogServer&);
+    CatalogServer& operator=(const CatalogServer&);
+};
+
+#endif
@@ -0,0 +1,477 @@
+#include "checkpoint.h"
+#include "catalogfile.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+using namespace std;
+
+static const char DELTA_MAGIC[8] = { 'G', 'I', 'M', 'S', 'D', 'L', 'T', '\0' };
+
+/**
+ * Payload Checksum
+ * FNV-1a over the entry bytes
+ */
+static uint32_t payloadChecksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ (unsigned char)data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static bool fileExists(const string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0;
+}
+
+static long long fileSize(const string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? (long long)info.st_size : 0;
+}
+
+static bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static bool writeDeltaHeader(int fd, uint64_t logSequence) {
+    CheckpointDeltaHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DELTA_MAGIC, sizeof(header.magic));
+    header.version = CHECKPOINT_DELTA_VERSION;
+    header.headerSize = sizeof(CheckpointDeltaHeader);
+    header.logSequence = logSequence;
+    return writeAll(fd, (const char*)&header, sizeof(header));
+}
+
+/**
+ * Delta Scan
+ * Every complete record of a delta file, in order
+ */
+struct DeltaScan {
+    bool valid;                      // false if the file is not a delta file
+    uint64_t logSequence;            // from the last record, or the header
+    long long validEnd;              // bytes up to the last complete record
+    bool truncatedTail;
+    vector<vector<char> > records;   // entry payloads
+};
+
+/**
+ * Scan Delta
+ * A missing or header-less file is an empty delta; reading stops at the
+ * first record that is short, out of sequence or fails its checksum
+ */
+static DeltaScan scanDelta(const string& path, bool keepPayloads) {
+    DeltaScan scan;
+    scan.valid = true;
+    scan.logSequence = 0;
+    scan.validEnd = 0;
+    scan.truncatedTail = false;
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        scan.valid = (errno == ENOENT);
+        return scan;
+    }
+
+    CheckpointDeltaHeader header;
+    size_t got = fread(&header, 1, sizeof(header), file);
+    if (got < sizeof(header)) {
+        scan.truncatedTail = got > 0;
+        scan.valid = !ferror(file);
+        fclose(file);
+        return scan;
+    }
+    if (memcmp(header.magic, DELTA_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != CHECKPOINT_DELTA_VERSION || header.headerSize != sizeof(CheckpointDeltaHeader)) {
+        scan.valid = false;
+        fclose(file);
+        return scan;
+    }
+    scan.logSequence = header.logSequence;
+    scan.validEnd = sizeof(header);
+
+    // A payload can never be larger than the rest of the file
+    struct stat info;
+    long long totalBytes = (fstat(fileno(file), &info) == 0) ? (long long)info.st_size : 0;
+
+    vector<char> payload;
+    while (true) {
+        CheckpointRecordHeader record;
+        got = fread(&record, 1, sizeof(record), file);
+        if (got == 0) {
+            break;
+        }
+        long long remaining = totalBytes - scan.validEnd - (long long)sizeof(record);
+        bool complete = got == sizeof(record) && record.sequence == scan.records.size() + 1 &&
+                        record.payloadSize <= (uint64_t)(remaining > 0 ? remaining : 0);
+        if (complete) {
+            payload.resize((size_t)record.payloadSize);
+            complete = (record.payloadSize == 0 || fread(&payload[0], 1, payload.size(), file) == payload.size()) &&
+                       payloadChecksum(payload.empty() ? NULL : &payload[0], payload.size()) == record.checksum;
+        }
+        if (!complete) {
+            scan.truncatedTail = true;
+            break;
+        }
+
+        scan.logSequence = record.logSequence;
+        scan.validEnd += sizeof(record) + record.payloadSize;
+        scan.records.push_back(vector<char>());
+        if (keepPayloads) {
+            scan.records.back().swap(payload);
+        }
+    }
+    scan.valid = !ferror(file);
+    fclose(file);
+    return scan;
+}
+
+/**
+ * Apply Record
+ * Check every entry first so a damaged record changes nothing
+ * @return Number of entries applied, or -1 if the record is invalid
+ */
+static int applyRecord(const vector<char>& payload, TrackCatalog& catalog) {
+    vector<size_t> offsets;
+    size_t position = 0;
+    int tracks = catalog.size();
+    while (position < payload.size()) {
+        CheckpointEntry entry;
+        if (payload.size() - position < sizeof(entry)) {
+            return -1;
+        }
+        memcpy(&entry, &payload[position], sizeof(entry));
+        size_t textBytes = (size_t)entry.titleLength + entry.genreLength;
+        if (payload.size() - position - sizeof(entry) < textBytes || entry.id < 0 || entry.id > tracks) {
+            return -1;
+        }
+        if (entry.id == tracks) {
+            tracks++;
+        }
+        offsets.push_back(position);
+        position += sizeof(entry) + textBytes;
+    }
+
+    string title;
+    string genre;
+    for (size_t i = 0; i < offsets.size(); i++) {
+        CheckpointEntry entry;
+        memcpy(&entry, &payload[offsets[i]], sizeof(entry));
+        const char* text = &payload[offsets[i] + sizeof(entry)];
+        title.assign(text, entry.titleLength);
+        genre.assign(text + entry.titleLength, entry.genreLength);
+
+        if (entry.id == catalog.size()) {
+            catalog.addTrack(title, entry.duration, genre);
+        } else {
+            // Only replace text that changed, so the title arena does not fill with copies
+            int length = 0;
+            const char* current = catalog.getTitleData(entry.id, &length);
+            if (title.compare(0, title.size(), current, length) != 0) {
+                catalog.setTitle(entry.id, title);
+            }
+            if (catalog.getGenre(entry.id) != genre) {
+                catalog.setGenre(entry.id, genre);
+            }
+            catalog.setDuration(entry.id, entry.duration);
+        }
+        catalog.setPlayCount(entry.id, entry.playCount);
+    }
+    return (int)offsets.size();
+}
+
+// CatalogCheckpoint
+
+CatalogCheckpoint::CatalogCheckpoint(const string& path)
+    : basePath(path), compactionPercent(DEFAULT_COMPACTION_PERCENT), ready(false),
+      savedTracks(0), nextRecord(1), lastEntries(0), compacted(false) {
+}
+
+const string& CatalogCheckpoint::getBasePath() const {
+    return basePath;
+}
+
+string CatalogCheckpoint::getDeltaPath() const {
+    return basePath + ".delta";
+}
+
+void CatalogCheckpoint::setCompactionPercent(int percent) {
+    compactionPercent = (percent < 1) ? 1 : (percent > 1000 ? 1000 : percent);
+}
+
+int CatalogCheckpoint::getCompactionPercent() const {
+    return compactionPercent;
+}
+
+/**
+ * Load
+ * Finish an interrupted compaction, load the base image, then apply
+ * the delta records in order and cut off a torn last record
+ */
+bool CatalogCheckpoint::load(TrackCatalog& catalog, CheckpointLoad* report) {
+    CheckpointLoad result;
+    memset(&result, 0, sizeof(result));
+    if (report != NULL) {
+        *report = result;
+    }
+    if (catalog.size() != 0) {
+        return false;
+    }
+
+    // A complete ".next" image is newer than base + delta together
+    string nextPath = basePath + ".next";
+    if (fileExists(nextPath)) {
+        DeltaScan scan = scanDelta(getDeltaPath(), false);
+        if (!scan.valid || !resetDelta(scan.logSequence) || rename(nextPath.c_str(), basePath.c_str()) != 0) {
+            return false;
+        }
+        result.finishedCompaction = true;
+    }
+
+    if (fileExists(basePath) && !loadCatalogFile(basePath, catalog)) {
+        return false;
+    }
+    result.baseTracks = catalog.size();
+
+    DeltaScan scan = scanDelta(getDeltaPath(), true);
+    if (!scan.valid) {
+        return false;
+    }
+    for (size_t r = 0; r < scan.records.size(); r++) {
+        int applied = applyRecord(scan.records[r], catalog);
+        if (applied < 0) {
+            return false;
+        }
+        result.deltaRecords++;
+        result.deltaEntries += applied;
+    }
+    result.truncatedTail = scan.truncatedTail;
+    result.logSequence = scan.logSequence;
+
+    if (scan.truncatedTail) {
+        if (scan.validEnd == 0) {
+            if (!resetDelta(scan.logSequence)) {
+                return false;
+            }
+        } else if (truncate(getDeltaPath().c_str(), scan.validEnd) != 0) {
+            return false;
+        }
+    }
+
+    catalog.clearChangedTracks();
+    ready = true;
+    savedTracks = catalog.size();
+    nextRecord = scan.records.size() + 1;
+    if (report != NULL) {
+        *report = result;
+    }
+    return true;
+}
+
+/**
+ * Checkpoint
+ * Append the changed tracks as one record, then let go of the play
+ * log frames it covers; compact when the delta is too big
+ */
+bool CatalogCheckpoint::checkpoint(TrackCatalog& catalog, PlayLog* log) {
+    lastEntries = 0;
+    compacted = false;
+    if (!ready) {
+        return false;
+    }
+
+    uint64_t logSequence = 0;
+    if (!syncLog(catalog, log, &logSequence)) {
+        return false;
+    }
+
+    vector<int> ids;
+    changedIds(catalog, ids);
+
+    if (!ids.empty() || log != NULL) {
+        if (!appendRecord(catalog, ids, logSequence)) {
+            return false;
+        }
+        catalog.clearChangedTracks();
+        savedTracks = catalog.size();
+        lastEntries = (int)ids.size();
+        if (log != NULL && !log->reset()) {
+            return false;
+        }
+    }
+
+    long long deltaBytes = fileSize(getDeltaPath()) - (long long)sizeof(CheckpointDeltaHeader);
+    if (deltaBytes > 0 && deltaBytes * 100 > fileSize(basePath) * compactionPercent) {
+        int entries = lastEntries;
+        bool ok = compact(catalog, log);
+        lastEntries = entries;
+        return ok;
+    }
+    return true;
+}
+
+/**
+ * Compact
+ * Checkpoint first, so the delta names the newest play log frame, then
+ * write basePath.next, empty the delta and rename the new base over
+ * the old one. A crash at any step leaves either base + delta or a
+ * complete .next that load() finishes installing.
+ */
+bool CatalogCheckpoint::compact(TrackCatalog& catalog, PlayLog* log) {
+    lastEntries = 0;
+    compacted = false;
+    if (!ready) {
+        return false;
+    }
+
+    uint64_t logSequence = 0;
+    if (!syncLog(catalog, log, &logSequence)) {
+        return false;
+    }
+    vector<int> ids;
+    changedIds(catalog, ids);
+    if ((!ids.empty() || log != NULL) && !appendRecord(catalog, ids, logSequence)) {
+        return false;
+    }
+
+    string nextPath = basePath + ".next";
+    if (!writeCatalogFile(catalog, nextPath) || !resetDelta(logSequence) ||
+        rename(nextPath.c_str(), basePath.c_str()) != 0) {
+        return false;
+    }
+
+    catalog.clearChangedTracks();
+    savedTracks = catalog.size();
+    lastEntries = (int)ids.size();
+    compacted = true;
+    return log == NULL || log->reset();
+}
+
+int CatalogCheckpoint::getLastEntryCount() const {
+    return lastEntries;
+}
+
+bool CatalogCheckpoint::lastCompacted() const {
+    return compacted;
+}
+
+// Private helpers
+
+/**
+ * Sync Log
+ * Fold in concurrent plays, then make every logged play durable so
+ * the checkpoint can name the last frame it covers
+ */
+bool CatalogCheckpoint::syncLog(TrackCatalog& catalog, PlayLog* log, uint64_t* logSequence) {
+    if (catalog.hasConcurrentPlays()) {
+        catalog.collectConcurrentPlays();
+    }
+    if (log == NULL) {
+        *logSequence = 0;
+        return true;
+    }
+    if (!log->sync()) {
+        return false;
+    }
+    *logSequence = log->getLastSequence();
+    return true;
+}
+
+/**
+ * Changed Ids
+ * The recorded changes plus every track added since the last
+ * checkpoint, even if it was added before tracking began
+ */
+void CatalogCheckpoint::changedIds(const TrackCatalog& catalog, vector<int>& ids) const {
+    TrackBitmap changed = catalog.changedTracks();
+    for (int id = savedTracks; id < catalog.size(); id++) {
+        changed.add(id);
+    }
+    changed.toIds(ids);
+}
+
+/**
+ * Append Record
+ * Build the entries in memory, then add them with one write() and
+ * make them durable before returning
+ */
+bool CatalogCheckpoint::appendRecord(const TrackCatalog& catalog, const vector<int>& ids, uint64_t logSequence) {
+    vector<char> payload;
+    for (size_t i = 0; i < ids.size(); i++) {
+        int id = ids[i];
+        int titleLength = 0;
+        const char* title = catalog.getTitleData(id, &titleLength);
+        const string& genre = catalog.getGenre(id);
+
+        CheckpointEntry entry;
+        entry.id = id;
+        entry.duration = catalog.getDuration(id);
+        entry.playCount = catalog.getPlayCount(id);
+        entry.titleLength = titleLength;
+        entry.genreLength = (uint32_t)genre.size();
+
+        size_t position = payload.size();
+        payload.resize(position + sizeof(entry) + titleLength + genre.size());
+        memcpy(&payload[position], &entry, sizeof(entry));
+        memcpy(&payload[position + sizeof(entry)], title, titleLength);
+        memcpy(&payload[position + sizeof(entry) + titleLength], genre.data(), genre.size());
+    }
+
+    CheckpointRecordHeader record;
+    memset(&record, 0, sizeof(record));
+    record.sequence = nextRecord;
+    record.logSequence = logSequence;
+    record.payloadSize = payload.size();
+    record.entryCount = (uint32_t)ids.size();
+    record.checksum = payloadChecksum(payload.empty() ? NULL : &payload[0], payload.size());
+
+    int fd = open(getDeltaPath().c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    bool ok = fstat(fd, &info) == 0 && (info.st_size > 0 || writeDeltaHeader(fd, 0)) &&
+              writeAll(fd, (const char*)&record, sizeof(record)) &&
+              (payload.empty() || writeAll(fd, &payload[0], payload.size())) &&
+              fdatasync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    if (ok) {
+        nextRecord++;
+    }
+    return ok;
+}
+
+/**
+ * Reset Delta
+ * Replace the delta with an empty one under a temporary name, so a
+ * crash leaves the old delta or the new one, never half of either
+ */
+bool CatalogCheckpoint::resetDelta(uint64_t logSequence) {
+    string tempPath = getDeltaPath() + ".tmp";
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = writeDeltaHeader(fd, logSequence) && fdatasync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    if (!ok || rename(tempPath.c_str(), getDeltaPath().c_str()) != 0) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    nextRecord = 1;
+    return true;
+}
@@ -0,0 +1,164 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "trackcatalog.h"
+#include "playlog.h"
+using namespace std;
+
+/**
+ * Checkpoint Delta File - Maître Gims Studio Management System
+ *
+ * A checkpoint is stored as a base image (a binary catalog file, see
+ * catalogfile.h) plus a delta file holding the tracks changed since:
+ *
+ *   CheckpointDeltaHeader
+ *   record, record, ...
+ *
+ * where each record is one checkpoint():
+ *
+ *   CheckpointRecordHeader
+ *   entries[entryCount]: CheckpointEntry, title bytes, genre bytes
+ *
+ * Entries hold a track's full state, sorted by id; an id equal to the
+ * track count adds the track. Records are numbered and checksummed
+ * like play log frames, and loading stops at the first torn one.
+ */
+
+const uint32_t CHECKPOINT_DELTA_VERSION = 1;
+
+struct CheckpointDeltaHeader {
+    char magic[8];          // "GIMSDLT" + '\0'
+    uint32_t version;       // CHECKPOINT_DELTA_VERSION
+    uint32_t headerSize;    // sizeof(CheckpointDeltaHeader)
+    uint64_t logSequence;   // last play log frame covered by the base image
+};
+
+struct CheckpointRecordHeader {
+    uint64_t sequence;      // 1, 2, 3, ... within the delta file
+    uint64_t logSequence;   // last play log frame covered by this checkpoint
+    uint64_t payloadSize;   // bytes of entries after this header
+    uint32_t entryCount;
+    uint32_t checksum;      // of the payload
+};
+
+struct CheckpointEntry {
+    int32_t id;
+    int32_t duration;
+    int32_t playCount;
+    uint32_t titleLength;
+    uint32_t genreLength;
+};
+
+/**
+ * What load() found
+ */
+struct CheckpointLoad {
+    int baseTracks;             // tracks in the base image
+    int deltaRecords;           // checkpoints applied on top of it
+    long long deltaEntries;     // track states read from those checkpoints
+    bool truncatedTail;         // a torn record was found (and ignored) at the end
+    bool finishedCompaction;    // a compaction interrupted by a crash was completed
+    uint64_t logSequence;       // pass to PlayLog::replay() as afterSequence
+};
+
+/**
+ * CatalogCheckpoint Class - Maître Gims Studio Management System
+ *
+ * Incremental checkpoints for a TrackCatalog with change tracking
+ * enabled. checkpoint() appends only the tracks changed since the last
+ * checkpoint to the delta file; once the delta grows past a percentage
+ * of the base image it is compacted: the whole catalog is written as a
+ * new base and the delta starts over. Restarting therefore costs one
+ * base load plus a bounded delta.
+ *
+ * With a play log, checkpoint() syncs the log, records its last frame
+ * and then resets it, so after a restart only the plays since the last
+ * checkpoint are replayed:
+ *
+ *   TrackCatalog catalog;
+ *   CatalogCheckpoint checkpoints("catalog.bin");   // + "catalog.bin.delta"
+ *   CheckpointLoad loaded;
+ *   checkpoints.load(catalog, &loaded);
+ *   catalog.enableChangeTracking();
+ *   PlayLog::replay("plays.log", catalog, NULL, loaded.logSequence);
+ *   PlayLog log;
+ *   log.open("plays.log");
+ *   catalog.attachPlayLog(&log);
+ *   ...
+ *   checkpoints.checkpoint(catalog, &log);           // now and then
+ *
+ * Compaction writes the new base as basePath + ".next" before the
+ * delta is emptied and the base renamed into place; load() finishes a
+ * compaction that a crash interrupted. Not thread-safe; concurrent
+ * plays are collected by checkpoint().
+ */
+class CatalogCheckpoint {
+public:
+    static const int DEFAULT_COMPACTION_PERCENT = 25;
+
+    /**
+     * Constructor
+     * @param basePath Base image file; the delta file is basePath + ".delta"
+     */
+    explicit CatalogCheckpoint(const string& basePath);
+
+    const string& getBasePath() const;
+    string getDeltaPath() const;
+
+    /**
+     * Compact once the delta file is larger than this percentage of
+     * the base image (1 - 1000)
+     * @param percent Delta size limit in percent of the base size
+     */
+    void setCompactionPercent(int percent);
+    int getCompactionPercent() const;
+
+    /**
+     * Rebuild a catalog from the base image and the delta file
+     * @param catalog Empty catalog to fill; its recorded changes are cleared
+     * @param report Optional statistics
+     * @return true on success; no base image at all is an empty catalog
+     */
+    bool load(TrackCatalog& catalog, CheckpointLoad* report = NULL);
+
+    /**
+     * Save the tracks changed since the last checkpoint, and compact
+     * if the delta has grown too large. Needs a load() first.
+     * @param catalog Catalog with change tracking enabled
+     * @param log Play log attached to the catalog, or NULL
+     * @return true once the checkpoint is on disk
+     */
+    bool checkpoint(TrackCatalog& catalog, PlayLog* log = NULL);
+
+    /**
+     * Write the whole catalog as a new base image and empty the delta.
+     * Needs a load() first.
+     * @param catalog Catalog to save
+     * @param log Play log attached to the catalog, or NULL
+     * @return true once the new base is in place
+     */
+    bool compact(TrackCatalog& catalog, PlayLog* log = NULL);
+
+    // Statistics of the last checkpoint() or compact()
+    int getLastEntryCount() const;
+    bool lastCompacted() const;
+
+private:
+    string basePath;
+    int compactionPercent;
+    bool ready;                  // load() has run, so base and delta are known
+    int savedTracks;             // tracks covered by base + delta
+    uint64_t nextRecord;         // sequence number of the next delta record
+    int lastEntries;
+    bool compacted;
+
+    bool appendRecord(const TrackCatalog& catalog, const vector<int>& ids, uint64_t logSequence);
+    bool resetDelta(uint64_t logSequence);
+    bool syncLog(TrackCatalog& catalog, PlayLog* log, uint64_t* logSequence);
+    void changedIds(const TrackCatalog& catalog, vector<int>& ids) const;
+};
+
+#endif
@@ -0,0 +1,322 @@
+#include "columnkernels.h"
+#include <climits>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define COLUMN_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// Scalar kernels: the reference every vector kernel must match
+
+static int countAboveScalar(const int* values, int count, int threshold) {
+    int found = 0;
+    for (int i = 0; i < count; i++) {
+        found += values[i] > threshold ? 1 : 0;
+    }
+    return found;
+}
+
+static int selectAboveScalar(const int* values, int begin, int count, int threshold, int* ids) {
+    int found = 0;
+    for (int i = begin; i < count; i++) {
+        if (values[i] > threshold) {
+            ids[found++] = i;
+        }
+    }
+    return found;
+}
+
+static void statsScalar(const int* values, int begin, int count, ColumnStats& stats) {
+    for (int i = begin; i < count; i++) {
+        if (values[i] < stats.minimum) {
+            stats.minimum = values[i];
+        }
+        if (values[i] > stats.maximum) {
+            stats.maximum = values[i];
+        }
+        stats.sum += values[i];
+    }
+}
+
+static int selectAboveAll(const int* values, int count, int threshold, int* ids) {
+    return selectAboveScalar(values, 0, count, threshold, ids);
+}
+
+static ColumnStats columnStatsScalar(const int* values, int count) {
+    ColumnStats stats = { INT_MAX, INT_MIN, 0 };
+    statsScalar(values, 0, count, stats);
+    return stats;
+}
+
+#ifdef COLUMN_KERNELS_X86
+
+// SSE4.1 kernels, 4 values per step
+
+__attribute__((target("sse4.1")))
+static int countAboveSse4(const int* values, int count, int threshold) {
+    __m128i limit = _mm_set1_epi32(threshold);
+    __m128i found = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(values + i));
+        found = _mm_sub_epi32(found, _mm_cmpgt_epi32(v, limit));   // true lanes are -1
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, found);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + countAboveScalar(values + i, count - i, threshold);
+}
+
+__attribute__((target("sse4.1")))
+static int selectAboveSse4(const int* values, int count, int threshold, int* ids) {
+    __m128i limit = _mm_set1_epi32(threshold);
+    int found = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(values + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, limit)));
+        while (mask != 0) {
+            ids[found++] = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    return found + selectAboveScalar(values, i, count, threshold, ids + found);
+}
+
+__attribute__((target("sse4.1")))
+static ColumnStats columnStatsSse4(const int* values, int count) {
+    ColumnStats stats = { INT_MAX, INT_MIN, 0 };
+    __m128i minimum = _mm_set1_epi32(INT_MAX);
+    __m128i maximum = _mm_set1_epi32(INT_MIN);
+    __m128i sum = _mm_setzero_si128();   // two 64-bit lanes
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(values + i));
+        minimum = _mm_min_epi32(minimum, v);
+        maximum = _mm_max_epi32(maximum, v);
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(v));
+        sum = _mm_add_epi64(sum, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    int minimums[4];
+    int maximums[4];
+    long long sums[2];
+    _mm_storeu_si128((__m128i*)minimums, minimum);
+    _mm_storeu_si128((__m128i*)maximums, maximum);
+    _mm_storeu_si128((__m128i*)sums, sum);
+    for (int lane = 0; lane < 4; lane++) {
+        stats.minimum = minimums[lane] < stats.minimum ? minimums[lane] : stats.minimum;
+        stats.maximum = maximums[lane] > stats.maximum ? maximums[lane] : stats.maximum;
+    }
+    stats.sum = sums[0] + sums[1];
+    statsScalar(values, i, count, stats);
+    return stats;
+}
+
+// AVX2 kernels, 8 values per step
+
+// For every 8-bit lane mask, the lane numbers of its set bits packed to
+// the front; used to compact selected ids with one permute
+static int compressTable[256][8];
+
+static void buildCompressTable() {
+    for (int mask = 0; mask < 256; mask++) {
+        int position = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            if (mask & (1 << lane)) {
+                compressTable[mask][position++] = lane;
+            }
+        }
+        while (position < 8) {
+            compressTable[mask][position++] = 0;
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static int countAboveAvx2(const int* values, int count, int threshold) {
+    __m256i limit = _mm256_set1_epi32(threshold);
+    __m256i found = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(values + i));
+        found = _mm256_sub_epi32(found, _mm256_cmpgt_epi32(v, limit));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, found);
+    int total = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        total += lanes[lane];
+    }
+    return total + countAboveScalar(values + i, count - i, threshold);
+}
+
+/**
+ * Select Above (AVX2)
+ * Each step stores 8 candidate ids and advances by the number that
+ * matched; the store stays inside ids[] because found <= i and
+ * i + 8 <= count
+ */
+__attribute__((target("avx2")))
+static int selectAboveAvx2(const int* values, int count, int threshold, int* ids) {
+    __m256i limit = _mm256_set1_epi32(threshold);
+    __m256i lanesUp = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    int found = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(values + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, limit)));
+        if (mask == 0) {
+            continue;
+        }
+        __m256i order = _mm256_loadu_si256((const __m256i*)compressTable[mask]);
+        __m256i idsHere = _mm256_add_epi32(_mm256_set1_epi32(i), lanesUp);
+        _mm256_storeu_si256((__m256i*)(ids + found), _mm256_permutevar8x32_epi32(idsHere, order));
+        found += __builtin_popcount(mask);
+    }
+    return found + selectAboveScalar(values, i, count, threshold, ids + found);
+}
+
+__attribute__((target("avx2")))
+static ColumnStats columnStatsAvx2(const int* values, int count) {
+    ColumnStats stats = { INT_MAX, INT_MIN, 0 };
+    __m256i minimum = _mm256_set1_epi32(INT_MAX);
+    __m256i maximum = _mm256_set1_epi32(INT_MIN);
+    __m256i sum = _mm256_setzero_si256();   // four 64-bit lanes
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(values + i));
+        minimum = _mm256_min_epi32(minimum, v);
+        maximum = _mm256_max_epi32(maximum, v);
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    int minimums[8];
+    int maximums[8];
+    long long sums[4];
+    _mm256_storeu_si256((__m256i*)minimums, minimum);
+    _mm256_storeu_si256((__m256i*)maximums, maximum);
+    _mm256_storeu_si256((__m256i*)sums, sum);
+    for (int lane = 0; lane < 8; lane++) {
+        stats.minimum = minimums[lane] < stats.minimum ? minimums[lane] : stats.minimum;
+        stats.maximum = maximums[lane] > stats.maximum ? maximums[lane] : stats.maximum;
+    }
+    stats.sum = sums[0] + sums[1] + sums[2] + sums[3];
+    statsScalar(values, i, count, stats);
+    return stats;
+}
+
+#endif
+
+// Runtime dispatch
+
+struct KernelTable {
+    KernelLevel level;
+    int (*countAbove)(const int*, int, int);
+    int (*selectAbove)(const int*, int, int, int*);
+    ColumnStats (*columnStats)(const int*, int);
+};
+
+static KernelTable kernels;
+static bool kernelsReady = false;
+
+static KernelLevel detectKernelLevel() {
+#ifdef COLUMN_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return KERNEL_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return KERNEL_SSE4;
+    }
+#endif
+    return KERNEL_SCALAR;
+}
+
+static void useKernelLevel(KernelLevel level) {
+    KernelLevel supported = detectKernelLevel();
+    if (level > supported) {
+        level = supported;
+    }
+    kernels.level = KERNEL_SCALAR;
+    kernels.countAbove = countAboveScalar;
+    kernels.selectAbove = selectAboveAll;
+    kernels.columnStats = columnStatsScalar;
+#ifdef COLUMN_KERNELS_X86
+    if (level == KERNEL_AVX2) {
+        buildCompressTable();
+        kernels.level = KERNEL_AVX2;
+        kernels.countAbove = countAboveAvx2;
+        kernels.selectAbove = selectAboveAvx2;
+        kernels.columnStats = columnStatsAvx2;
+    } else if (level == KERNEL_SSE4) {
+        kernels.level = KERNEL_SSE4;
+        kernels.countAbove = countAboveSse4;
+        kernels.selectAbove = selectAboveSse4;
+        kernels.columnStats = columnStatsSse4;
+    }
+#endif
+    kernelsReady = true;
+}
+
+/**
+ * Active Kernels
+ * Pick the best level on first use. This also runs once at program
+ * start (KernelStartup below), so threads never race on the first call.
+ */
+static const KernelTable& activeKernels() {
+    if (!kernelsReady) {
+        useKernelLevel(KERNEL_AVX2);
+    }
+    return kernels;
+}
+
+static struct KernelStartup {
+    KernelStartup() {
+        activeKernels();
+    }
+} kernelStartup;
+
+int countAbove(const int* values, int count, int threshold) {
+    if (values == NULL || count <= 0) {
+        return 0;
+    }
+    return activeKernels().countAbove(values, count, threshold);
+}
+
+int selectAbove(const int* values, int count, int threshold, int* ids) {
+    if (values == NULL || ids == NULL || count <= 0) {
+        return 0;
+    }
+    return activeKernels().selectAbove(values, count, threshold, ids);
+}
+
+ColumnStats columnStats(const int* values, int count) {
+    if (values == NULL || count <= 0) {
+        ColumnStats empty = { 0, 0, 0 };
+        return empty;
+    }
+    return activeKernels().columnStats(values, count);
+}
+
+KernelLevel getKernelLevel() {
+    return activeKernels().level;
+}
+
+KernelLevel getSupportedKernelLevel() {
+    return detectKernelLevel();
+}
+
+void setKernelLevel(KernelLevel level) {
+    useKernelLevel(level);
+}
+
+const char* kernelLevelName(KernelLevel level) {
+    switch (level) {
+        case KERNEL_AVX2:
+            return "avx2";
+        case KERNEL_SSE4:
+            return "sse4";
+        default:
+            return "scalar";
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef COLUMNKERNELS_H
+#define COLUMNKERNELS_H
+
+/**
+ * Column Kernels - Maître Gims Studio Management System
+ *
+ * Vectorized scans over int columns such as TrackCatalog's
+ * playCountData() and durationData(): "how many tracks have more than
+ * N plays", "which ones", and min/max/sum.
+ *
+ * Each kernel has a scalar version and, on x86, SSE4.1 and AVX2
+ * versions. The fastest one the CPU supports is picked at run time the
+ * first time a kernel is called, so the same binary runs everywhere;
+ * no special compiler flags are needed. All versions give exactly the
+ * same results.
+ */
+
+/**
+ * Kernel implementation levels, slowest to fastest
+ */
+enum KernelLevel {
+    KERNEL_SCALAR = 0,
+    KERNEL_SSE4 = 1,
+    KERNEL_AVX2 = 2
+};
+
+/**
+ * ColumnStats - minimum, maximum and 64-bit sum of a column
+ * For an empty column minimum and maximum are 0
+ */
+struct ColumnStats {
+    int minimum;
+    int maximum;
+    long long sum;
+};
+
+/**
+ * Count the values strictly greater than a threshold
+ * @param values Column data
+ * @param count Number of values
+ * @param threshold Values > threshold are counted
+ * @return Number of values above the threshold
+ */
+int countAbove(const int* values, int count, int threshold);
+
+/**
+ * List the indexes of the values strictly greater than a threshold
+ * @param values Column data
+ * @param count Number of values
+ * @param threshold Values > threshold are selected
+ * @param ids Output array with room for count ids; receives the
+ *            indexes in ascending order
+ * @return Number of ids written
+ */
+int selectAbove(const int* values, int count, int threshold, int* ids);
+
+/**
+ * Compute minimum, maximum and sum of a column
+ * @param values Column data
+ * @param count Number of values
+ * @return Column statistics
+ */
+ColumnStats columnStats(const int* values, int count);
+
+/**
+ * Get the kernel level currently used
+ * @return Level picked for this CPU, or the one set by setKernelLevel()
+ */
+KernelLevel getKernelLevel();
+
+/**
+ * Get the best kernel level this CPU supports
+ * @return Highest supported level
+ */
+KernelLevel getSupportedKernelLevel();
+
+/**
+ * Force a kernel level (for tests and benchmarks)
+ * Levels the CPU doesn't support fall back to the best supported one.
+ * Not thread-safe: call it while no kernel is running.
+ * @param level Level to use
+ */
+void setKernelLevel(KernelLevel level);
+
+/**
+ * Get a level's name
+ * @param level Kernel level
+ * @return "scalar", "sse4" or "avx2"
+ */
+const char* kernelLevelName(KernelLevel level);
+
+#endif
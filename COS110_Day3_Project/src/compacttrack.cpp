@@ -0,0 +1,131 @@
+#include "compacttrack.h"
+#include "durationformat.h"
+#include "genretable.h"
+using namespace std;
+
+// CompactTrack
+
+int CompactTrack::getPlayCount() const {
+    return __atomic_load_n(&playCount, __ATOMIC_RELAXED);
+}
+
+int CompactTrack::getDuration() const {
+    return duration;
+}
+
+void CompactTrack::setPlayCount(int p) {
+    __atomic_store_n(&playCount, p < 0 ? 0 : p, __ATOMIC_RELAXED);
+}
+
+void CompactTrack::setDuration(int d) {
+    duration = (d <= 0) ? 180 : d;
+}
+
+void CompactTrack::play() {
+    __atomic_fetch_add(&playCount, 1, __ATOMIC_RELAXED);
+}
+
+void CompactTrack::resetPlayCount() {
+    __atomic_store_n(&playCount, 0, __ATOMIC_RELAXED);
+}
+
+bool CompactTrack::isPopular() const {
+    return getPlayCount() > 1000000;
+}
+
+int CompactTrack::getFormattedDuration(char* buffer, int bufferSize) const {
+    return formatDuration(duration, buffer, bufferSize);
+}
+
+// CompactTrackStore
+
+CompactTrackStore::CompactTrackStore() {
+}
+
+/**
+ * Add Track
+ * The hot record gets the validated numbers; the title goes into the
+ * arena and the genre is interned, both on the cold side
+ */
+int CompactTrackStore::addTrack(const string& t, int d, const string& g) {
+    CompactTrack record;
+    record.playCount = 0;
+    record.setDuration(d);
+
+    ColdTrack info;
+    info.title = t.empty() ? titles.append("Untitled Track") : titles.append(t);
+    info.genreId = GenreTable::shared().intern(g);
+
+    hot.push_back(record);
+    cold.push_back(info);
+    return (int)hot.size() - 1;
+}
+
+int CompactTrackStore::addTrack(const MusicTrack& track) {
+    int index = addTrack(track.getTitle(), track.getDuration(), track.getGenre());
+    hot[index].setPlayCount(track.getPlayCount());
+    return index;
+}
+
+void CompactTrackStore::reserve(int trackCount, size_t titleBytes) {
+    if (trackCount > 0) {
+        hot.reserve(trackCount);
+        cold.reserve(trackCount);
+    }
+    titles.reserve(titleBytes);
+}
+
+int CompactTrackStore::size() const {
+    return (int)hot.size();
+}
+
+CompactTrack& CompactTrackStore::operator[](int index) {
+    return hot[index];
+}
+
+const CompactTrack& CompactTrackStore::operator[](int index) const {
+    return hot[index];
+}
+
+const CompactTrack* CompactTrackStore::records() const {
+    return hot.empty() ? NULL : &hot[0];
+}
+
+string CompactTrackStore::getTitle(int index) const {
+    return titles.get(cold[index].title);
+}
+
+const string& CompactTrackStore::getGenre(int index) const {
+    return GenreTable::shared().getName(cold[index].genreId);
+}
+
+int CompactTrackStore::getGenreId(int index) const {
+    return cold[index].genreId;
+}
+
+void CompactTrackStore::setTitle(int index, const string& t) {
+    cold[index].title = titles.replace(cold[index].title, t.empty() ? string("Untitled Track") : t);
+}
+
+void CompactTrackStore::setGenre(int index, const string& g) {
+    cold[index].genreId = GenreTable::shared().intern(g);
+}
+
+const char* CompactTrackStore::getTitleData(int index, int* length) const {
+    *length = cold[index].title.length;
+    return titles.data(cold[index].title);
+}
+
+MusicTrack CompactTrackStore::getTrack(int index) const {
+    MusicTrack track(getTitle(index), hot[index].duration, getGenre(index));
+    track.setPlayCount(hot[index].getPlayCount());
+    return track;
+}
+
+size_t CompactTrackStore::hotBytes() const {
+    return hot.size() * sizeof(CompactTrack);
+}
+
+size_t CompactTrackStore::coldBytes() const {
+    return cold.size() * sizeof(ColdTrack) + titles.bytesUsed();
+}
@@ -0,0 +1,150 @@
+#ifndef COMPACTTRACK_H
+#define COMPACTTRACK_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "musictrack.h"
+#include "titlearena.h"
+using namespace std;
+
+/**
+ * CompactTrack - the hot part of a track: 8 bytes, no pointers
+ *
+ * Holds only what scans and play counting touch. The title and genre
+ * live in the owning CompactTrackStore's cold side table. Same
+ * validation and semantics as the matching MusicTrack members.
+ */
+struct CompactTrack {
+    int playCount;
+    int duration;   // seconds
+
+    int getPlayCount() const;
+    int getDuration() const;
+    void setPlayCount(int p);   // negative -> 0
+    void setDuration(int d);    // <= 0 -> 180
+    void play();                // atomic, like MusicTrack::play()
+    void resetPlayCount();
+    bool isPopular() const;     // more than 1,000,000 plays
+
+    /**
+     * Write the duration as M:SS into a caller-provided buffer
+     * @param buffer Output buffer (DURATION_TEXT_SIZE bytes always fit)
+     * @param bufferSize Size of the buffer in bytes
+     * @return Number of characters written, or -1 if the buffer is too small
+     */
+    int getFormattedDuration(char* buffer, int bufferSize) const;
+};
+
+/**
+ * CompactTrackStore Class - Maître Gims Studio Management System
+ *
+ * A list of tracks split into hot and cold parts. The hot CompactTrack
+ * records sit back to back in one array (8 bytes per track, against
+ * sizeof(MusicTrack) plus a heap title for the object), so a scan over
+ * play counts or durations reads eight tracks per cache line. Titles
+ * and genres are kept in a cold side table (titles in a TitleArena,
+ * genres as GenreTable::shared() ids) that only getTitle()/getGenre()
+ * touch.
+ *
+ * Tracks are addressed by index, handed out by addTrack().
+ *
+ * Usage:
+ *   CompactTrackStore store;
+ *   int bella = store.addTrack("Bella", 206, "Hip-Hop");
+ *   store[bella].play();
+ *   const CompactTrack* hot = store.records();   // for scans
+ *
+ * Not thread-safe, except play() on distinct or shared records.
+ */
+class CompactTrackStore {
+public:
+    CompactTrackStore();
+
+    /**
+     * Add a track (same validation as the MusicTrack constructor)
+     * @param t Track title
+     * @param d Duration in seconds
+     * @param g Genre of the track
+     * @return Index of the new track
+     */
+    int addTrack(const string& t, int d, const string& g);
+
+    /**
+     * Add a copy of an existing track, including its play count
+     * @param track Track to copy
+     * @return Index of the new track
+     */
+    int addTrack(const MusicTrack& track);
+
+    /**
+     * Reserve room so a bulk load grows each table once
+     * @param trackCount Number of tracks
+     * @param titleBytes Total title bytes expected
+     */
+    void reserve(int trackCount, size_t titleBytes = 0);
+
+    int size() const;
+
+    /**
+     * Access a track's hot record
+     * @param index Track index (must be valid)
+     * @return The record
+     */
+    CompactTrack& operator[](int index);
+    const CompactTrack& operator[](int index) const;
+
+    /**
+     * Get the hot records as one array (size() entries), for scans
+     * @return First record, or NULL if the store is empty
+     */
+    const CompactTrack* records() const;
+
+    // Cold accessors - same semantics as the MusicTrack getters
+    string getTitle(int index) const;
+    const string& getGenre(int index) const;
+    int getGenreId(int index) const;
+    void setTitle(int index, const string& t);
+    void setGenre(int index, const string& g);
+
+    /**
+     * Get the stored title bytes without copying them
+     * The pointer is only valid until the next addTrack()/setTitle()
+     * @param index Track index
+     * @param length Receives the title length in bytes
+     * @return Pointer to the first byte (not '\0' terminated)
+     */
+    const char* getTitleData(int index, int* length) const;
+
+    /**
+     * Copy a track out as a standalone MusicTrack
+     * @param index Track index
+     * @return MusicTrack with the same title, duration, genre and plays
+     */
+    MusicTrack getTrack(int index) const;
+
+    /**
+     * Get the bytes used by the hot records
+     * @return size() * sizeof(CompactTrack)
+     */
+    size_t hotBytes() const;
+
+    /**
+     * Get the bytes used by the cold side table (titles and genre ids)
+     * @return Cold bytes in use
+     */
+    size_t coldBytes() const;
+
+private:
+    // Cold part of one track
+    struct ColdTrack {
+        TitleHandle title;
+        int genreId;
+    };
+
+    vector<CompactTrack> hot;
+    vector<ColdTrack> cold;
+    TitleArena titles;
+};
+
+#endif
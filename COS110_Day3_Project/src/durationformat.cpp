@@ -0,0 +1,59 @@
+#include "durationformat.h"
+
+/**
+ * Format Duration
+ * Write the minutes digits, a ':' and exactly two seconds digits
+ * Examples: 125 -> "2:05", 61 -> "1:01", 3661 -> "61:01"
+ */
+int formatDuration(int seconds, char* buffer, int bufferSize) {
+    if (buffer == NULL || bufferSize <= 0) {
+        return -1;
+    }
+
+    // Work with the magnitude as unsigned so INT_MIN is handled too
+    bool negative = seconds < 0;
+    unsigned int total = negative ? 0u - (unsigned int)seconds : (unsigned int)seconds;
+    unsigned int minutes = total / 60;
+    unsigned int secs = total % 60;
+
+    // Minutes digits come out last-first
+    char digits[10];
+    int digitCount = 0;
+    do {
+        digits[digitCount++] = (char)('0' + minutes % 10);
+        minutes /= 10;
+    } while (minutes > 0);
+
+    int length = (negative ? 1 : 0) + digitCount + 3;
+    if (length + 1 > bufferSize) {
+        buffer[0] = '\0';
+        return -1;
+    }
+
+    char* out = buffer;
+    if (negative) {
+        *out++ = '-';
+    }
+    while (digitCount > 0) {
+        *out++ = digits[--digitCount];
+    }
+    *out++ = ':';
+    *out++ = (char)('0' + secs / 10);
+    *out++ = (char)('0' + secs % 10);
+    *out = '\0';
+
+    return length;
+}
+
+/**
+ * Format Durations
+ * Fixed-size slots keep every entry addressable without an index
+ */
+void formatDurations(const int* durations, int count, char* output, int* lengths) {
+    for (int i = 0; i < count; i++) {
+        int length = formatDuration(durations[i], output + i * DURATION_TEXT_SIZE, DURATION_TEXT_SIZE);
+        if (lengths != NULL) {
+            lengths[i] = length;
+        }
+    }
+}
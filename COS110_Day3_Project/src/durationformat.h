@@ -0,0 +1,40 @@
+#ifndef DURATIONFORMAT_H
+#define DURATIONFORMAT_H
+
+#include <cstddef>
+
+/**
+ * Duration Formatting - Maître Gims Studio Management System
+ *
+ * Turns a duration in seconds into "M:SS" text (e.g. 206 -> "3:26",
+ * 3661 -> "61:01") without touching the heap. The caller owns the
+ * output buffer, so formatting a whole catalog costs no allocations.
+ */
+
+/**
+ * Buffer size that fits any formatted int duration, including the
+ * terminating '\0' (longest is "-35791394:08")
+ */
+const int DURATION_TEXT_SIZE = 16;
+
+/**
+ * Format one duration as "M:SS" into a caller-provided buffer
+ * @param seconds Duration in seconds (negative values get a leading '-')
+ * @param buffer Output buffer, '\0' terminated on success
+ * @param bufferSize Size of the buffer in bytes
+ * @return Number of characters written (without the '\0'),
+ *         or -1 if the buffer is too small (buffer is then left empty)
+ */
+int formatDuration(int seconds, char* buffer, int bufferSize);
+
+/**
+ * Format a whole array of durations in one call.
+ * Entry i is written to output + i * DURATION_TEXT_SIZE, '\0' terminated.
+ * @param durations Durations in seconds
+ * @param count Number of durations
+ * @param output Buffer of at least count * DURATION_TEXT_SIZE bytes
+ * @param lengths Optional array of count ints that receives each length
+ */
+void formatDurations(const int* durations, int count, char* output, int* lengths = NULL);
+
+#endif
@@ -0,0 +1,142 @@
+#include "genreaggregator.h"
+#include <pthread.h>
+#include <unistd.h>
+using namespace std;
+
+double GenreTotals::averagePlays() const {
+    return trackCount > 0 ? (double)totalPlays / trackCount : 0.0;
+}
+
+double GenreTotals::averageSeconds() const {
+    return trackCount > 0 ? (double)totalSeconds / trackCount : 0.0;
+}
+
+/**
+ * GenreSums - one genre's running sums inside one slice
+ */
+struct GenreSums {
+    long long trackCount;
+    long long totalPlays;
+    long long totalSeconds;
+};
+
+/**
+ * AggregateSlice - one thread's share of the catalog and its partials
+ */
+struct AggregateSlice {
+    const int* genreIds;
+    const int* durations;
+    const int* playCounts;
+    int begin;
+    int end;
+    int genreCount;
+    vector<GenreSums> sums;
+};
+
+/**
+ * Aggregate Slice (thread entry point)
+ * Add every track of the slice to its genre's partial sums
+ */
+static void* aggregateSlice(void* arg) {
+    AggregateSlice& slice = *(AggregateSlice*)arg;
+    GenreSums* sums = &slice.sums[0];
+    for (int i = slice.begin; i < slice.end; i++) {
+        int genreId = slice.genreIds[i];
+        if (genreId < 0 || genreId >= slice.genreCount) {
+            continue;
+        }
+        GenreSums& genre = sums[genreId];
+        genre.trackCount++;
+        genre.totalPlays += slice.playCounts[i];
+        genre.totalSeconds += slice.durations[i];
+    }
+    return NULL;
+}
+
+/**
+ * Constructor
+ * Use one thread per online CPU
+ */
+GenreAggregator::GenreAggregator(const TrackCatalog& source) : catalog(source), threadCount(1) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    setThreadCount(cpus > 0 ? (int)cpus : 1);
+}
+
+void GenreAggregator::setThreadCount(int count) {
+    if (count < 1) {
+        count = 1;
+    } else if (count > 64) {
+        count = 64;
+    }
+    threadCount = count;
+}
+
+int GenreAggregator::getThreadCount() const {
+    return threadCount;
+}
+
+/**
+ * Aggregate
+ * Slices 1..n-1 run on their own threads and slice 0 on the calling
+ * thread; the partials are then merged in slice order
+ */
+vector<GenreTotals> GenreAggregator::aggregate() const {
+    int trackCount = catalog.size();
+    int genreCount = catalog.genreCount();
+    vector<GenreTotals> totals;
+    if (trackCount == 0 || genreCount == 0) {
+        return totals;
+    }
+
+    int sliceCount = trackCount / MIN_TRACKS_PER_THREAD;
+    if (sliceCount > threadCount) {
+        sliceCount = threadCount;
+    } else if (sliceCount < 1) {
+        sliceCount = 1;
+    }
+
+    GenreSums zero = { 0, 0, 0 };
+    vector<AggregateSlice> slices(sliceCount);
+    for (int s = 0; s < sliceCount; s++) {
+        AggregateSlice& slice = slices[s];
+        slice.genreIds = catalog.genreIdData();
+        slice.durations = catalog.durationData();
+        slice.playCounts = catalog.playCountData();
+        slice.begin = (int)((long long)trackCount * s / sliceCount);
+        slice.end = (int)((long long)trackCount * (s + 1) / sliceCount);
+        slice.genreCount = genreCount;
+        slice.sums.assign(genreCount, zero);
+    }
+
+    vector<pthread_t> threads(sliceCount);
+    vector<bool> started(sliceCount, false);
+    for (int s = 1; s < sliceCount; s++) {
+        started[s] = pthread_create(&threads[s], NULL, aggregateSlice, &slices[s]) == 0;
+    }
+    aggregateSlice(&slices[0]);
+    for (int s = 1; s < sliceCount; s++) {
+        if (started[s]) {
+            pthread_join(threads[s], NULL);
+        } else {
+            aggregateSlice(&slices[s]);
+        }
+    }
+
+    for (int genreId = 0; genreId < genreCount; genreId++) {
+        GenreTotals genre;
+        genre.genreId = genreId;
+        genre.trackCount = 0;
+        genre.totalPlays = 0;
+        genre.totalSeconds = 0;
+        for (int s = 0; s < sliceCount; s++) {
+            genre.trackCount += slices[s].sums[genreId].trackCount;
+            genre.totalPlays += slices[s].sums[genreId].totalPlays;
+            genre.totalSeconds += slices[s].sums[genreId].totalSeconds;
+        }
+        if (genre.trackCount > 0) {
+            genre.genre = catalog.genreName(genreId);
+            totals.push_back(genre);
+        }
+    }
+    return totals;
+}
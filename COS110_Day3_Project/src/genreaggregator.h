@@ -0,0 +1,73 @@
+#ifndef GENREAGGREGATOR_H
+#define GENREAGGREGATOR_H
+
+#include <string>
+#include <vector>
+#include "trackcatalog.h"
+using namespace std;
+
+/**
+ * GenreTotals - per-genre figures for royalty and programming reports
+ * Sums are 64-bit, so they cannot overflow the int play count and
+ * duration fields they add up
+ */
+struct GenreTotals {
+    int genreId;              // id in the catalog's genreIdData()
+    string genre;             // genre name (e.g. "Hip-Hop")
+    long long trackCount;
+    long long totalPlays;
+    long long totalSeconds;   // sum of durations
+
+    double averagePlays() const;
+    double averageSeconds() const;
+};
+
+/**
+ * GenreAggregator Class - Maître Gims Studio Management System
+ *
+ * Computes track count, total plays and total runtime for every genre
+ * of a TrackCatalog in one pass over its columns. The catalog is cut
+ * into one contiguous slice per thread; each thread sums its slice
+ * into its own per-genre partials, and the partials are merged at the
+ * end, so threads never share a counter.
+ *
+ * Reads playCountData(): in concurrent play mode, call
+ * collectConcurrentPlays() first to include pending plays. The catalog
+ * must not change while aggregate() runs.
+ *
+ * Usage:
+ *   GenreAggregator aggregator(catalog);
+ *   aggregator.setThreadCount(8);
+ *   vector<GenreTotals> totals = aggregator.aggregate();
+ */
+class GenreAggregator {
+public:
+    // Slices smaller than this are not worth a thread of their own
+    static const int MIN_TRACKS_PER_THREAD = 65536;
+
+    /**
+     * Constructor
+     * Defaults to one thread per CPU
+     * @param source Catalog to aggregate
+     */
+    explicit GenreAggregator(const TrackCatalog& source);
+
+    /**
+     * Set the number of threads (1 aggregates on the calling thread)
+     * @param count Thread count, clamped to 1..64
+     */
+    void setThreadCount(int count);
+    int getThreadCount() const;
+
+    /**
+     * Aggregate the whole catalog
+     * @return One entry per genre that has tracks, in genre id order
+     */
+    vector<GenreTotals> aggregate() const;
+
+private:
+    const TrackCatalog& catalog;
+    int threadCount;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include "genretable.h"
+#include <string>
+using namespace std;
+
+/**
+ * Name stored for empty genres
+ * (function-local so it is ready even during static initialization)
+ */
+static const string& unknownGenre() {
+    static const string name("Unknown");
+    return name;
+}
+
+/**
+ * Default Constructor
+ */
+GenreTable::GenreTable() : count(0) {
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        chunks[i] = NULL;
+    }
+    pthread_mutex_init(&lock, NULL);
+}
+
+/**
+ * Destructor
+ */
+GenreTable::~GenreTable() {
+    for (int i = 0; i < MAX_CHUNKS; i++) {
+        delete[] chunks[i];
+    }
+    pthread_mutex_destroy(&lock);
+}
+
+/**
+ * Chunk Of
+ * ids 0-15 are in chunk 0, 16-47 in chunk 1, 48-111 in chunk 2, ...
+ */
+int GenreTable::chunkOf(int id) {
+    return 27 - __builtin_clz((unsigned int)id + FIRST_CHUNK);
+}
+
+/**
+ * Slot
+ * Map an id to its place in the chunks
+ */
+string* GenreTable::slot(string* const* chunks, int id) {
+    int chunk = chunkOf(id);
+    return &chunks[chunk][id + FIRST_CHUNK - (FIRST_CHUNK << chunk)];
+}
+
+/**
+ * Intern
+ * Return the existing id of the genre, or add it with the next id
+ */
+int GenreTable::intern(const string& g) {
+    const string& name = g.empty() ? unknownGenre() : g;
+
+    pthread_mutex_lock(&lock);
+    int id;
+    map<string, int>::const_iterator it = ids.find(name);
+    if (it != ids.end()) {
+        id = it->second;
+    } else {
+        id = count;
+        int chunk = chunkOf(id);
+        if (chunks[chunk] == NULL) {
+            chunks[chunk] = new string[FIRST_CHUNK << chunk];
+        }
+        *slot(chunks, id) = name;
+        ids[name] = id;
+        // Readers that see the new count also see the name and its chunk
+        __atomic_store_n(&count, id + 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&lock);
+
+    return id;
+}
+
+/**
+ * Find
+ * Same lookup as intern(), but never adds a genre
+ */
+int GenreTable::find(const string& g) const {
+    const string& name = g.empty() ? unknownGenre() : g;
+
+    pthread_mutex_lock(&lock);
+    int id = -1;
+    map<string, int>::const_iterator it = ids.find(name);
+    if (it != ids.end()) {
+        id = it->second;
+    }
+    pthread_mutex_unlock(&lock);
+
+    return id;
+}
+
+/**
+ * Get Name
+ * Lock-free: a published name is never written again, and the
+ * returned reference stays valid because chunks never move
+ */
+const string& GenreTable::getName(int id) const {
+    static const string empty;
+
+    if (id < 0 || id >= __atomic_load_n(&count, __ATOMIC_ACQUIRE)) {
+        return empty;
+    }
+    return *slot(chunks, id);
+}
+
+int GenreTable::size() const {
+    return __atomic_load_n(&count, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Shared
+ * One table for every MusicTrack in the program
+ */
+GenreTable& GenreTable::shared() {
+    static GenreTable table;
+    return table;
+}
@@ -0,0 +1,91 @@
+#ifndef GENRETABLE_H
+#define GENRETABLE_H
+
+#include <string>
+#include <map>
+#include <pthread.h>
+using namespace std;
+
+/**
+ * GenreTable Class - Maître Gims Studio Management System
+ *
+ * Dictionary of genre names. Each distinct name ("Hip-Hop", "Pop",
+ * "R&B", ...) is stored once and given a small integer id, so a track
+ * only needs to keep an int instead of its own copy of the string.
+ * Comparing or grouping tracks by genre then becomes an int compare.
+ *
+ * Ids are handed out in order of first use (0, 1, 2, ...) and never
+ * change. Names returned by getName() stay valid for the lifetime of
+ * the table. All member functions are thread-safe.
+ *
+ * intern() and find() share a mutex, but getName() and size() take no
+ * lock: names live in chunks that are never moved or freed while the
+ * table exists, and intern() publishes each new name by a release
+ * store of the count only after the name is in place. Resolving ids
+ * on hot paths therefore does not contend with writers.
+ */
+class GenreTable {
+public:
+    /**
+     * Default Constructor
+     * Creates an empty table
+     */
+    GenreTable();
+
+    /**
+     * Destructor
+     */
+    ~GenreTable();
+
+    /**
+     * Get the id of a genre, adding it to the table on first use
+     * @param g Genre name (empty names are stored as "Unknown")
+     * @return Genre id
+     */
+    int intern(const string& g);
+
+    /**
+     * Look up the id of a genre without adding it
+     * @param g Genre name (empty means "Unknown")
+     * @return Genre id, or -1 if the genre is not in the table
+     */
+    int find(const string& g) const;
+
+    /**
+     * Get the name of a genre id
+     * @param id Genre id
+     * @return Genre name, or "" for an invalid id
+     */
+    const string& getName(int id) const;
+
+    /**
+     * Get the number of distinct genres in the table
+     * @return Number of genre ids handed out
+     */
+    int size() const;
+
+    /**
+     * Get the table shared by all MusicTrack objects
+     * @return Process-wide genre table
+     */
+    static GenreTable& shared();
+
+private:
+    // Chunk k holds FIRST_CHUNK << k names, so ids never need to move
+    static const int FIRST_CHUNK = 16;
+    static const int MAX_CHUNKS = 26;
+
+    string* chunks[MAX_CHUNKS];  // allocated on first use, never moved
+    int count;                   // names published; read lock-free
+    map<string, int> ids;        // name -> id, guarded by lock
+    mutable pthread_mutex_t lock;
+
+    static int chunkOf(int id);
+    static string* slot(string* const* chunks, int id);
+
+    // A table owns a mutex - disable copying
+    GenreTable(const GenreTable&);
+    GenreTable& operator=(const GenreTable&);
+};
+
+#endif
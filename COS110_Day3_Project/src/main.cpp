@@ -1,6 +1,9 @@
 #include <iostream>
 #include <string>
+#include <unistd.h>
 #include "musictrack.h"
+#include "trackreport.h"
+#include "seedcatalog.h"
 
 using namespace std;
 
@@ -11,45 +14,46 @@ using namespace std;
  * for some of Gims' most popular songs and testing various functionality.
  */
 
-void displayTrackInfo(MusicTrack& track) {
-    cout << "🎵 Track: " << track.getTitle() << endl;
-    cout << "   Duration: " << track.getFormattedDuration()
-         << " (" << track.getDuration() << " seconds)" << endl;
-    cout << "   Genre: " << track.getGenre() << endl;
-    cout << "   Play Count: " << track.getPlayCount() << endl;
-    cout << "   Popular: " << (track.isPopular() ? "Yes" : "No") << endl;
-    cout << endl;
+void displayTrackInfo(TrackReportWriter& report, const MusicTrack& track) {
+    // Buffered with the rest of the listing; the caller flushes it
+    report.writeTrack(track);
 }
 
 int main() {
     cout << "🎤 Welcome to Maître Gims' Music Studio Management System!" << endl;
     cout << "=====================================================" << endl << endl;
 
+    // One writer for every listing: each listing goes out in a single
+    // write() after the cout text before it (endl has flushed that)
+    TrackReportWriter report(STDOUT_FILENO);
+
     // Test default constructor with "Bella"
     cout << "📀 Creating default track (should be 'Bella')..." << endl;
     MusicTrack defaultTrack;
-    displayTrackInfo(defaultTrack);
+    displayTrackInfo(report, defaultTrack);
+    report.flush();
 
     // Test parameterized constructor with Gims' hit songs
     cout << "🎵 Creating Maître Gims' greatest hits catalog..." << endl << endl;
 
-    // Create tracks for Gims' popular songs
-    MusicTrack bella("Bella", 206, "Hip-Hop");  // 3:26
-    MusicTrack estCeQueTuMAimes("Est-ce que tu m'aimes", 234, "Pop");  // 3:54
-    MusicTrack toutDonner("Tout donner", 198, "Hip-Hop");  // 3:18
-    MusicTrack ouAller("Où aller", 267, "R&B");  // 4:27
-    MusicTrack zombie("Zombie", 223, "Hip-Hop");  // 3:43
-    MusicTrack jMeTire("J'me tire", 205, "Hip-Hop");  // 3:25
+    // Create tracks for Gims' popular songs from the built-in seed catalog
+    MusicTrack bella(GIMS_SEED_TRACKS[0]);  // "Bella", 3:26
+    MusicTrack estCeQueTuMAimes(GIMS_SEED_TRACKS[1]);  // "Est-ce que tu m'aimes", 3:54
+    MusicTrack toutDonner(GIMS_SEED_TRACKS[2]);  // "Tout donner", 3:18
+    MusicTrack ouAller(GIMS_SEED_TRACKS[3]);  // "Où aller", 4:27
+    MusicTrack zombie(GIMS_SEED_TRACKS[4]);  // "Zombie", 3:43
+    MusicTrack jMeTire(GIMS_SEED_TRACKS[5]);  // "J'me tire", 3:25
 
     // Display initial catalog
     cout << "📚 Initial Catalog:" << endl;
     cout << "==================" << endl;
-    displayTrackInfo(bella);
-    displayTrackInfo(estCeQueTuMAimes);
-    displayTrackInfo(toutDonner);
-    displayTrackInfo(ouAller);
-    displayTrackInfo(zombie);
-    displayTrackInfo(jMeTire);
+    displayTrackInfo(report, bella);
+    displayTrackInfo(report, estCeQueTuMAimes);
+    displayTrackInfo(report, toutDonner);
+    displayTrackInfo(report, ouAller);
+    displayTrackInfo(report, zombie);
+    displayTrackInfo(report, jMeTire);
+    report.flush();
 
     // Simulate some plays - make Bella popular!
     cout << "🔥 Simulating streaming success for 'Bella'..." << endl;
@@ -69,10 +73,11 @@ int main() {
 
     cout << endl << "📊 Updated Catalog with Play Counts:" << endl;
     cout << "====================================" << endl;
-    displayTrackInfo(bella);
-    displayTrackInfo(estCeQueTuMAimes);
-    displayTrackInfo(toutDonner);
-    displayTrackInfo(jMeTire);
+    displayTrackInfo(report, bella);
+    displayTrackInfo(report, estCeQueTuMAimes);
+    displayTrackInfo(report, toutDonner);
+    displayTrackInfo(report, jMeTire);
+    report.flush();
 
     // Test validation by trying to set invalid values
     cout << "🧪 Testing input validation..." << endl;
@@ -1,7 +1,9 @@
 #include "musictrack.h"
+#include "durationformat.h"
+#include "genretable.h"
+#include "seedcatalog.h"
 #include <string>
 #include <iostream>
-#include <sstream>
 using namespace std;
 
 /**
@@ -12,11 +14,15 @@ using namespace std;
  * @param g Genre (defaults to "Unknown" if empty)
  */
 MusicTrack::MusicTrack(string t, int d, string g) {
-    // Validate and set title
+    titleArena = NULL;
+    titleHandle.offset = 0;
+    titleHandle.length = 0;
+
+    // Validate and set title (swap takes over t's buffer instead of copying)
     if (t.empty()) {
         title = "Untitled Track";
     } else {
-        title = t;
+        title.swap(t);
     }
 
     // Validate and set duration
@@ -26,31 +32,165 @@ MusicTrack::MusicTrack(string t, int d, string g) {
         duration = d;
     }
 
-    // Validate and set genre
-    if (g.empty()) {
-        genre = "Unknown";
-    } else {
-        genre = g;
+    // Validate and set genre (empty names are interned as "Unknown")
+    genreId = GenreTable::shared().intern(g);
+
+    playCount = 0;
+}
+
+/**
+ * Parameterized Constructor (arena title storage)
+ * Same validation, but the title bytes go into the shared arena
+ */
+MusicTrack::MusicTrack(TitleArena& arena, string t, int d, string g) {
+    if (t.empty()) {
+        t = "Untitled Track";
     }
+    titleArena = &arena;
+    titleHandle = arena.append(t);
+    setDuration(d);
+    setGenre(g);
+    playCount = 0;
+}
 
+MusicTrack::MusicTrack(TitleArena& arena, TitleHandle storedTitle, int d, string g) {
+    titleArena = &arena;
+    titleHandle = storedTitle;
+    setDuration(d);
+    setGenre(g);
     playCount = 0;
 }
 
+MusicTrack::MusicTrack(TitleArena& arena, TitleHandle storedTitle, const MusicTrack& source) {
+    titleArena = &arena;
+    titleHandle = storedTitle;
+    duration = source.duration;
+    genreId = source.genreId;
+    playCount = source.getPlayCount();
+}
+
+/**
+ * Seed Constructor
+ * Seed entries are checked when they are declared, but an entry built
+ * by hand still gets the usual defaults
+ */
+MusicTrack::MusicTrack(const SeedTrack& seed) {
+    titleArena = NULL;
+    titleHandle.offset = 0;
+    titleHandle.length = 0;
+    if (seed.titleLength > 0) {
+        title.assign(seed.title, seed.titleLength);
+    } else {
+        title = "Untitled Track";
+    }
+    duration = (seed.duration > 0) ? seed.duration : 180;
+    genreId = GenreTable::shared().intern(string(seed.genre, seed.genreLength > 0 ? seed.genreLength : 0));
+    playCount = 0;
+}
+
+/**
+ * Copy Constructor
+ * Never shares an arena title: a shallow copy would read whatever the
+ * arena holds at that offset after it is rewound or rewritten
+ */
+MusicTrack::MusicTrack(const MusicTrack& source) {
+    titleArena = NULL;
+    titleHandle.offset = 0;
+    titleHandle.length = 0;
+    int length = 0;
+    const char* text = source.getTitleData(&length);
+    title.assign(text, length);
+    duration = source.duration;
+    genreId = source.genreId;
+    playCount = source.getPlayCount();
+}
+
+MusicTrack& MusicTrack::operator=(const MusicTrack& source) {
+    if (this != &source) {
+        int length = 0;
+        const char* text = source.getTitleData(&length);
+        title.assign(text, length);
+        titleArena = NULL;
+        titleHandle.offset = 0;
+        titleHandle.length = 0;
+        duration = source.duration;
+        genreId = source.genreId;
+        setPlayCount(source.getPlayCount());
+    }
+    return *this;
+}
+
+#if __cplusplus >= 201703L
+MusicTrack::MusicTrack(MusicTrack&& source) noexcept
+    : duration(source.duration), genreId(source.genreId), playCount(source.getPlayCount()),
+      titleArena(NULL) {
+    titleHandle.offset = 0;
+    titleHandle.length = 0;
+    if (source.titleArena != NULL) {
+        title.assign(source.titleArena->data(source.titleHandle), source.titleHandle.length);
+    } else {
+        title.swap(source.title);
+    }
+}
+
+MusicTrack& MusicTrack::operator=(MusicTrack&& source) noexcept {
+    if (this != &source) {
+        if (source.titleArena != NULL) {
+            title.assign(source.titleArena->data(source.titleHandle), source.titleHandle.length);
+        } else {
+            title.swap(source.title);
+        }
+        titleArena = NULL;
+        titleHandle.offset = 0;
+        titleHandle.length = 0;
+        duration = source.duration;
+        genreId = source.genreId;
+        setPlayCount(source.getPlayCount());
+    }
+    return *this;
+}
+#endif
+
+/**
+ * Copy Constructor (arena title storage)
+ * Every copy gets its own bytes, so replacing either title later counts
+ * only that track's bytes as waste
+ */
+MusicTrack::MusicTrack(TitleArena& arena, const MusicTrack& source) {
+    titleArena = &arena;
+    if (source.titleArena != NULL) {
+        titleHandle = arena.append(source.titleArena->data(source.titleHandle), source.titleHandle.length);
+    } else {
+        titleHandle = arena.append(source.title);
+    }
+    duration = source.duration;
+    genreId = source.genreId;
+    playCount = source.playCount;
+}
+
 // TODO: Students need to implement all these functions
 // This file contains starter code and TODOs for student implementation
 
 /**
  * Default Constructor
- * Initialize with Gims' most famous track "Bella" as defaults
+ * Initialize with Gims' most famous track "Bella" as defaults,
+ * taken from the first seed track (seedcatalog.h)
  * - title: "Bella"
  * - duration: 206 (seconds for 3:26)
  * - genre: "Hip-Hop"
  * - playCount: 0
  */
 MusicTrack::MusicTrack() {
-    title = "Bella";
-    duration = 206;
-    genre = "Hip-Hop";
+    const SeedTrack& bella = GIMS_SEED_TRACKS[0];
+    // Looked up once, not on every default construction
+    static const int bellaGenreId = GenreTable::shared().intern(string(bella.genre, bella.genreLength));
+
+    titleArena = NULL;
+    titleHandle.offset = 0;
+    titleHandle.length = 0;
+    title.assign(bella.title, bella.titleLength);
+    duration = bella.duration;
+    genreId = bellaGenreId;
     playCount = 0;
 }
 
@@ -61,9 +201,25 @@ MusicTrack::MusicTrack() {
  * Return the title member variable
  */
 string MusicTrack::getTitle() const {
+    if (titleArena != NULL) {
+        return titleArena->get(titleHandle);
+    }
     return title;
 }
 
+/**
+ * Get Title Data
+ * Point at the stored bytes, wherever they live
+ */
+const char* MusicTrack::getTitleData(int* length) const {
+    if (titleArena != NULL) {
+        *length = titleHandle.length;
+        return titleArena->data(titleHandle);
+    }
+    *length = (int)title.size();
+    return title.data();
+}
+
 /**
  * Get Track Duration
  * Return the duration member variable
@@ -74,10 +230,18 @@ int MusicTrack::getDuration() const {
 
 /**
  * Get Track Genre
- * Return the genre member variable
+ * Resolve the genre id through the shared genre table
+ */
+const string& MusicTrack::getGenre() const {
+    return GenreTable::shared().getName(genreId);
+}
+
+/**
+ * Get Track Genre Id
+ * Return the genreId member variable
  */
-string MusicTrack::getGenre() const {
-    return genre;
+int MusicTrack::getGenreId() const {
+    return genreId;
 }
 
 /**
@@ -85,7 +249,7 @@ string MusicTrack::getGenre() const {
  * Return the playCount member variable
  */
 int MusicTrack::getPlayCount() const {
-    return playCount;
+    return __atomic_load_n(&playCount, __ATOMIC_RELAXED);
 }
 
 // Setter Functions - TODO: Implement all setters
@@ -96,9 +260,13 @@ int MusicTrack::getPlayCount() const {
  */
 void MusicTrack::setTitle(string t) {
     if (t.empty()) {
-        title = "Untitled Track";
+        t = "Untitled Track";
+    }
+
+    if (titleArena != NULL) {
+        titleHandle = titleArena->replace(titleHandle, t);
     } else {
-        title = t;
+        title.swap(t);
     }
 }
 
@@ -119,11 +287,7 @@ void MusicTrack::setDuration(int d) {
  * Set the genre to the provided value with validation
  */
 void MusicTrack::setGenre(string g) {
-    if (g.empty()) {
-        genre = "Unknown";
-    } else {
-        genre = g;
-    }
+    genreId = GenreTable::shared().intern(g);
 }
 
 /**
@@ -132,9 +296,9 @@ void MusicTrack::setGenre(string g) {
  */
 void MusicTrack::setPlayCount(int p) {
     if (p < 0) {
-        playCount = 0;
+        __atomic_store_n(&playCount, 0, __ATOMIC_RELAXED);
     } else {
-        playCount = p;
+        __atomic_store_n(&playCount, p, __ATOMIC_RELAXED);
     }
 }
 
@@ -143,9 +307,11 @@ void MusicTrack::setPlayCount(int p) {
 /**
  * Play the Track
  * Increment play count by 1
+ * Uses an atomic add (GCC builtin, works in C++98) so that several
+ * threads can play the same track without losing plays
  */
 void MusicTrack::play() {
-    playCount++;
+    __atomic_fetch_add(&playCount, 1, __ATOMIC_RELAXED);
 }
 
 /**
@@ -153,7 +319,7 @@ void MusicTrack::play() {
  * Set play count back to 0
  */
 void MusicTrack::resetPlayCount() {
-    playCount = 0;
+    __atomic_store_n(&playCount, 0, __ATOMIC_RELAXED);
 }
 
 /**
@@ -162,19 +328,17 @@ void MusicTrack::resetPlayCount() {
  * Examples: 125 seconds -> "2:05", 61 seconds -> "1:01", 3661 seconds -> "61:01"
  */
 string MusicTrack::getFormattedDuration() const {
-    int minutes = duration / 60;
-    int seconds = duration % 60;
-
-    // Convert integers to strings using stringstream (C++98 compatible)
-    stringstream ss;
-    ss << minutes << ":";
-
-    if (seconds < 10) {
-        ss << "0";
-    }
-    ss << seconds;
+    char buffer[DURATION_TEXT_SIZE];
+    int length = formatDuration(duration, buffer, DURATION_TEXT_SIZE);
+    return string(buffer, length);
+}
 
-    return ss.str();
+/**
+ * Get Formatted Duration (caller-provided buffer)
+ * Same "M:SS" text, written straight into the buffer
+ */
+int MusicTrack::getFormattedDuration(char* buffer, int bufferSize) const {
+    return formatDuration(duration, buffer, bufferSize);
 }
 
 /**
@@ -182,7 +346,36 @@ string MusicTrack::getFormattedDuration() const {
  * Return true if play count > 1,000,000
  */
 bool MusicTrack::isPopular() const {
-    return playCount > 1000000;
+    return getPlayCount() > 1000000;
+}
+
+#if __cplusplus >= 201703L
+/**
+ * Get Title View (C++17)
+ * Point straight at the stored bytes, wherever they live
+ */
+std::string_view MusicTrack::getTitleView() const {
+    if (titleArena != NULL) {
+        return std::string_view(titleArena->data(titleHandle), titleHandle.length);
+    }
+    return title;
+}
+
+/**
+ * Get Genre View (C++17)
+ * Genre names in the shared table never move
+ */
+std::string_view MusicTrack::getGenreView() const {
+    return GenreTable::shared().getName(genreId);
+}
+#endif
+
+/**
+ * Uses Title Arena
+ * Report the title storage policy chosen at construction
+ */
+bool MusicTrack::usesTitleArena() const {
+    return titleArena != NULL;
 }
 
 /*
@@ -2,8 +2,14 @@
 #define MUSICTRACK_H
 
 #include <string>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+#include "titlearena.h"
 using namespace std;
 
+struct SeedTrack;
+
 /**
  * MusicTrack Class - Maître Gims Studio Management System
  *
@@ -18,10 +24,9 @@ using namespace std;
  */
 class MusicTrack {
 public:
-    // Member variables - track information
-    string title;      // Track title (e.g., "Bella", "Sapés Comme Jamais")
+    // Member variables - track information (the title is private, see getTitle())
     int duration;      // Duration in seconds (e.g., 206 for 3:26)
-    string genre;      // Music genre (e.g., "Hip-Hop", "Pop", "Afrobeat")
+    int genreId;       // Music genre id in GenreTable::shared() (e.g., "Hip-Hop", "Pop")
     int playCount;     // Number of times this track has been played
 
     // Default Constructor
@@ -42,6 +47,84 @@ public:
      */
     MusicTrack(string t, int d, string g);
 
+    /**
+     * Parameterized Constructor (arena title storage)
+     * Same as above, but the title is stored in a shared TitleArena
+     * instead of in its own string, and setTitle() writes into the
+     * arena too. The arena must outlive the track.
+     * @param arena Title storage shared with other tracks
+     * @param t Track title
+     * @param d Duration in seconds
+     * @param g Genre of the track
+     * Usage: MusicTrack track3(arena, "Zombie", 223, "Hip-Hop");
+     */
+    MusicTrack(TitleArena& arena, string t, int d, string g);
+
+    /**
+     * Parameterized Constructor (title already stored)
+     * For owners that manage arena space themselves (MusicTrackPool, see
+     * TitleArena::store()); duration and genre are validated as above
+     * @param arena Arena holding the title
+     * @param storedTitle Handle of the title in arena (not empty)
+     * @param d Duration in seconds
+     * @param g Genre of the track
+     */
+    MusicTrack(TitleArena& arena, TitleHandle storedTitle, int d, string g);
+
+    /**
+     * Copy Constructor (title already stored)
+     * Copies every field of source except the title, which the caller
+     * has already stored in arena
+     * @param arena Arena holding the title
+     * @param storedTitle Handle of the title in arena
+     * @param source Track to copy the other fields from
+     */
+    MusicTrack(TitleArena& arena, TitleHandle storedTitle, const MusicTrack& source);
+
+    /**
+     * Seed Constructor
+     * Creates a track from a compile-time seed entry (seedcatalog.h);
+     * only the title is copied, the duration needs no conversion
+     * @param seed Seed entry, e.g. GIMS_SEED_TRACKS[0]
+     * Usage: MusicTrack bella(GIMS_SEED_TRACKS[0]);
+     */
+    explicit MusicTrack(const SeedTrack& seed);
+
+    /**
+     * Copy Constructor
+     * The copy always keeps its title in its own string, even when the
+     * source's title lives in an arena, so it stays valid after that
+     * arena is rewritten or destroyed
+     * @param source Track to copy
+     */
+    MusicTrack(const MusicTrack& source);
+
+    /**
+     * Assignment Operator
+     * Same as the copy constructor: afterwards the title is in this
+     * track's own string
+     * @param source Track to copy
+     * @return This track
+     */
+    MusicTrack& operator=(const MusicTrack& source);
+
+#if __cplusplus >= 201703L
+    // Moves take over a plain title's buffer; arena titles are copied
+    MusicTrack(MusicTrack&& source) noexcept;
+    MusicTrack& operator=(MusicTrack&& source) noexcept;
+#endif
+
+    /**
+     * Copy Constructor (arena title storage)
+     * Copies every field of source, storing the title in arena whichever
+     * storage the source uses; the bytes are copied directly, without a
+     * temporary string. The arena must outlive the track.
+     * @param arena Title storage shared with other tracks
+     * @param source Track to copy
+     * Usage: MusicTrack copy(arena, bella);
+     */
+    MusicTrack(TitleArena& arena, const MusicTrack& source);
+
     // Member Functions - basic operations on track data
 
     /**
@@ -50,6 +133,15 @@ public:
      */
     string getTitle() const;
 
+    /**
+     * Get the stored title bytes without copying them
+     * The pointer is only valid until the title changes (or, for arena
+     * titles, until the next title is added to that arena)
+     * @param length Receives the title length in bytes
+     * @return Pointer to the first byte (not '\0' terminated)
+     */
+    const char* getTitleData(int* length) const;
+
     /**
      * Get the track duration in seconds
      * @return Duration in seconds
@@ -58,9 +150,18 @@ public:
 
     /**
      * Get the track genre
+     * Returns a reference into GenreTable::shared(), so no copy is made
      * @return Current genre of the track
      */
-    string getGenre() const;
+    const string& getGenre() const;
+
+    /**
+     * Get the track genre as an id in GenreTable::shared()
+     * Tracks with the same genre have the same id, so genre filters
+     * can compare ints instead of strings
+     * @return Genre id
+     */
+    int getGenreId() const;
 
     /**
      * Get the current play count
@@ -70,6 +171,8 @@ public:
 
     /**
      * Set the track title
+     * The parameter is swapped into place rather than copied again;
+     * in C++17 builds a temporary argument is moved all the way in
      * @param t New title for the track
      */
     void setTitle(string t);
@@ -82,6 +185,7 @@ public:
 
     /**
      * Set the track genre
+     * The name is interned in GenreTable::shared()
      * @param g New genre for the track
      */
     void setGenre(string g);
@@ -95,6 +199,8 @@ public:
     /**
      * Simulate playing the track
      * Increments play count by 1 each time called
+     * Safe to call from several threads on the same track; for heavy
+     * multi-threaded ingest see ConcurrentPlayCounter (playcounter.h)
      */
     void play();
 
@@ -110,12 +216,50 @@ public:
      */
     string getFormattedDuration() const;
 
+    /**
+     * Write duration formatted as M:SS into a caller-provided buffer
+     * Same text as getFormattedDuration(), but without any heap allocation
+     * @param buffer Output buffer (DURATION_TEXT_SIZE bytes always fit)
+     * @param bufferSize Size of the buffer in bytes
+     * @return Number of characters written, or -1 if the buffer is too small
+     */
+    int getFormattedDuration(char* buffer, int bufferSize) const;
+
     /**
      * Check if track is considered popular
      * A track is popular if it has more than 1,000,000 plays
      * @return true if play count > 1,000,000, false otherwise
      */
     bool isPopular() const;
+
+#if __cplusplus >= 201703L
+    /**
+     * Get the track title without copying it (C++17 build mode)
+     * For arena-backed tracks the view is only valid until the next
+     * title is added to that arena
+     * @return View of the current title
+     */
+    std::string_view getTitleView() const;
+
+    /**
+     * Get the track genre without copying it (C++17 build mode)
+     * @return View of the current genre, valid for the whole program
+     */
+    std::string_view getGenreView() const;
+#endif
+
+    /**
+     * Check which title storage policy the track uses
+     * @return true if the title lives in a TitleArena
+     */
+    bool usesTitleArena() const;
+
+private:
+    // Title storage policy: NULL means the title lives in the title
+    // member, otherwise it lives in this arena at titleHandle
+    string title;      // Track title (e.g., "Bella", "Sapés Comme Jamais")
+    TitleArena* titleArena;
+    TitleHandle titleHandle;
 };
 
 #endif
@@ -124,7 +268,8 @@ public:
  * Implementation Notes for Students:
  *
  * 1. CLASS STRUCTURE: This header defines a simple class with member
- *    variables and member functions all in the public section.
+ *    variables and member functions in the public section; the title
+ *    is private because it can live in a TitleArena instead.
  *
  * 2. MEMBER VARIABLES: The data that each MusicTrack object will contain.
  *    Each object gets its own copy of these variables.
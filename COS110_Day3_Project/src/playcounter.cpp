@@ -0,0 +1,204 @@
+#include "playcounter.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+using namespace std;
+
+/*
+ * All shared counter updates use the GCC __atomic builtins, which are
+ * available in C++98 mode. Relaxed ordering is enough: a play count is
+ * a plain tally and carries no other data with it.
+ */
+
+/**
+ * Constructor
+ * Allocate one cache-line slot per track, with no hot tracks yet
+ */
+ConcurrentPlayCounter::ConcurrentPlayCounter(int initialTrackCount, int requestedStripes)
+    : counters(NULL), stripes(NULL), trackCount(0), stripeCount(requestedStripes) {
+    if (stripeCount < 1) {
+        stripeCount = 1;
+    } else if (stripeCount > MAX_STRIPES) {
+        stripeCount = MAX_STRIPES;
+    }
+    resize(initialTrackCount);
+}
+
+/**
+ * Destructor
+ * Free every stripe block, then the slot arrays
+ */
+ConcurrentPlayCounter::~ConcurrentPlayCounter() {
+    for (int i = 0; i < trackCount; i++) {
+        free(stripes[i]);
+    }
+    free(stripes);
+    free(counters);
+}
+
+/**
+ * Resize
+ * Copy the existing slots into larger arrays; new tracks start at 0
+ */
+void ConcurrentPlayCounter::resize(int newTrackCount) {
+    if (newTrackCount <= trackCount) {
+        return;
+    }
+
+    PaddedCounter* newCounters = allocateCounters(newTrackCount);
+    PaddedCounter** newStripes = (PaddedCounter**)calloc(newTrackCount, sizeof(PaddedCounter*));
+    if (newStripes == NULL) {
+        free(newCounters);
+        throw bad_alloc();
+    }
+
+    if (trackCount > 0) {
+        memcpy(newCounters, counters, trackCount * sizeof(PaddedCounter));
+        memcpy(newStripes, stripes, trackCount * sizeof(PaddedCounter*));
+    }
+    free(counters);
+    free(stripes);
+
+    counters = newCounters;
+    stripes = newStripes;
+    trackCount = newTrackCount;
+}
+
+int ConcurrentPlayCounter::size() const {
+    return trackCount;
+}
+
+int ConcurrentPlayCounter::getStripeCount() const {
+    return stripeCount;
+}
+
+void ConcurrentPlayCounter::play(int id) {
+    addPlays(id, 1);
+}
+
+/**
+ * Add Plays
+ * Hot tracks add to the calling thread's stripe, all others to their
+ * own cache-line slot
+ */
+void ConcurrentPlayCounter::addPlays(int id, int count) {
+    if (id < 0 || id >= trackCount) {
+        return;
+    }
+
+    PaddedCounter* block = __atomic_load_n(&stripes[id], __ATOMIC_ACQUIRE);
+    if (block != NULL) {
+        __atomic_fetch_add(&block[threadStripe() % stripeCount].value, count, __ATOMIC_RELAXED);
+    } else {
+        __atomic_fetch_add(&counters[id].value, count, __ATOMIC_RELAXED);
+    }
+}
+
+/**
+ * Mark Hot
+ * Publish a zeroed stripe block for the track. If two threads race,
+ * the loser frees its block and keeps the winner's.
+ */
+void ConcurrentPlayCounter::markHot(int id) {
+    if (id < 0 || id >= trackCount || isHot(id)) {
+        return;
+    }
+
+    PaddedCounter* block = allocateCounters(stripeCount);
+    PaddedCounter* expected = NULL;
+    if (!__atomic_compare_exchange_n(&stripes[id], &expected, block, false,
+                                     __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        free(block);
+    }
+}
+
+bool ConcurrentPlayCounter::isHot(int id) const {
+    if (id < 0 || id >= trackCount) {
+        return false;
+    }
+    return __atomic_load_n(&stripes[id], __ATOMIC_ACQUIRE) != NULL;
+}
+
+/**
+ * Get Play Count
+ * Merge the main slot and every stripe of the track
+ */
+long long ConcurrentPlayCounter::getPlayCount(int id) const {
+    if (id < 0 || id >= trackCount) {
+        return 0;
+    }
+
+    long long total = __atomic_load_n(&counters[id].value, __ATOMIC_RELAXED);
+    PaddedCounter* block = __atomic_load_n(&stripes[id], __ATOMIC_ACQUIRE);
+    if (block != NULL) {
+        for (int s = 0; s < stripeCount; s++) {
+            total += __atomic_load_n(&block[s].value, __ATOMIC_RELAXED);
+        }
+    }
+    return total;
+}
+
+/**
+ * Take Play Count
+ * Swap every slot of the track with 0 and return what was there
+ */
+long long ConcurrentPlayCounter::takePlayCount(int id) {
+    if (id < 0 || id >= trackCount) {
+        return 0;
+    }
+
+    long long total = __atomic_exchange_n(&counters[id].value, 0LL, __ATOMIC_RELAXED);
+    PaddedCounter* block = __atomic_load_n(&stripes[id], __ATOMIC_ACQUIRE);
+    if (block != NULL) {
+        for (int s = 0; s < stripeCount; s++) {
+            total += __atomic_exchange_n(&block[s].value, 0LL, __ATOMIC_RELAXED);
+        }
+    }
+    return total;
+}
+
+/**
+ * Reset
+ * Zero every slot; hot tracks keep their stripes
+ */
+void ConcurrentPlayCounter::reset() {
+    if (trackCount == 0) {
+        return;
+    }
+    memset(counters, 0, trackCount * sizeof(PaddedCounter));
+    for (int i = 0; i < trackCount; i++) {
+        if (stripes[i] != NULL) {
+            memset(stripes[i], 0, stripeCount * sizeof(PaddedCounter));
+        }
+    }
+}
+
+// Private helpers
+
+/**
+ * Allocate Counters
+ * Zeroed, cache-line aligned array of slots
+ */
+ConcurrentPlayCounter::PaddedCounter* ConcurrentPlayCounter::allocateCounters(int count) {
+    void* memory = NULL;
+    if (posix_memalign(&memory, CACHE_LINE_SIZE, count * sizeof(PaddedCounter)) != 0) {
+        throw bad_alloc();
+    }
+    memset(memory, 0, count * sizeof(PaddedCounter));
+    return (PaddedCounter*)memory;
+}
+
+/**
+ * Thread Stripe
+ * Each thread is assigned a stripe number the first time it plays a
+ * hot track; threads are spread round-robin over the stripes
+ */
+int ConcurrentPlayCounter::threadStripe() {
+    static int nextStripe = 0;
+    static __thread int stripe = -1;
+
+    if (stripe < 0) {
+        stripe = __atomic_fetch_add(&nextStripe, 1, __ATOMIC_RELAXED) & 0x7fffffff;
+    }
+    return stripe;
+}
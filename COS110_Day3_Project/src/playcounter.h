@@ -0,0 +1,128 @@
+#ifndef PLAYCOUNTER_H
+#define PLAYCOUNTER_H
+
+#include <cstddef>
+
+/**
+ * ConcurrentPlayCounter Class - Maître Gims Studio Management System
+ *
+ * Counts plays for many tracks from many threads at once without
+ * losing any updates.
+ *
+ * - Every track gets its own 64-byte (cache line) slot, so two threads
+ *   playing neighbouring tracks never fight over the same cache line.
+ * - A track that receives most of the traffic (a "hot" track, like
+ *   "Bella" on release day) can be given several striped slots. Each
+ *   thread adds to its own stripe and getPlayCount() adds the stripes
+ *   back together when the count is read.
+ *
+ * play(), addPlays(), markHot(), getPlayCount() and takePlayCount()
+ * are safe to call from any thread. resize() and reset() are not and
+ * must only be called while no other thread uses the counter: resize()
+ * frees the old slots, so a play that overlaps it writes to freed
+ * memory. Nothing detects this; callers have to keep the two apart.
+ */
+class ConcurrentPlayCounter {
+public:
+    static const int CACHE_LINE_SIZE = 64;
+    static const int MAX_STRIPES = 64;
+
+    /**
+     * Constructor
+     * @param trackCount Number of track ids to count (0 .. trackCount-1)
+     * @param stripeCount Number of stripes for hot tracks (1 - MAX_STRIPES)
+     */
+    ConcurrentPlayCounter(int trackCount = 0, int stripeCount = 8);
+
+    /**
+     * Destructor
+     * Release the counter slots and all stripe blocks
+     */
+    ~ConcurrentPlayCounter();
+
+    /**
+     * Grow the counter to cover more track ids (not thread-safe)
+     * @param trackCount New number of track ids; never shrinks
+     */
+    void resize(int trackCount);
+
+    /**
+     * Get the number of track ids covered
+     * @return Number of track ids
+     */
+    int size() const;
+
+    /**
+     * Get the number of stripes used for hot tracks
+     * @return Stripe count
+     */
+    int getStripeCount() const;
+
+    /**
+     * Record one play of a track
+     * @param id Track id (ignored if out of range)
+     */
+    void play(int id);
+
+    /**
+     * Record several plays of a track at once
+     * @param id Track id (ignored if out of range)
+     * @param count Number of plays to add
+     */
+    void addPlays(int id, int count);
+
+    /**
+     * Give a track striped counters so heavy concurrent traffic on it
+     * is spread over several cache lines
+     * @param id Track id (ignored if out of range)
+     */
+    void markHot(int id);
+
+    /**
+     * Check whether a track has striped counters
+     * @param id Track id
+     * @return true if markHot() was called for this track
+     */
+    bool isHot(int id) const;
+
+    /**
+     * Get the number of plays counted for a track (all stripes merged)
+     * @param id Track id
+     * @return Number of plays, or 0 for an invalid id
+     */
+    long long getPlayCount(int id) const;
+
+    /**
+     * Read and clear the count of a track in one step. Plays recorded
+     * by other threads at the same time are never lost: they either
+     * end up in the returned value or stay in the counter.
+     * @param id Track id
+     * @return Number of plays removed from the counter
+     */
+    long long takePlayCount(int id);
+
+    /**
+     * Set every count back to zero (not thread-safe)
+     */
+    void reset();
+
+private:
+    struct PaddedCounter {
+        long long value;
+        char padding[CACHE_LINE_SIZE - sizeof(long long)];
+    };
+
+    PaddedCounter* counters;   // one cache line per track
+    PaddedCounter** stripes;   // per track: NULL, or stripeCount cache lines
+    int trackCount;
+    int stripeCount;
+
+    static PaddedCounter* allocateCounters(int count);
+    static int threadStripe();
+
+    // Copying a live counter makes no sense - disable it
+    ConcurrentPlayCounter(const ConcurrentPlayCounter&);
+    ConcurrentPlayCounter& operator=(const ConcurrentPlayCounter&);
+};
+
+#endif
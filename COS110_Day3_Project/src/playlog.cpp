@@ -0,0 +1,560 @@
+#include "playlog.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+using namespace std;
+
+static const char PLAY_LOG_MAGIC[8] = { 'G', 'I', 'M', 'S', 'L', 'O', 'G', '\0' };
+
+// Events handed to applyPlayEvents() at a time during replay
+static const size_t REPLAY_BATCH_EVENTS = 65536;
+
+// Outcomes of reading one frame
+enum FrameResult {
+    FRAME_OK,
+    FRAME_END,    // clean end of the log
+    FRAME_TORN    // short, out of sequence or corrupt - the log ends here
+};
+
+static uint32_t mixWord(uint32_t hash, uint32_t word) {
+    return (hash ^ word) * 16777619u;
+}
+
+/**
+ * Frame Checksum
+ * FNV-1a over 32-bit words: the header fields, then every event
+ */
+static uint32_t frameChecksum(const PlayLogFrameHeader& header, const PlayEvent* events) {
+    uint32_t hash = 2166136261u;
+    hash = mixWord(hash, header.eventCount);
+    hash = mixWord(hash, (uint32_t)header.sequence);
+    hash = mixWord(hash, (uint32_t)(header.sequence >> 32));
+    for (uint32_t i = 0; i < header.eventCount; i++) {
+        hash = mixWord(hash, (uint32_t)events[i].trackId);
+        hash = mixWord(hash, (uint32_t)events[i].count);
+    }
+    return hash;
+}
+
+/**
+ * Read Log Header
+ * @param firstSequence Receives the sequence number of the first frame
+ * @return 1 for a valid header, 0 if the file ends inside the header
+ *         (a log that was never finished), -1 for anything else
+ */
+static int readLogHeader(FILE* file, uint64_t* firstSequence) {
+    PlayLogFileHeader header;
+    size_t got = fread(&header, 1, sizeof(header), file);
+    if (got < sizeof(header)) {
+        return ferror(file) ? -1 : 0;
+    }
+    if (memcmp(header.magic, PLAY_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != PLAY_LOG_VERSION || header.headerSize != sizeof(PlayLogFileHeader)) {
+        return -1;
+    }
+    *firstSequence = header.firstSequence;
+    return 1;
+}
+
+static FrameResult readFrame(FILE* file, uint64_t sequence, vector<PlayEvent>& events) {
+    PlayLogFrameHeader header;
+    size_t got = fread(&header, 1, sizeof(header), file);
+    if (got == 0) {
+        return FRAME_END;
+    }
+    if (got < sizeof(header) || header.sequence != sequence ||
+        header.eventCount == 0 || header.eventCount > (uint32_t)PlayLog::MAX_FRAME_EVENTS) {
+        return FRAME_TORN;
+    }
+
+    events.resize(header.eventCount);
+    if (fread(&events[0], sizeof(PlayEvent), header.eventCount, file) != header.eventCount ||
+        frameChecksum(header, &events[0]) != header.checksum) {
+        return FRAME_TORN;
+    }
+    return FRAME_OK;
+}
+
+static void* runFlusher(void* log) {
+    ((PlayLog*)log)->flushLoop();
+    return NULL;
+}
+
+/**
+ * Write All
+ * Loop over short writes and EINTR
+ */
+static bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+static bool writeLogHeader(int fd, uint64_t firstSequence) {
+    PlayLogFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PLAY_LOG_MAGIC, sizeof(header.magic));
+    header.version = PLAY_LOG_VERSION;
+    header.headerSize = sizeof(PlayLogFileHeader);
+    header.firstSequence = firstSequence;
+    return writeAll(fd, (const char*)&header, sizeof(header));
+}
+
+// PlayLog
+
+PlayLog::PlayLog()
+    : fd(-1), mode(PLAYLOG_GROUP_COMMIT), groupSize(DEFAULT_GROUP_SIZE),
+      groupIntervalMs(DEFAULT_GROUP_INTERVAL_MS), failed(false), nextSequence(1),
+      appendedEvents(0), durableEvents(0), syncCount(0), committing(false), flusherRunning(false), stopping(false) {
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&committed, NULL);
+
+    // The flusher sleeps on the monotonic clock so clock changes do not
+    // stretch or skip an interval
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&flusherWake, &attributes);
+    pthread_condattr_destroy(&attributes);
+}
+
+PlayLog::~PlayLog() {
+    close();
+    pthread_cond_destroy(&committed);
+    pthread_cond_destroy(&flusherWake);
+    pthread_mutex_destroy(&lock);
+}
+
+/**
+ * Open
+ * A new (or never finished) file gets a fresh header; an existing log
+ * is scanned up to its last complete frame and cut there
+ */
+bool PlayLog::open(const string& path, PlayLogDurability durability) {
+    close();
+
+    int newFd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (newFd < 0) {
+        return false;
+    }
+
+    uint64_t sequence = 1;
+    off_t validEnd = 0;
+    FILE* file = fopen(path.c_str(), "rb");
+    int headerState = (file == NULL) ? -1 : readLogHeader(file, &sequence);
+    if (headerState == 1) {
+        vector<PlayEvent> events;
+        validEnd = sizeof(PlayLogFileHeader);
+        while (readFrame(file, sequence, events) == FRAME_OK) {
+            sequence++;
+            validEnd += sizeof(PlayLogFrameHeader) + events.size() * sizeof(PlayEvent);
+        }
+        headerState = ferror(file) ? -1 : 1;
+    }
+    if (file != NULL) {
+        fclose(file);
+    }
+
+    bool ok = headerState >= 0;
+    if (ok && headerState == 0) {
+        validEnd = sizeof(PlayLogFileHeader);
+        ok = ftruncate(newFd, 0) == 0 && writeLogHeader(newFd, 1);
+    }
+    ok = ok && ftruncate(newFd, validEnd) == 0 && lseek(newFd, validEnd, SEEK_SET) == validEnd &&
+         fdatasync(newFd) == 0;
+    if (!ok) {
+        ::close(newFd);
+        return false;
+    }
+
+    pthread_mutex_lock(&lock);
+    fd = newFd;
+    logPath = path;
+    mode = durability;
+    failed = false;
+    pending.clear();
+    nextSequence = sequence;
+    appendedEvents = 0;
+    durableEvents = 0;
+    syncCount = 0;
+    stopping = false;
+    pthread_mutex_unlock(&lock);
+
+    // Without a flusher thread only the group size and sync() commit
+    flusherRunning = pthread_create(&flusher, NULL, runFlusher, this) == 0;
+    return true;
+}
+
+/**
+ * Reset
+ * The empty log is written under a temporary name and renamed over
+ * the old one, so a crash leaves either the old frames or none - and
+ * the frame numbering never goes back
+ */
+bool PlayLog::reset() {
+    pthread_mutex_lock(&lock);
+    while (committing) {
+        pthread_cond_wait(&committed, &lock);
+    }
+    if (fd < 0 || failed) {
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+
+    string tempPath = logPath + ".tmp";
+    int newFd = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    bool ok = newFd >= 0 && writeLogHeader(newFd, nextSequence) && fdatasync(newFd) == 0 &&
+              rename(tempPath.c_str(), logPath.c_str()) == 0;
+    if (ok) {
+        ::close(fd);
+        fd = newFd;
+        pending.clear();
+        durableEvents = appendedEvents;
+    } else {
+        if (newFd >= 0) {
+            ::close(newFd);
+            remove(tempPath.c_str());
+        }
+        failed = true;
+    }
+    pthread_mutex_unlock(&lock);
+    return ok;
+}
+
+uint64_t PlayLog::getLastSequence() const {
+    pthread_mutex_lock(&lock);
+    uint64_t sequence = nextSequence - 1;
+    pthread_mutex_unlock(&lock);
+    return sequence;
+}
+
+bool PlayLog::isOpen() const {
+    pthread_mutex_lock(&lock);
+    bool result = fd >= 0;
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+bool PlayLog::close() {
+    pthread_mutex_lock(&lock);
+    if (fd < 0) {
+        pthread_mutex_unlock(&lock);
+        return true;
+    }
+    stopping = true;
+    pthread_cond_signal(&flusherWake);
+    pthread_mutex_unlock(&lock);
+    if (flusherRunning) {
+        pthread_join(flusher, NULL);
+        flusherRunning = false;
+    }
+
+    pthread_mutex_lock(&lock);
+    waitDurableLocked(appendedEvents);
+    while (committing) {
+        pthread_cond_wait(&committed, &lock);
+    }
+    bool ok = !failed && ::close(fd) == 0;
+    fd = -1;
+    pending.clear();
+    pthread_mutex_unlock(&lock);
+    return ok;
+}
+
+void PlayLog::setDurability(PlayLogDurability durability) {
+    pthread_mutex_lock(&lock);
+    mode = durability;
+    pthread_mutex_unlock(&lock);
+}
+
+PlayLogDurability PlayLog::getDurability() const {
+    pthread_mutex_lock(&lock);
+    PlayLogDurability durability = mode;
+    pthread_mutex_unlock(&lock);
+    return durability;
+}
+
+void PlayLog::setGroupSize(int events) {
+    pthread_mutex_lock(&lock);
+    groupSize = (events < 1) ? 1 : (events > MAX_FRAME_EVENTS ? MAX_FRAME_EVENTS : events);
+    pthread_mutex_unlock(&lock);
+}
+
+int PlayLog::getGroupSize() const {
+    pthread_mutex_lock(&lock);
+    int events = groupSize;
+    pthread_mutex_unlock(&lock);
+    return events;
+}
+
+void PlayLog::setGroupInterval(int milliseconds) {
+    pthread_mutex_lock(&lock);
+    groupIntervalMs = (milliseconds < 0) ? 0 : milliseconds;
+    pthread_cond_signal(&flusherWake);
+    pthread_mutex_unlock(&lock);
+}
+
+int PlayLog::getGroupInterval() const {
+    pthread_mutex_lock(&lock);
+    int milliseconds = groupIntervalMs;
+    pthread_mutex_unlock(&lock);
+    return milliseconds;
+}
+
+bool PlayLog::append(int trackId, int count) {
+    PlayEvent event;
+    event.trackId = trackId;
+    event.count = count;
+    return append(&event, 1);
+}
+
+/**
+ * Append
+ * Queue the events and commit when the group is full (the flusher
+ * thread handles the interval); in PLAYLOG_SYNC_EACH mode wait until
+ * they are durable
+ */
+bool PlayLog::append(const PlayEvent* events, int eventCount) {
+    pthread_mutex_lock(&lock);
+    if (fd < 0 || failed) {
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+    if (pending.empty() && mode != PLAYLOG_SYNC_EACH) {
+        pthread_cond_signal(&flusherWake);   // start the interval for this group
+    }
+    if (eventCount == 1) {
+        pending.push_back(*events);
+        appendedEvents++;
+    } else if (events != NULL && eventCount > 0) {
+        pending.insert(pending.end(), events, events + eventCount);
+        appendedEvents += eventCount;
+    }
+
+    if (mode == PLAYLOG_SYNC_EACH) {
+        waitDurableLocked(appendedEvents);
+    } else if (!committing && (int)pending.size() >= groupSize) {
+        commitLocked(mode == PLAYLOG_GROUP_COMMIT);
+    }
+
+    bool ok = !failed;
+    pthread_mutex_unlock(&lock);
+    return ok;
+}
+
+bool PlayLog::sync() {
+    pthread_mutex_lock(&lock);
+    if (fd >= 0) {
+        waitDurableLocked(appendedEvents);
+    }
+    bool ok = fd >= 0 && !failed;
+    pthread_mutex_unlock(&lock);
+    return ok;
+}
+
+bool PlayLog::hasFailed() const {
+    pthread_mutex_lock(&lock);
+    bool result = failed;
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+long long PlayLog::getEventCount() const {
+    pthread_mutex_lock(&lock);
+    long long count = appendedEvents;
+    pthread_mutex_unlock(&lock);
+    return count;
+}
+
+long long PlayLog::getDurableCount() const {
+    pthread_mutex_lock(&lock);
+    long long count = durableEvents;
+    pthread_mutex_unlock(&lock);
+    return count;
+}
+
+long long PlayLog::getSyncCount() const {
+    pthread_mutex_lock(&lock);
+    long long count = syncCount;
+    pthread_mutex_unlock(&lock);
+    return count;
+}
+
+/**
+ * Replay
+ * Frames are read in order until the end of the log or the first torn
+ * frame; their events are collected into large batches so each track's
+ * count is written once per batch
+ */
+bool PlayLog::replay(const string& path, TrackCatalog& catalog, PlayLogReplay* report,
+                     uint64_t afterSequence) {
+    PlayLogReplay result;
+    memset(&result, 0, sizeof(result));
+    if (report != NULL) {
+        *report = result;
+    }
+    if (catalog.hasPlayLog()) {
+        return false;   // replayed events would be logged a second time
+    }
+
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+        return errno == ENOENT;
+    }
+
+    uint64_t sequence = 1;
+    int headerState = readLogHeader(file, &sequence);
+    bool ok = headerState >= 0;
+    if (headerState == 1) {
+        vector<PlayEvent> frame;
+        vector<PlayEvent> batch;
+        batch.reserve(REPLAY_BATCH_EVENTS);
+
+        FrameResult status;
+        while ((status = readFrame(file, sequence, frame)) == FRAME_OK) {
+            result.lastSequence = sequence++;
+            result.framesRead++;
+            result.eventsRead += frame.size();
+            if (result.lastSequence <= afterSequence) {
+                continue;   // already part of a checkpoint
+            }
+            batch.insert(batch.end(), frame.begin(), frame.end());
+            if (batch.size() >= REPLAY_BATCH_EVENTS) {
+                result.eventsApplied += catalog.applyPlayEvents(&batch[0], (int)batch.size());
+                batch.clear();
+            }
+        }
+        if (!batch.empty()) {
+            result.eventsApplied += catalog.applyPlayEvents(&batch[0], (int)batch.size());
+        }
+        result.truncatedTail = (status == FRAME_TORN);
+        ok = !ferror(file);
+    } else if (headerState == 0) {
+        result.truncatedTail = ftell(file) > 0;
+    }
+    fclose(file);
+
+    if (report != NULL) {
+        *report = result;
+    }
+    return ok;
+}
+
+/**
+ * Flush Loop (flusher thread)
+ * Sleep until a group starts, give it one interval to fill up, then
+ * commit whatever has arrived
+ */
+void PlayLog::flushLoop() {
+    pthread_mutex_lock(&lock);
+    while (!stopping) {
+        if (pending.empty() || groupIntervalMs <= 0 || mode == PLAYLOG_SYNC_EACH) {
+            pthread_cond_wait(&flusherWake, &lock);
+            continue;
+        }
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += groupIntervalMs / 1000;
+        deadline.tv_nsec += (long)(groupIntervalMs % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+        while (!stopping && pthread_cond_timedwait(&flusherWake, &lock, &deadline) != ETIMEDOUT) {
+        }
+
+        if (!stopping && !committing && !failed && !pending.empty()) {
+            commitLocked(mode == PLAYLOG_GROUP_COMMIT);
+        }
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+// Private helpers
+
+/**
+ * Wait Durable (lock held)
+ * Become the committing thread if nobody else is, otherwise wait for
+ * the current commit and check again
+ */
+void PlayLog::waitDurableLocked(long long target) {
+    while (!failed && durableEvents < target) {
+        if (committing) {
+            pthread_cond_wait(&committed, &lock);
+        } else {
+            commitLocked(true);
+        }
+    }
+}
+
+/**
+ * Commit (lock held, no commit in progress)
+ * Take every pending event and write it with the lock released, so
+ * other threads keep appending into the next group meanwhile
+ */
+void PlayLog::commitLocked(bool durable) {
+    committing = true;
+    writing.swap(pending);
+    long long batchEnd = appendedEvents;
+    uint64_t firstSequence = nextSequence;
+    nextSequence += (writing.size() + MAX_FRAME_EVENTS - 1) / MAX_FRAME_EVENTS;
+    pthread_mutex_unlock(&lock);
+
+    bool ok = writeFrames(writing, firstSequence, durable);
+
+    pthread_mutex_lock(&lock);
+    writing.clear();
+    if (!ok) {
+        failed = true;
+    } else if (durable) {
+        durableEvents = batchEnd;
+        syncCount++;
+    }
+    committing = false;
+    pthread_cond_broadcast(&committed);
+}
+
+/**
+ * Write Frames (committing thread only)
+ * Split the batch into frames of at most MAX_FRAME_EVENTS, write them
+ * with one write() each and optionally fdatasync() once at the end
+ */
+bool PlayLog::writeFrames(const vector<PlayEvent>& events, uint64_t sequence, bool durable) {
+    size_t start = 0;
+    while (start < events.size()) {
+        size_t count = events.size() - start;
+        if (count > (size_t)MAX_FRAME_EVENTS) {
+            count = MAX_FRAME_EVENTS;
+        }
+
+        PlayLogFrameHeader header;
+        header.eventCount = (uint32_t)count;
+        header.sequence = sequence++;
+        header.checksum = frameChecksum(header, &events[start]);
+
+        size_t payload = count * sizeof(PlayEvent);
+        frameBuffer.resize(sizeof(header) + payload);
+        memcpy(&frameBuffer[0], &header, sizeof(header));
+        memcpy(&frameBuffer[sizeof(header)], &events[start], payload);
+        if (!writeAll(fd, &frameBuffer[0], frameBuffer.size())) {
+            return false;
+        }
+        start += count;
+    }
+    return !durable || fdatasync(fd) == 0;
+}
@@ -0,0 +1,241 @@
+#ifndef PLAYLOG_H
+#define PLAYLOG_H
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <pthread.h>
+#include "trackcatalog.h"
+using namespace std;
+
+/**
+ * Play Log File - Maître Gims Studio Management System
+ *
+ * On-disk layout (version 2, native byte order):
+ *
+ *   PlayLogFileHeader
+ *   frame, frame, ...
+ *
+ * where each frame is one commit:
+ *
+ *   PlayLogFrameHeader
+ *   PlayEvent events[eventCount]
+ *
+ * Frames are numbered on from firstSequence (1 for a new log; reset()
+ * keeps counting, so a checkpoint can name the last frame it covers)
+ * and carry a checksum of their header fields and events. A crash can
+ * only leave a torn or partly written frame at the very end; readers
+ * stop at the first frame that is short, out of sequence or fails its
+ * checksum.
+ */
+
+const uint32_t PLAY_LOG_VERSION = 2;
+
+struct PlayLogFileHeader {
+    char magic[8];          // "GIMSLOG" + '\0'
+    uint32_t version;       // PLAY_LOG_VERSION
+    uint32_t headerSize;    // sizeof(PlayLogFileHeader)
+    uint64_t firstSequence; // sequence number of the first frame
+};
+
+struct PlayLogFrameHeader {
+    uint32_t eventCount;
+    uint32_t checksum;
+    uint64_t sequence;
+};
+
+/**
+ * How long append() waits before play events are safe on disk
+ */
+enum PlayLogDurability {
+    PLAYLOG_BUFFERED,       // written per group, synced only by sync()/close()
+    PLAYLOG_GROUP_COMMIT,   // one fdatasync() per group
+    PLAYLOG_SYNC_EACH       // append() returns once its events are on disk
+};
+
+/**
+ * What replay() found in a log
+ */
+struct PlayLogReplay {
+    long long framesRead;
+    long long eventsRead;
+    long long eventsApplied;   // events for tracks that exist in the catalog
+    bool truncatedTail;        // a torn frame was found (and ignored) at the end
+    uint64_t lastSequence;     // sequence number of the last complete frame, 0 if none
+};
+
+/**
+ * PlayLog Class - Maître Gims Studio Management System
+ *
+ * Append-only write-ahead log of play events, so play counts survive
+ * a crash. Attached to a TrackCatalog (attachPlayLog()), it records
+ * every play count change as a PlayEvent holding the difference, which
+ * covers play(), setPlayCount(), resetPlayCount(), applyPlayEvents()
+ * and collected concurrent plays.
+ *
+ * Group commit: events are gathered in memory and written as one frame
+ * with one fdatasync() per group, instead of one disk flush per play.
+ * A group is committed when it holds groupSize events, or by a
+ * background flusher thread once it has been open for the group
+ * interval, so a quiet log is still synced within the interval.
+ * In PLAYLOG_SYNC_EACH mode appenders on different threads share
+ * flushes instead: the first waiting thread writes everyone's events
+ * and the others wait for it, so N concurrent appenders cost about
+ * one sync.
+ *
+ * Usage at startup:
+ *   TrackCatalog catalog;                      // load the tracks, same ids as before
+ *   PlayLog::replay("plays.log", catalog);     // rebuild play counts
+ *   PlayLog log;
+ *   log.open("plays.log", PLAYLOG_GROUP_COMMIT);
+ *   catalog.attachPlayLog(&log);
+ *
+ * The log only holds play counts, not tracks, and every change since
+ * it was created: replay into a catalog with the same tracks and the
+ * counts they had when the log was started (normally 0).
+ *
+ * append(), sync() and the getters are thread-safe.
+ */
+class PlayLog {
+public:
+    static const int DEFAULT_GROUP_SIZE = 8192;
+    static const int DEFAULT_GROUP_INTERVAL_MS = 10;
+    static const int MAX_FRAME_EVENTS = 1 << 20;
+
+    PlayLog();
+
+    /**
+     * Destructor
+     * Closes the log, syncing any pending events
+     */
+    ~PlayLog();
+
+    /**
+     * Open a log for appending, creating it if needed.
+     * A torn frame left at the end by a crash is cut off.
+     * @param path Log file
+     * @param durability When appended events are synced
+     * @return true on success; false if the file cannot be opened or
+     *         is not a play log
+     */
+    bool open(const string& path, PlayLogDurability durability = PLAYLOG_GROUP_COMMIT);
+
+    bool isOpen() const;
+
+    /**
+     * Commit pending events and close the file
+     * @return true if every event reached the disk
+     */
+    bool close();
+
+    // Group commit settings - values below 1 (size) or 0 (interval) are clamped
+    void setDurability(PlayLogDurability durability);
+    PlayLogDurability getDurability() const;
+    void setGroupSize(int events);
+    int getGroupSize() const;
+    void setGroupInterval(int milliseconds);
+    int getGroupInterval() const;
+
+    /**
+     * Log one play count change
+     * @param trackId Track id
+     * @param count Plays to add (negative for corrections)
+     * @return false if the log is closed or has failed
+     */
+    bool append(int trackId, int count);
+
+    /**
+     * Log a batch of play events
+     * @param events Events to log (not modified)
+     * @param eventCount Number of events
+     * @return false if the log is closed or has failed
+     */
+    bool append(const PlayEvent* events, int eventCount);
+
+    /**
+     * Write and fdatasync() every pending event, whatever the mode
+     * @return true if the log is healthy
+     */
+    bool sync();
+
+    /**
+     * Check whether a write or sync has failed. A failed log rejects
+     * further events.
+     * @return true after a failure
+     */
+    bool hasFailed() const;
+
+    long long getEventCount() const;     // events appended since open()
+    long long getDurableCount() const;   // of those, events known to be on disk
+    long long getSyncCount() const;      // fdatasync() calls since open()
+
+    /**
+     * Get the sequence number of the newest frame. After sync() every
+     * event appended so far is in a frame up to this number.
+     * @return Last frame sequence number, 0 if none was ever written
+     */
+    uint64_t getLastSequence() const;
+
+    /**
+     * Drop every event, written or pending, once they are covered by
+     * a checkpoint (see checkpoint.h). Frame numbering continues.
+     * @return true on success; a failed reset marks the log failed
+     */
+    bool reset();
+
+    /**
+     * Apply every complete frame of a log to a catalog.
+     * Events are applied in batches through applyPlayEvents(), which
+     * gives the same counts as applying them one by one.
+     * @param path Log file
+     * @param catalog Catalog to update (must not have a play log attached)
+     * @param report Optional statistics about the log
+     * @param afterSequence Skip frames up to this sequence number (the
+     *        ones a checkpoint already covers)
+     * @return true if the log could be read; a missing file is an
+     *         empty log
+     */
+    static bool replay(const string& path, TrackCatalog& catalog, PlayLogReplay* report = NULL,
+                       uint64_t afterSequence = 0);
+
+    /**
+     * Body of the flusher thread (internal)
+     */
+    void flushLoop();
+
+private:
+    int fd;
+    string logPath;
+    PlayLogDurability mode;
+    int groupSize;
+    int groupIntervalMs;
+    bool failed;
+
+    vector<PlayEvent> pending;   // appended, not yet written
+    vector<PlayEvent> writing;   // batch being committed by the leader
+    vector<char> frameBuffer;
+    uint64_t nextSequence;
+    long long appendedEvents;
+    long long durableEvents;
+    long long syncCount;
+    bool committing;             // a thread is writing a batch
+
+    // Commits groups that are still open after groupIntervalMs
+    pthread_t flusher;
+    bool flusherRunning;
+    bool stopping;
+
+    mutable pthread_mutex_t lock;
+    pthread_cond_t committed;
+    pthread_cond_t flusherWake;
+
+    void waitDurableLocked(long long target);
+    void commitLocked(bool durable);
+    bool writeFrames(const vector<PlayEvent>& events, uint64_t sequence, bool durable);
+
+    // A log owns a file descriptor - disable copying
+    PlayLog(const PlayLog&);
+    PlayLog& operator=(const PlayLog&);
+};
+
+#endif
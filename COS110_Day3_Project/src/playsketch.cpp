@@ -0,0 +1,359 @@
+#include "playsketch.h"
+#include <algorithm>
+#include <cmath>
+using namespace std;
+
+/**
+ * Mix Key
+ * 64-bit finalizer (from SplitMix64), so neighbouring ids land on
+ * unrelated counters and registers
+ */
+static uint64_t mixKey(uint64_t key) {
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+static int clampInt(int value, int low, int high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+/**
+ * Order heavy hitters: most plays first, then lower key
+ */
+static bool hitterAhead(const HeavyHitter& a, const HeavyHitter& b) {
+    return a.plays != b.plays ? a.plays > b.plays : a.key < b.key;
+}
+
+// CountMinSketch
+
+CountMinSketch::CountMinSketch(int w, int d) : width(16), depth(clampInt(d, 1, 16)) {
+    int wanted = clampInt(w, 16, 1 << 24);
+    while (width < wanted) {
+        width *= 2;
+    }
+    mask = (uint32_t)width - 1;
+    counters.assign((size_t)width * depth, 0);
+}
+
+int CountMinSketch::getWidth() const {
+    return width;
+}
+
+int CountMinSketch::getDepth() const {
+    return depth;
+}
+
+/**
+ * Add
+ * Row i uses counter (h1 + i * h2) of the key's 64-bit hash, so one
+ * hash serves every row; counters saturate instead of wrapping
+ */
+long long CountMinSketch::add(uint64_t key, int count) {
+    uint64_t hash = mixKey(key);
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+
+    uint32_t smallest = UINT32_MAX;
+    for (int row = 0; row < depth; row++) {
+        uint32_t& counter = counters[(size_t)row * width + ((h1 + row * h2) & mask)];
+        if (count > 0) {
+            counter = (counter > UINT32_MAX - (uint32_t)count) ? UINT32_MAX : counter + (uint32_t)count;
+        }
+        smallest = min(smallest, counter);
+    }
+    return smallest;
+}
+
+long long CountMinSketch::estimate(uint64_t key) const {
+    uint64_t hash = mixKey(key);
+    uint32_t h1 = (uint32_t)hash;
+    uint32_t h2 = (uint32_t)(hash >> 32) | 1;
+
+    uint32_t smallest = UINT32_MAX;
+    for (int row = 0; row < depth; row++) {
+        smallest = min(smallest, counters[(size_t)row * width + ((h1 + row * h2) & mask)]);
+    }
+    return smallest;
+}
+
+bool CountMinSketch::merge(const CountMinSketch& other) {
+    if (other.width != width || other.depth != depth) {
+        return false;
+    }
+    for (size_t i = 0; i < counters.size(); i++) {
+        uint32_t added = other.counters[i];
+        counters[i] = (counters[i] > UINT32_MAX - added) ? UINT32_MAX : counters[i] + added;
+    }
+    return true;
+}
+
+void CountMinSketch::clear() {
+    fill(counters.begin(), counters.end(), 0);
+}
+
+size_t CountMinSketch::memoryBytes() const {
+    return counters.size() * sizeof(uint32_t);
+}
+
+// HyperLogLog
+
+HyperLogLog::HyperLogLog(int p) : precision(clampInt(p, 4, 16)), registers((size_t)1 << precision, 0) {
+}
+
+int HyperLogLog::getPrecision() const {
+    return precision;
+}
+
+/**
+ * Add
+ * The top bits pick a register, which keeps the longest run of
+ * leading zeros seen in the remaining bits (plus one)
+ */
+void HyperLogLog::add(uint64_t item) {
+    uint64_t hash = mixKey(item);
+    size_t index = (size_t)(hash >> (64 - precision));
+    // The marker bit stops the count at 64 - precision zeros
+    uint64_t rest = (hash << precision) | ((uint64_t)1 << (precision - 1));
+    uint8_t rank = (uint8_t)(__builtin_clzll(rest) + 1);
+    if (rank > registers[index]) {
+        registers[index] = rank;
+    }
+}
+
+/**
+ * Estimate
+ * Harmonic mean of the registers, with linear counting for small
+ * sets where many registers are still empty
+ */
+long long HyperLogLog::estimate() const {
+    double m = (double)registers.size();
+    double sum = 0.0;
+    int zeros = 0;
+    for (size_t i = 0; i < registers.size(); i++) {
+        sum += ldexp(1.0, -registers[i]);
+        zeros += (registers[i] == 0) ? 1 : 0;
+    }
+
+    double alpha = (precision == 4) ? 0.673 : (precision == 5) ? 0.697 : (precision == 6) ? 0.709
+                                                                                           : 0.7213 / (1.0 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * log(m / zeros);
+    }
+    return (long long)(estimate + 0.5);
+}
+
+bool HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.precision != precision) {
+        return false;
+    }
+    for (size_t i = 0; i < registers.size(); i++) {
+        registers[i] = max(registers[i], other.registers[i]);
+    }
+    return true;
+}
+
+void HyperLogLog::clear() {
+    fill(registers.begin(), registers.end(), 0);
+}
+
+size_t HyperLogLog::memoryBytes() const {
+    return registers.size();
+}
+
+// PlayStreamSketch
+
+PlayStreamSketch::PlayStreamSketch(int width, int depth, int c, int precision)
+    : plays(width, depth), capacity(clampInt(c, 1, 100000)), listenerPrecision(clampInt(precision, 4, 16)),
+      totalPlays(0) {
+}
+
+/**
+ * Record
+ * Update the estimate, then either refresh the key's candidate entry,
+ * add it while there is room, or let it replace the smallest candidate
+ */
+void PlayStreamSketch::record(uint64_t key, uint64_t listener, int count) {
+    if (count <= 0) {
+        return;
+    }
+    totalPlays += count;
+    long long estimate = plays.add(key, count);
+
+    map<uint64_t, int>::iterator found = positions.find(key);
+    if (found != positions.end()) {
+        int index = found->second;
+        heap[index].plays = estimate;
+        listeners[heap[index].slot].add(listener);
+        siftDown(index);
+        return;
+    }
+
+    if ((int)heap.size() < capacity) {
+        Candidate entry = { estimate, key, (int)listeners.size() };
+        listeners.push_back(HyperLogLog(listenerPrecision));
+        listeners.back().add(listener);
+        heap.push_back(entry);
+        positions[key] = (int)heap.size() - 1;
+        siftUp((int)heap.size() - 1);
+        return;
+    }
+
+    if (estimate > heap[0].plays) {
+        positions.erase(heap[0].key);
+        heap[0].plays = estimate;
+        heap[0].key = key;
+        listeners[heap[0].slot].clear();
+        listeners[heap[0].slot].add(listener);
+        positions[key] = 0;
+        siftDown(0);
+    }
+}
+
+long long PlayStreamSketch::estimatePlays(uint64_t key) const {
+    return plays.estimate(key);
+}
+
+long long PlayStreamSketch::estimateListeners(uint64_t key) const {
+    map<uint64_t, int>::const_iterator found = positions.find(key);
+    return found != positions.end() ? listeners[heap[found->second].slot].estimate() : 0;
+}
+
+vector<HeavyHitter> PlayStreamSketch::heavyHitters() const {
+    vector<HeavyHitter> hitters;
+    hitters.reserve(heap.size());
+    for (size_t i = 0; i < heap.size(); i++) {
+        HeavyHitter hitter = { heap[i].key, heap[i].plays, listeners[heap[i].slot].estimate() };
+        hitters.push_back(hitter);
+    }
+    sort(hitters.begin(), hitters.end(), hitterAhead);
+    return hitters;
+}
+
+/**
+ * Merge
+ * Add the counter tables, pool both candidate sets (merging the
+ * listeners of keys both sides track), re-estimate every pooled key
+ * against the merged table and keep the best capacity of them
+ */
+bool PlayStreamSketch::merge(const PlayStreamSketch& other) {
+    if (other.capacity != capacity || other.listenerPrecision != listenerPrecision || !plays.merge(other.plays)) {
+        return false;
+    }
+    totalPlays += other.totalPlays;
+
+    vector<HyperLogLog> pool(listeners);
+    vector<Candidate> pooled(heap);   // slot indexes pool
+    for (size_t i = 0; i < other.heap.size(); i++) {
+        const Candidate& theirs = other.heap[i];
+        map<uint64_t, int>::iterator found = positions.find(theirs.key);
+        if (found != positions.end()) {
+            pool[heap[found->second].slot].merge(other.listeners[theirs.slot]);
+        } else {
+            Candidate entry = { 0, theirs.key, (int)pool.size() };
+            pool.push_back(other.listeners[theirs.slot]);
+            pooled.push_back(entry);
+        }
+    }
+    for (size_t i = 0; i < pooled.size(); i++) {
+        pooled[i].plays = plays.estimate(pooled[i].key);
+    }
+    size_t kept = min(pooled.size(), (size_t)capacity);
+    partial_sort(pooled.begin(), pooled.begin() + kept, pooled.end(), candidateAhead);
+
+    heap.clear();
+    positions.clear();
+    listeners.clear();
+    for (size_t i = 0; i < kept; i++) {
+        listeners.push_back(pool[pooled[i].slot]);
+        pooled[i].slot = (int)i;
+        heap.push_back(pooled[i]);
+        positions[pooled[i].key] = (int)i;
+    }
+    for (int i = (int)heap.size() / 2 - 1; i >= 0; i--) {
+        siftDown(i);
+    }
+    return true;
+}
+
+long long PlayStreamSketch::getTotalPlays() const {
+    return totalPlays;
+}
+
+int PlayStreamSketch::getCapacity() const {
+    return capacity;
+}
+
+void PlayStreamSketch::clear() {
+    plays.clear();
+    heap.clear();
+    positions.clear();
+    listeners.clear();
+    totalPlays = 0;
+}
+
+/**
+ * Memory Bytes
+ * Map nodes are counted as the entry plus three links and a colour
+ */
+size_t PlayStreamSketch::memoryBytes() const {
+    size_t bytes = plays.memoryBytes() + heap.capacity() * sizeof(Candidate);
+    bytes += positions.size() * (sizeof(pair<const uint64_t, int>) + 4 * sizeof(void*));
+    for (size_t i = 0; i < listeners.size(); i++) {
+        bytes += sizeof(HyperLogLog) + listeners[i].memoryBytes();
+    }
+    return bytes;
+}
+
+// Private helpers
+
+bool PlayStreamSketch::candidateAhead(const Candidate& a, const Candidate& b) {
+    return a.plays != b.plays ? a.plays > b.plays : a.key < b.key;
+}
+
+/**
+ * Heap Less
+ * Fewer plays sinks to the top; on a tie the higher key goes first,
+ * matching the order of heavyHitters()
+ */
+bool PlayStreamSketch::heapLess(int a, int b) const {
+    return heap[a].plays != heap[b].plays ? heap[a].plays < heap[b].plays : heap[a].key > heap[b].key;
+}
+
+void PlayStreamSketch::swapEntries(int a, int b) {
+    swap(heap[a], heap[b]);
+    positions[heap[a].key] = a;
+    positions[heap[b].key] = b;
+}
+
+void PlayStreamSketch::siftUp(int index) {
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (!heapLess(index, parent)) {
+            break;
+        }
+        swapEntries(index, parent);
+        index = parent;
+    }
+}
+
+void PlayStreamSketch::siftDown(int index) {
+    int count = (int)heap.size();
+    while (true) {
+        int smallest = index;
+        int left = 2 * index + 1;
+        int right = left + 1;
+        if (left < count && heapLess(left, smallest)) {
+            smallest = left;
+        }
+        if (right < count && heapLess(right, smallest)) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            break;
+        }
+        swapEntries(index, smallest);
+        index = smallest;
+    }
+}
@@ -0,0 +1,229 @@
+#ifndef PLAYSKETCH_H
+#define PLAYSKETCH_H
+
+#include <vector>
+#include <map>
+#include <cstddef>
+#include <stdint.h>
+using namespace std;
+
+/**
+ * CountMinSketch Class - Maître Gims Studio Management System
+ *
+ * Approximate play counts for any number of track keys in a fixed
+ * depth x width table of counters. Each key adds to one counter per
+ * row and its estimate is the smallest of those counters, so an
+ * estimate is never below the true count and is at most about
+ * e / width of all plays above it (with probability 1 - e^-depth).
+ *
+ * Two sketches of the same size merge by adding their tables, so each
+ * ingest thread can count into its own sketch. Not thread-safe.
+ */
+class CountMinSketch {
+public:
+    /**
+     * Constructor
+     * @param width Counters per row, rounded up to a power of two (16 - 2^24)
+     * @param depth Rows (1 - 16)
+     */
+    explicit CountMinSketch(int width = 65536, int depth = 4);
+
+    int getWidth() const;
+    int getDepth() const;
+
+    /**
+     * Count plays of a key
+     * @param key Track key
+     * @param count Number of plays (ignored unless positive)
+     * @return Estimated plays of the key after adding
+     */
+    long long add(uint64_t key, int count);
+
+    /**
+     * Get the estimated plays of a key
+     * @param key Track key
+     * @return Estimate, never below the true count
+     */
+    long long estimate(uint64_t key) const;
+
+    /**
+     * Add another sketch of the same width and depth to this one
+     * @param other Sketch to merge in
+     * @return false if the sizes differ (nothing is merged)
+     */
+    bool merge(const CountMinSketch& other);
+
+    void clear();
+    size_t memoryBytes() const;
+
+private:
+    int width;
+    int depth;
+    uint32_t mask;
+    vector<uint32_t> counters;   // row after row
+};
+
+/**
+ * HyperLogLog Class - Maître Gims Studio Management System
+ *
+ * Estimates how many distinct items (e.g. listener ids) were added,
+ * with 2^precision one-byte registers. The standard error is about
+ * 1.04 / sqrt(2^precision): 3.3% at the default precision of 10,
+ * using 1 KB. Adding an item twice changes nothing, and two sketches
+ * of the same precision merge by keeping the larger register.
+ */
+class HyperLogLog {
+public:
+    /**
+     * Constructor
+     * @param precision Index bits (4 - 16)
+     */
+    explicit HyperLogLog(int precision = 10);
+
+    int getPrecision() const;
+
+    /**
+     * Add an item
+     * @param item Item id; hashed internally
+     */
+    void add(uint64_t item);
+
+    /**
+     * Get the estimated number of distinct items added
+     * @return Estimate
+     */
+    long long estimate() const;
+
+    /**
+     * Keep the larger register of this and another sketch
+     * @param other Sketch with the same precision
+     * @return false if the precisions differ (nothing is merged)
+     */
+    bool merge(const HyperLogLog& other);
+
+    void clear();
+    size_t memoryBytes() const;
+
+private:
+    int precision;
+    vector<uint8_t> registers;
+};
+
+/**
+ * HeavyHitter - a track key that gets many plays
+ */
+struct HeavyHitter {
+    uint64_t key;
+    long long plays;            // Count-Min estimate, never below the true count
+    long long listeners;        // distinct listeners since the key became a candidate
+};
+
+/**
+ * PlayStreamSketch Class - Maître Gims Studio Management System
+ *
+ * Counts a raw play stream in bounded memory, including plays of
+ * tracks that are not in any catalog yet, to find which of them are
+ * worth adding:
+ *
+ * - a CountMinSketch estimates the plays of every key
+ * - a min-heap keeps the `capacity` keys with the highest estimates
+ *   (the heavy-hitter candidates); a key whose estimate beats the
+ *   smallest candidate takes its place
+ * - each candidate has a HyperLogLog of its listener ids
+ *
+ * Memory is fixed by the constructor arguments (see memoryBytes()),
+ * whatever the number of keys. Listeners are only counted while a key
+ * is a candidate, so a key that just came in reports fewer listeners
+ * than it really has.
+ *
+ * Each ingest thread records into its own sketch; merge() then
+ * combines them (same constructor arguments needed):
+ *
+ *   PlayStreamSketch total;
+ *   for each thread sketch: total.merge(sketch);
+ *   vector<HeavyHitter> promote = total.heavyHitters();
+ *
+ * Not thread-safe.
+ */
+class PlayStreamSketch {
+public:
+    /**
+     * Constructor
+     * @param width Count-Min counters per row (see CountMinSketch)
+     * @param depth Count-Min rows
+     * @param capacity Number of heavy-hitter candidates (1 - 100000)
+     * @param listenerPrecision HyperLogLog precision per candidate (4 - 16)
+     */
+    explicit PlayStreamSketch(int width = 65536, int depth = 4, int capacity = 100, int listenerPrecision = 10);
+
+    /**
+     * Record plays of a track by one listener
+     * @param key Track key from the stream
+     * @param listener Listener id
+     * @param count Number of plays (ignored unless positive)
+     */
+    void record(uint64_t key, uint64_t listener, int count = 1);
+
+    /**
+     * Get the estimated plays of any key
+     * @param key Track key
+     * @return Count-Min estimate
+     */
+    long long estimatePlays(uint64_t key) const;
+
+    /**
+     * Get the estimated distinct listeners of a candidate
+     * @param key Track key
+     * @return Estimate, 0 if the key is not a candidate
+     */
+    long long estimateListeners(uint64_t key) const;
+
+    /**
+     * Get the current heavy-hitter candidates
+     * @return Up to capacity keys, most played first (ties: lower key)
+     */
+    vector<HeavyHitter> heavyHitters() const;
+
+    /**
+     * Add another sketch's plays and candidates to this one and keep
+     * the candidates with the highest merged estimates
+     * @param other Sketch built with the same constructor arguments
+     * @return false if the arguments differ (nothing is merged)
+     */
+    bool merge(const PlayStreamSketch& other);
+
+    long long getTotalPlays() const;
+    int getCapacity() const;
+
+    void clear();
+
+    /**
+     * Get the memory used by the counters, candidates and registers
+     * @return Bytes (fixed once all candidates are in use)
+     */
+    size_t memoryBytes() const;
+
+private:
+    // One heap entry per candidate; listeners[slot] holds its listeners
+    struct Candidate {
+        long long plays;
+        uint64_t key;
+        int slot;
+    };
+
+    CountMinSketch plays;
+    int capacity;
+    int listenerPrecision;
+    long long totalPlays;
+    vector<Candidate> heap;          // min-heap on (plays, key)
+    map<uint64_t, int> positions;    // key -> index in heap
+    vector<HyperLogLog> listeners;
+
+    static bool candidateAhead(const Candidate& a, const Candidate& b);
+    bool heapLess(int a, int b) const;
+    void swapEntries(int a, int b);
+    void siftUp(int index);
+    void siftDown(int index);
+};
+
+#endif
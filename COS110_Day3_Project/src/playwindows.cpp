@@ -0,0 +1,174 @@
+#include "playwindows.h"
+#include <algorithm>
+#include <utility>
+#include <time.h>
+using namespace std;
+
+/**
+ * Ring layout inside a slot: ring r holds RING_BUCKETS[r] buckets of
+ * RING_SECONDS[r] seconds, starting at buckets[RING_FIRST[r]]
+ */
+static const uint32_t RING_SECONDS[] = { 15, 15 * 60, 4 * 60 * 60 };
+static const uint32_t RING_BUCKETS[] = { 4, 4, 6 };
+static const int RING_FIRST[] = { 0, 4, 8 };
+
+long long monotonicSeconds() {
+    struct timespec now;
+#ifdef CLOCK_MONOTONIC_COARSE
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+    return (long long)now.tv_sec;
+}
+
+/**
+ * Clamp a clock reading to the 32-bit seconds kept per slot
+ */
+static uint32_t toSecond(long long time) {
+    if (time < 0) {
+        return 0;
+    }
+    return time > (long long)UINT32_MAX ? UINT32_MAX : (uint32_t)time;
+}
+
+/**
+ * Order trend candidates: highest score first, then lower id
+ */
+static bool trendAhead(const pair<long long, int>& a, const pair<long long, int>& b) {
+    return a.first != b.first ? a.first > b.first : a.second < b.second;
+}
+
+PlayWindows::PlayWindows(PlayWindowClock c) : clock(c != NULL ? c : monotonicSeconds) {
+}
+
+void PlayWindows::addTrack() {
+    Slot empty = Slot();
+    slots.push_back(empty);
+}
+
+void PlayWindows::reserve(int trackCount) {
+    if (trackCount > 0) {
+        slots.reserve(trackCount);
+    }
+}
+
+int PlayWindows::size() const {
+    return (int)slots.size();
+}
+
+long long PlayWindows::now() const {
+    return clock();
+}
+
+/**
+ * Record
+ * Move the slot to the current second if needed, then add to the
+ * current bucket of each ring. A clock that went backwards counts
+ * into the newest buckets.
+ */
+void PlayWindows::record(int id, int count, long long time) {
+    if (id < 0 || id >= size() || count <= 0) {
+        return;
+    }
+
+    Slot& slot = slots[id];
+    uint32_t second = toSecond(time);
+    if (second > slot.lastSecond) {
+        advance(slot, second);
+    } else {
+        second = slot.lastSecond;
+    }
+
+    for (int r = 0; r < RING_COUNT; r++) {
+        uint32_t& bucket = slot.buckets[RING_FIRST[r] + (second / RING_SECONDS[r]) % RING_BUCKETS[r]];
+        bucket = (bucket > UINT32_MAX - (uint32_t)count) ? UINT32_MAX : bucket + (uint32_t)count;
+    }
+}
+
+/**
+ * Get Plays
+ * Add up the buckets of the ring that still fall inside the window;
+ * buckets between the last play and now were never written
+ */
+long long PlayWindows::getPlays(int id, PlayWindow window, long long time) const {
+    if (id < 0 || id >= size()) {
+        return 0;
+    }
+
+    const Slot& slot = slots[id];
+    uint32_t second = toSecond(time);
+    if (second < slot.lastSecond) {
+        second = slot.lastSecond;
+    }
+
+    int r = (int)window;
+    uint32_t buckets = RING_BUCKETS[r];
+    uint32_t current = second / RING_SECONDS[r];
+    uint32_t last = slot.lastSecond / RING_SECONDS[r];
+    if (current - last >= buckets) {
+        return 0;
+    }
+
+    long long plays = 0;
+    for (uint32_t back = 0; back < buckets - (current - last); back++) {
+        plays += slot.buckets[RING_FIRST[r] + (last % buckets + buckets - back) % buckets];
+    }
+    return plays;
+}
+
+long long PlayWindows::trendScore(int id, long long time) const {
+    return getPlays(id, PLAY_WINDOW_HOUR, time) - getPlays(id, PLAY_WINDOW_DAY, time) / 24;
+}
+
+/**
+ * Trending Tracks
+ * One pass collects the tracks with a positive score, then only the
+ * best k of them are sorted
+ */
+vector<int> PlayWindows::trendingTracks(int k, long long time) const {
+    vector<int> ids;
+    if (k <= 0) {
+        return ids;
+    }
+
+    vector<pair<long long, int> > candidates;
+    for (int id = 0; id < size(); id++) {
+        long long score = trendScore(id, time);
+        if (score > 0) {
+            candidates.push_back(make_pair(score, id));
+        }
+    }
+
+    size_t wanted = min(candidates.size(), (size_t)k);
+    partial_sort(candidates.begin(), candidates.begin() + wanted, candidates.end(), trendAhead);
+    for (size_t i = 0; i < wanted; i++) {
+        ids.push_back(candidates[i].second);
+    }
+    return ids;
+}
+
+// Private helpers
+
+/**
+ * Advance
+ * Clear the buckets each ring passed since the slot's last play; a
+ * gap as long as the ring clears all of it
+ */
+void PlayWindows::advance(Slot& slot, uint32_t second) {
+    for (int r = 0; r < RING_COUNT; r++) {
+        uint32_t buckets = RING_BUCKETS[r];
+        uint32_t last = slot.lastSecond / RING_SECONDS[r];
+        uint32_t current = second / RING_SECONDS[r];
+        if (current - last >= buckets) {
+            for (uint32_t b = 0; b < buckets; b++) {
+                slot.buckets[RING_FIRST[r] + b] = 0;
+            }
+        } else {
+            for (uint32_t index = last + 1; index <= current; index++) {
+                slot.buckets[RING_FIRST[r] + index % buckets] = 0;
+            }
+        }
+    }
+    slot.lastSecond = second;
+}
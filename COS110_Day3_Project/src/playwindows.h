@@ -0,0 +1,126 @@
+#ifndef PLAYWINDOWS_H
+#define PLAYWINDOWS_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+using namespace std;
+
+/**
+ * Time windows counted by PlayWindows
+ */
+enum PlayWindow {
+    PLAY_WINDOW_MINUTE,     // 4 buckets of 15 seconds
+    PLAY_WINDOW_HOUR,       // 4 buckets of 15 minutes
+    PLAY_WINDOW_DAY         // 6 buckets of 4 hours
+};
+
+/**
+ * Clock for PlayWindows, in whole seconds. Only differences matter,
+ * so any steady clock works; tests pass a fake one.
+ */
+typedef long long (*PlayWindowClock)();
+
+/**
+ * Default clock: coarse monotonic time in seconds (a vDSO call, no
+ * system call)
+ * @return Seconds since an arbitrary fixed point
+ */
+long long monotonicSeconds();
+
+/**
+ * PlayWindows Class - Maître Gims Studio Management System
+ *
+ * Counts each track's plays in the last minute, hour and day next to
+ * its lifetime play count, so "popular now" can be told apart from
+ * "popular years ago".
+ *
+ * Every window is a small ring of time buckets. A track's three rings
+ * and the second of its last play share one 60-byte slot, so memory is
+ * fixed per track and a play touches one cache line: when the second
+ * has not changed it only adds to three buckets; otherwise it first
+ * clears the buckets that went by since the last play. Rings are never
+ * swept in the background, reads skip buckets that are too old.
+ *
+ * A window count is the current bucket plus the previous ones, so
+ * "last hour" covers between 45 and 60 minutes depending on where the
+ * current 15-minute bucket is. Not thread-safe.
+ */
+class PlayWindows {
+public:
+    /**
+     * Constructor
+     * @param clock Time source, or NULL for monotonicSeconds()
+     */
+    explicit PlayWindows(PlayWindowClock clock = NULL);
+
+    /**
+     * Add the next track (id == size()) with no recent plays
+     */
+    void addTrack();
+
+    /**
+     * Reserve slots for a number of tracks
+     * @param trackCount Expected number of tracks
+     */
+    void reserve(int trackCount);
+
+    int size() const;
+
+    /**
+     * Read the clock once, e.g. for a whole batch of record() calls
+     * @return Current time in seconds
+     */
+    long long now() const;
+
+    /**
+     * Count plays of a track
+     * @param id Track id (ignored if invalid)
+     * @param count Number of plays (ignored unless positive)
+     * @param time Time of the plays, from now()
+     */
+    void record(int id, int count, long long time);
+
+    /**
+     * Get the plays of a track in one window
+     * @param id Track id
+     * @param window Window to read
+     * @param time Current time, from now()
+     * @return Plays in the window, 0 for an invalid id
+     */
+    long long getPlays(int id, PlayWindow window, long long time) const;
+
+    /**
+     * Get how fast a track is gaining plays: plays in the last hour
+     * minus its average hour over the last day. Positive means the
+     * track is played more now than over the day.
+     * @param id Track id
+     * @param time Current time, from now()
+     * @return Trend score, 0 for an invalid id
+     */
+    long long trendScore(int id, long long time) const;
+
+    /**
+     * Get the tracks with the highest positive trend score
+     * @param k Number of tracks wanted
+     * @param time Current time, from now()
+     * @return Up to k track ids, fastest rising first (ties: lower id)
+     */
+    vector<int> trendingTracks(int k, long long time) const;
+
+private:
+    static const int RING_COUNT = 3;
+    static const int BUCKET_COUNT = 14;   // 4 + 4 + 6
+
+    struct Slot {
+        uint32_t lastSecond;
+        uint32_t buckets[BUCKET_COUNT];
+    };
+
+    vector<Slot> slots;
+    PlayWindowClock clock;
+
+    void advance(Slot& slot, uint32_t second);
+};
+
+#endif
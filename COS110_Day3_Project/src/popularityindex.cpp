@@ -0,0 +1,304 @@
+#include "popularityindex.h"
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+/**
+ * Treap priority for a track: a well-mixed hash of its id, so the tree
+ * is balanced on average without keeping a random number generator
+ */
+static unsigned int trackPriority(int id) {
+    unsigned int h = (unsigned int)id;
+    h ^= h >> 16;
+    h *= 0x85ebca6bU;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35U;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * (play count, id) pair used to sort tracks for build()
+ */
+struct RankedTrack {
+    int count;
+    int id;
+};
+
+static bool rankedTrackLess(const RankedTrack& a, const RankedTrack& b) {
+    return a.count > b.count || (a.count == b.count && a.id < b.id);
+}
+
+/**
+ * Default Constructor
+ */
+PopularityIndex::PopularityIndex() : root(-1) {
+}
+
+/**
+ * Add Track
+ * Append one node for the next id and insert it into the tree
+ */
+void PopularityIndex::addTrack(int playCount) {
+    int id = size();
+    Node node;
+    node.count = playCount;
+    node.priority = trackPriority(id);
+    nodes.push_back(node);
+    insert(id);
+}
+
+/**
+ * Build
+ * Sort the tracks into rank order, then build the treap left to right
+ * with a stack of the tree's right spine (each node is pushed and
+ * popped once), and finally fill in the subtree sizes bottom-up
+ */
+void PopularityIndex::build(const int* playCounts, int trackCount) {
+    clear();
+    if (playCounts == NULL || trackCount <= 0) {
+        return;
+    }
+
+    vector<RankedTrack> order(trackCount);
+    nodes.resize(trackCount);
+    for (int id = 0; id < trackCount; id++) {
+        order[id].count = playCounts[id];
+        order[id].id = id;
+        nodes[id].count = playCounts[id];
+        nodes[id].left = -1;
+        nodes[id].right = -1;
+        nodes[id].subtreeSize = 1;
+        nodes[id].priority = trackPriority(id);
+    }
+    sort(order.begin(), order.end(), rankedTrackLess);
+
+    vector<int> spine;
+    for (int i = 0; i < trackCount; i++) {
+        int id = order[i].id;
+        int lastPopped = -1;
+        while (!spine.empty() && nodes[spine.back()].priority < nodes[id].priority) {
+            lastPopped = spine.back();
+            spine.pop_back();
+        }
+        nodes[id].left = lastPopped;
+        if (!spine.empty()) {
+            nodes[spine.back()].right = id;
+        }
+        spine.push_back(id);
+    }
+    root = spine.front();
+
+    // Children come before parents in reverse pre-order
+    vector<int> preorder;
+    preorder.reserve(trackCount);
+    vector<int> pending(1, root);
+    while (!pending.empty()) {
+        int node = pending.back();
+        pending.pop_back();
+        preorder.push_back(node);
+        if (nodes[node].left >= 0) {
+            pending.push_back(nodes[node].left);
+        }
+        if (nodes[node].right >= 0) {
+            pending.push_back(nodes[node].right);
+        }
+    }
+    for (int i = trackCount - 1; i >= 0; i--) {
+        refresh(preorder[i]);
+    }
+}
+
+/**
+ * Update
+ * Take the node out, change its key and put it back
+ */
+void PopularityIndex::update(int id, int playCount) {
+    if (id < 0 || id >= size() || nodes[id].count == playCount) {
+        return;
+    }
+    root = erase(root, id);
+    nodes[id].count = playCount;
+    insert(id);
+}
+
+void PopularityIndex::clear() {
+    nodes.clear();
+    root = -1;
+}
+
+int PopularityIndex::size() const {
+    return (int)nodes.size();
+}
+
+int PopularityIndex::getPlayCount(int id) const {
+    return (id >= 0 && id < size()) ? nodes[id].count : 0;
+}
+
+/**
+ * Top Tracks
+ * In-order walk (most played first) that stops after k nodes
+ */
+vector<int> PopularityIndex::topTracks(int k) const {
+    vector<int> result;
+    if (k <= 0) {
+        return result;
+    }
+    if (k > size()) {
+        k = size();
+    }
+    result.reserve(k);
+
+    vector<int> path;
+    int node = root;
+    while ((int)result.size() < k && (node >= 0 || !path.empty())) {
+        while (node >= 0) {
+            path.push_back(node);
+            node = nodes[node].left;
+        }
+        node = path.back();
+        path.pop_back();
+        result.push_back(node);
+        node = nodes[node].right;
+    }
+    return result;
+}
+
+vector<int> PopularityIndex::tracksAbove(int threshold) const {
+    return topTracks(countAbove(threshold));
+}
+
+/**
+ * Count Above
+ * Walk down once; each time a node beats the threshold, it and its
+ * whole left subtree (which rank ahead of it) are counted
+ */
+int PopularityIndex::countAbove(int threshold) const {
+    int total = 0;
+    int node = root;
+    while (node >= 0) {
+        if (nodes[node].count > threshold) {
+            total += sizeOf(nodes[node].left) + 1;
+            node = nodes[node].right;
+        } else {
+            node = nodes[node].left;
+        }
+    }
+    return total;
+}
+
+/**
+ * Rank
+ * Count the nodes that rank ahead of the track on the way down to it
+ */
+int PopularityIndex::rank(int id) const {
+    if (id < 0 || id >= size()) {
+        return 0;
+    }
+
+    int ahead = 0;
+    int node = root;
+    while (node != id) {
+        if (ranksAhead(id, nodes[id].count, node)) {
+            node = nodes[node].left;
+        } else {
+            ahead += sizeOf(nodes[node].left) + 1;
+            node = nodes[node].right;
+        }
+    }
+    return ahead + sizeOf(nodes[id].left) + 1;
+}
+
+// Private helpers
+
+/**
+ * Ranks Ahead
+ * Does a track with this id and count come before otherId?
+ */
+bool PopularityIndex::ranksAhead(int id, int count, int otherId) const {
+    int otherCount = nodes[otherId].count;
+    return count > otherCount || (count == otherCount && id < otherId);
+}
+
+int PopularityIndex::sizeOf(int node) const {
+    return node < 0 ? 0 : nodes[node].subtreeSize;
+}
+
+void PopularityIndex::refresh(int node) {
+    nodes[node].subtreeSize = sizeOf(nodes[node].left) + sizeOf(nodes[node].right) + 1;
+}
+
+/**
+ * Split
+ * Cut a subtree into the nodes that rank ahead of (count, id) and the
+ * nodes that rank behind it
+ */
+void PopularityIndex::split(int node, int count, int id, int& ahead, int& behind) {
+    if (node < 0) {
+        ahead = -1;
+        behind = -1;
+        return;
+    }
+    if (!ranksAhead(id, count, node)) {
+        split(nodes[node].right, count, id, nodes[node].right, behind);
+        ahead = node;
+    } else {
+        split(nodes[node].left, count, id, ahead, nodes[node].left);
+        behind = node;
+    }
+    refresh(node);
+}
+
+/**
+ * Merge
+ * Join two subtrees where every node of the first ranks ahead of
+ * every node of the second
+ */
+int PopularityIndex::merge(int ahead, int behind) {
+    if (ahead < 0) {
+        return behind;
+    }
+    if (behind < 0) {
+        return ahead;
+    }
+    if (nodes[ahead].priority > nodes[behind].priority) {
+        nodes[ahead].right = merge(nodes[ahead].right, behind);
+        refresh(ahead);
+        return ahead;
+    }
+    nodes[behind].left = merge(ahead, nodes[behind].left);
+    refresh(behind);
+    return behind;
+}
+
+void PopularityIndex::insert(int id) {
+    nodes[id].left = -1;
+    nodes[id].right = -1;
+    nodes[id].subtreeSize = 1;
+
+    int ahead = -1;
+    int behind = -1;
+    split(root, nodes[id].count, id, ahead, behind);
+    root = merge(merge(ahead, id), behind);
+}
+
+/**
+ * Erase
+ * Find the node by its key and replace it with its merged children
+ * @return New root of the subtree
+ */
+int PopularityIndex::erase(int node, int id) {
+    if (node < 0) {
+        return -1;
+    }
+    if (node == id) {
+        return merge(nodes[id].left, nodes[id].right);
+    }
+    if (ranksAhead(id, nodes[id].count, node)) {
+        nodes[node].left = erase(nodes[node].left, id);
+    } else {
+        nodes[node].right = erase(nodes[node].right, id);
+    }
+    refresh(node);
+    return node;
+}
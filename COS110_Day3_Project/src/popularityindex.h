@@ -0,0 +1,115 @@
+#ifndef POPULARITYINDEX_H
+#define POPULARITYINDEX_H
+
+#include <vector>
+using namespace std;
+
+/**
+ * PopularityIndex Class - Maître Gims Studio Management System
+ *
+ * Keeps every track of a catalog ordered by play count (most played
+ * first, ties broken by the lower track id) so popularity questions
+ * don't need a full scan:
+ *
+ * - topTracks(k)           O(log n + k)
+ * - tracksAbove(threshold) O(log n + number of results)
+ * - countAbove(threshold)  O(log n)
+ * - rank(id)               O(log n)
+ *
+ * The ordering is a treap (a randomized balanced binary search tree)
+ * stored in one array indexed by track id, so each track is exactly one
+ * node and no per-node memory is allocated. Changing one play count
+ * moves one node in O(log n).
+ *
+ * Track ids are handed out in order by addTrack(), matching the ids of
+ * the catalog that owns the index. Not thread-safe.
+ */
+class PopularityIndex {
+public:
+    /**
+     * Default Constructor
+     * Creates an empty index
+     */
+    PopularityIndex();
+
+    /**
+     * Add the next track (id == size())
+     * @param playCount Current play count of the track
+     */
+    void addTrack(int playCount);
+
+    /**
+     * Replace the whole index in O(n log n) sort + O(n) tree build,
+     * much faster than adding the tracks one at a time
+     * @param playCounts Play count of tracks 0 .. trackCount-1
+     * @param trackCount Number of tracks
+     */
+    void build(const int* playCounts, int trackCount);
+
+    /**
+     * Move a track to the position of its new play count
+     * @param id Track id (ignored if invalid)
+     * @param playCount New play count
+     */
+    void update(int id, int playCount);
+
+    /**
+     * Remove every track
+     */
+    void clear();
+
+    int size() const;
+    int getPlayCount(int id) const;
+
+    /**
+     * Get the most played tracks
+     * @param k Number of tracks wanted
+     * @return Up to k track ids, most played first
+     */
+    vector<int> topTracks(int k) const;
+
+    /**
+     * Get every track with more plays than a threshold
+     * @param threshold Play count to beat (1,000,000 = isPopular())
+     * @return Track ids, most played first
+     */
+    vector<int> tracksAbove(int threshold) const;
+
+    /**
+     * Count the tracks with more plays than a threshold
+     * @param threshold Play count to beat
+     * @return Number of tracks
+     */
+    int countAbove(int threshold) const;
+
+    /**
+     * Get the popularity rank of a track
+     * @param id Track id
+     * @return 1 for the most played track, 0 for an invalid id
+     */
+    int rank(int id) const;
+
+private:
+    // One tree node per track, kept together so a lookup touches one
+    // cache line per level; -1 means "no child"
+    struct Node {
+        int count;
+        int left;
+        int right;
+        int subtreeSize;
+        unsigned int priority;
+    };
+
+    vector<Node> nodes;
+    int root;
+
+    bool ranksAhead(int id, int count, int otherId) const;
+    int sizeOf(int node) const;
+    void refresh(int node);
+    void split(int node, int count, int id, int& ahead, int& behind);
+    int merge(int ahead, int behind);
+    void insert(int id);
+    int erase(int node, int id);
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef SEEDCATALOG_H
+#define SEEDCATALOG_H
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#define SEED_CONSTEXPR constexpr
+#define SEED_CONSTEXPR_FUNCTION constexpr
+#else
+#define SEED_CONSTEXPR const
+#define SEED_CONSTEXPR_FUNCTION inline
+#endif
+
+/**
+ * Seed Catalog - Maître Gims Studio Management System
+ *
+ * A seed catalog is a plain array of SeedTrack entries written out in
+ * the source. Every field is a constant expression (string literal
+ * addresses, sizeof lengths, durations worked out from minutes and
+ * seconds), so the array is part of the binary's read-only data: no
+ * constructor runs at startup and no memory is allocated, however
+ * many tracks it lists. In C++17 builds the array is constexpr and is
+ * checked by static_assert below.
+ *
+ * Tracks are only built when they are needed, from one entry
+ * (MusicTrack(const SeedTrack&)) or from a whole array at once
+ * (TrackCatalog::addSeedTracks()).
+ */
+struct SeedTrack {
+    const char* title;      // static text, titleLength bytes
+    int titleLength;
+    int duration;           // seconds
+    const char* genre;      // static text, genreLength bytes
+    int genreLength;
+
+#if __cplusplus >= 201703L
+    constexpr std::string_view titleView() const {
+        return std::string_view(title, titleLength);
+    }
+    constexpr std::string_view genreView() const {
+        return std::string_view(genre, genreLength);
+    }
+#endif
+};
+
+/**
+ * Declare one seed track from a title literal, a duration in minutes
+ * and seconds, and a genre literal:
+ *   SEED_TRACK("Bella", 3, 26, "Hip-Hop")
+ */
+#define SEED_TRACK(title, minutes, seconds, genre) \
+    { title, (int)sizeof(title) - 1, (minutes) * 60 + (seconds), genre, (int)sizeof(genre) - 1 }
+
+/**
+ * Check that every seed track has a title, a genre and a positive
+ * duration, the values the MusicTrack setters would otherwise replace
+ * @param tracks Seed array
+ * @param count Number of entries
+ * @return true if every entry is valid
+ */
+SEED_CONSTEXPR_FUNCTION bool seedTracksValid(const SeedTrack* tracks, int count) {
+    for (int i = 0; i < count; i++) {
+        if (tracks[i].titleLength <= 0 || tracks[i].duration <= 0 || tracks[i].genreLength <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Gims' greatest hits, the studio's default catalog. The first entry
+ * holds the MusicTrack default values.
+ */
+static SEED_CONSTEXPR SeedTrack GIMS_SEED_TRACKS[] = {
+    SEED_TRACK("Bella", 3, 26, "Hip-Hop"),
+    SEED_TRACK("Est-ce que tu m'aimes", 3, 54, "Pop"),
+    SEED_TRACK("Tout donner", 3, 18, "Hip-Hop"),
+    SEED_TRACK("Où aller", 4, 27, "R&B"),
+    SEED_TRACK("Zombie", 3, 43, "Hip-Hop"),
+    SEED_TRACK("J'me tire", 3, 25, "Hip-Hop")
+};
+
+static SEED_CONSTEXPR int GIMS_SEED_COUNT = (int)(sizeof(GIMS_SEED_TRACKS) / sizeof(GIMS_SEED_TRACKS[0]));
+
+#if __cplusplus >= 201703L
+static_assert(seedTracksValid(GIMS_SEED_TRACKS, GIMS_SEED_COUNT), "every seed track needs a title, genre and duration");
+#endif
+
+#endif
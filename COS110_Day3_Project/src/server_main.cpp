@@ -0,0 +1,70 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <signal.h>
+#include "trackcatalog.h"
+#include "catalogserver.h"
+#include "seedcatalog.h"
+
+using namespace std;
+
+/**
+ * Maître Gims Catalog Server
+ *
+ * Long-running process that serves a catalog to local clients (see
+ * catalogserver.h for the protocol):
+ *
+ *   ./catalog_server [port | socket path] [extra tracks]
+ *
+ * A number listens on 127.0.0.1:<port>, anything else on a Unix socket
+ * (default: port 7070). The catalog holds Gims' greatest hits followed
+ * by the requested number of generated tracks, for load tests.
+ * Ctrl-C or SIGTERM stops the server cleanly.
+ */
+
+static CatalogServer* runningServer = NULL;
+
+static void stopServer(int) {
+    if (runningServer != NULL) {
+        runningServer->stop();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    string where = argc > 1 ? argv[1] : "7070";
+    int extraTracks = argc > 2 ? atoi(argv[2]) : 0;
+    bool tcp = where.find_first_not_of("0123456789") == string::npos;
+
+    TrackCatalog catalog;
+    catalog.reserve(GIMS_SEED_COUNT + (extraTracks > 0 ? extraTracks : 0));
+    catalog.addSeedTracks(GIMS_SEED_TRACKS, GIMS_SEED_COUNT);
+    for (int i = 0; i < extraTracks; i++) {
+        stringstream ss;
+        ss << "Studio Session " << i;
+        catalog.addTrack(ss.str(), 180 + i % 120, i % 2 == 0 ? "Hip-Hop" : "Pop");
+    }
+
+    CatalogServer server(catalog);
+    if (tcp ? !server.listenTcp(atoi(where.c_str())) : !server.listenUnix(where)) {
+        cerr << "❌ Could not listen on " << where << endl;
+        return 1;
+    }
+
+    runningServer = &server;
+    signal(SIGINT, stopServer);
+    signal(SIGTERM, stopServer);
+
+    cout << "🎤 Catalog server with " << catalog.size() << " tracks listening on ";
+    if (tcp) {
+        cout << "127.0.0.1:" << server.getPort() << endl;
+    } else {
+        cout << where << endl;
+    }
+
+    server.run();
+    runningServer = NULL;
+
+    cout << "🎤 Served " << server.requestCount() << " requests. 'Merci beaucoup!' - Maître Gims" << endl;
+    return 0;
+}
@@ -0,0 +1,554 @@
+#include "shardrouter.h"
+#include <algorithm>
+#include <sstream>
+#include <cstdlib>
+using namespace std;
+
+// Requests per pipelined round trip, small enough that a shard never
+// pauses reading while the router is still sending
+static const int MAX_BATCH = 4096;
+static const int MAX_TOP_TRACKS = 1000;
+
+/**
+ * SplitMix64 finalizer: spreads sequential ids over the whole ring
+ */
+static uint64_t mixHash(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * FNV-1a over a node name
+ */
+static uint64_t hashName(const string& name) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < name.size(); i++) {
+        hash ^= (unsigned char)name[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static bool isOk(const string& response) {
+    return response.compare(0, 3, "OK ") == 0;
+}
+
+static long long responseNumber(const string& response) {
+    return strtoll(response.c_str() + 3, NULL, 10);
+}
+
+static string numberText(long long value) {
+    stringstream ss;
+    ss << value;
+    return ss.str();
+}
+
+/**
+ * Tabs and line breaks separate protocol fields, so text is sent with
+ * spaces instead, as the server itself does
+ */
+static string protocolText(const string& text) {
+    string clean = text;
+    for (size_t i = 0; i < clean.size(); i++) {
+        if (clean[i] == '\t' || clean[i] == '\n' || clean[i] == '\r') {
+            clean[i] = ' ';
+        }
+    }
+    return clean;
+}
+
+static bool connectShard(CatalogClient& client, const string& address) {
+    if (address.find('/') != string::npos) {
+        return client.connectUnix(address);
+    }
+    size_t colon = address.rfind(':');
+    if (colon == string::npos) {
+        return client.connectTcp("127.0.0.1", atoi(address.c_str()));
+    }
+    return client.connectTcp(address.substr(0, colon), atoi(address.c_str() + colon + 1));
+}
+
+static bool eventBefore(const PlayEvent& a, const PlayEvent& b) {
+    return a.trackId < b.trackId;
+}
+
+// HashRing
+
+HashRing::HashRing(int virtualNodes) : virtualNodes(virtualNodes > 0 ? virtualNodes : 64) {
+}
+
+void HashRing::addNode(int node, const string& name) {
+    removeNode(node);
+    uint64_t base = hashName(name);
+    for (int v = 0; v < virtualNodes; v++) {
+        points.push_back(make_pair(mixHash(base + (uint64_t)v * 0x9e3779b97f4a7c15ULL), node));
+    }
+    sort(points.begin(), points.end());
+}
+
+void HashRing::removeNode(int node) {
+    size_t kept = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (points[i].second != node) {
+            points[kept++] = points[i];
+        }
+    }
+    points.resize(kept);
+}
+
+/**
+ * Owner
+ * First point at or after the key's position, wrapping at the top
+ */
+int HashRing::owner(uint64_t key) const {
+    if (points.empty()) {
+        return -1;
+    }
+    vector<pair<uint64_t, int> >::const_iterator it =
+        lower_bound(points.begin(), points.end(), make_pair(mixHash(key), -1));
+    if (it == points.end()) {
+        it = points.begin();
+    }
+    return it->second;
+}
+
+int HashRing::nodeCount() const {
+    return (int)(points.size() / virtualNodes);
+}
+
+// Construction and shards
+
+ShardRouter::ShardRouter(int virtualNodes) : ring(virtualNodes), lastMoveCount(0) {
+}
+
+ShardRouter::~ShardRouter() {
+    for (size_t i = 0; i < shards.size(); i++) {
+        delete shards[i];
+    }
+}
+
+int ShardRouter::addShard(const string& address) {
+    Shard* shard = new Shard();
+    shard->address = address;
+    shard->liveTracks = 0;
+    string pong;
+    if (!connectShard(shard->client, address) || !shard->client.call("PING", pong) || pong != "OK PONG") {
+        delete shard;
+        return -1;
+    }
+    int number = (int)shards.size();
+    shards.push_back(shard);
+    ring.addNode(number, address);
+
+    // Only the tracks whose ring owner is now the new shard move
+    vector<int> moving;
+    for (int id = 0; id < (int)locations.size(); id++) {
+        if (ring.owner(id) != locations[id].shard) {
+            moving.push_back(id);
+        }
+    }
+    lastMoveCount = moveTracks(moving);
+    return number;
+}
+
+bool ShardRouter::removeShard(int shard) {
+    if (shard < 0 || shard >= (int)shards.size() || shards[shard] == NULL) {
+        return false;
+    }
+    ring.removeNode(shard);
+    if (ring.nodeCount() == 0 && shards[shard]->liveTracks > 0) {
+        ring.addNode(shard, shards[shard]->address);
+        return false;
+    }
+
+    vector<int> moving;
+    for (int id = 0; id < (int)locations.size(); id++) {
+        if (locations[id].shard == shard) {
+            moving.push_back(id);
+        }
+    }
+    lastMoveCount = moveTracks(moving);
+    if (lastMoveCount < (int)moving.size()) {
+        return false;
+    }
+    delete shards[shard];
+    shards[shard] = NULL;
+    return true;
+}
+
+int ShardRouter::shardCount() const {
+    return ring.nodeCount();
+}
+
+int ShardRouter::getLastMoveCount() const {
+    return lastMoveCount;
+}
+
+// Talking to shards
+
+/**
+ * Exchange
+ * Sends every request to its shard and collects the answers in
+ * request order. Each round queues up to MAX_BATCH requests on all
+ * shards, flushes them together, then reads; shards work on their
+ * share in parallel. A shard that fails leaves its answers empty
+ * while the other shards' answers are still collected, so callers can
+ * tell which requests took effect.
+ * @param targets Shard number for each request
+ * @return false if any shard failed
+ */
+bool ShardRouter::exchange(const vector<int>& targets, const vector<string>& requests, vector<string>& responses) {
+    responses.assign(requests.size(), string());
+    bool ok = true;
+    for (size_t first = 0; first < requests.size(); first += MAX_BATCH) {
+        size_t last = min(requests.size(), first + MAX_BATCH);
+        for (size_t i = first; i < last; i++) {
+            ok = shards[targets[i]]->client.send(requests[i]) && ok;
+        }
+        for (size_t s = 0; s < shards.size(); s++) {
+            if (shards[s] != NULL && shards[s]->client.isConnected()) {
+                ok = shards[s]->client.flush() && ok;
+            }
+        }
+        for (size_t i = first; i < last; i++) {
+            CatalogClient& client = shards[targets[i]]->client;
+            if (!client.isConnected() || !client.receive(responses[i])) {
+                responses[i].clear();
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+/**
+ * Forward
+ * "<command> <id in shard> [argument]" to the track's shard
+ * @param argument Appended when not negative
+ * @return true if the shard answered OK
+ */
+bool ShardRouter::forward(int id, const char* command, long long argument, string& response) {
+    if (!isValidId(id)) {
+        return false;
+    }
+    string request = command;
+    request += ' ';
+    request += numberText(locations[id].localId);
+    if (argument >= 0) {
+        request += ' ';
+        request += numberText(argument);
+    }
+    return shards[locations[id].shard]->client.call(request, response) && isOk(response);
+}
+
+void ShardRouter::recordLocation(int id, int shard, int localId) {
+    Location location = { shard, localId };
+    if (id < (int)locations.size()) {
+        locations[id] = location;
+    } else {
+        locations.push_back(location);
+    }
+    vector<int>& globalIds = shards[shard]->globalIds;
+    if (localId >= (int)globalIds.size()) {
+        globalIds.resize(localId + 1, -1);
+    }
+    globalIds[localId] = id;
+    shards[shard]->liveTracks++;
+}
+
+/**
+ * Move Tracks
+ * Copy each track (TRACK) to its ring owner (ADD with its plays), then
+ * zero the old copy (SET 0), one pipelined round per step and batch.
+ * A track's location only changes once all three steps succeeded; a
+ * copy whose move did not complete is zeroed again by discardCopies().
+ * @return Number of tracks moved, fewer than ids.size() if a shard failed
+ */
+int ShardRouter::moveTracks(const vector<int>& ids) {
+    int moved = 0;
+    for (size_t first = 0; first < ids.size(); first += MAX_BATCH) {
+        size_t last = min(ids.size(), first + MAX_BATCH);
+        vector<int> oldShards;
+        vector<int> newShards;
+        vector<string> requests;
+        vector<string> responses;
+
+        for (size_t i = first; i < last; i++) {
+            oldShards.push_back(locations[ids[i]].shard);
+            newShards.push_back(ring.owner(ids[i]));
+            requests.push_back("TRACK " + numberText(locations[ids[i]].localId));
+        }
+        if (!exchange(oldShards, requests, responses)) {
+            return moved;
+        }
+
+        // "OK <duration> <plays> <genre>\t<title>" becomes "ADD <duration> <plays> <genre>\t<title>"
+        for (size_t i = 0; i < responses.size(); i++) {
+            if (!isOk(responses[i])) {
+                return moved;
+            }
+            requests[i] = "ADD " + responses[i].substr(3);
+        }
+        bool added = exchange(newShards, requests, responses);
+
+        vector<int> newIds(responses.size(), -1);
+        for (size_t i = 0; i < responses.size(); i++) {
+            if (isOk(responses[i])) {
+                newIds[i] = (int)responseNumber(responses[i]);
+            } else {
+                added = false;
+            }
+            requests[i] = "SET " + numberText(locations[ids[first + i]].localId) + " 0";
+        }
+        if (!added) {
+            discardCopies(newShards, newIds);
+            return moved;
+        }
+        bool zeroed = exchange(oldShards, requests, responses);
+
+        // Tracks whose old copy was zeroed have moved, whatever happened to the rest
+        for (size_t i = 0; i < newIds.size(); i++) {
+            if (!isOk(responses[i])) {
+                continue;
+            }
+            int id = ids[first + i];
+            Shard* old = shards[oldShards[i]];
+            old->globalIds[locations[id].localId] = -1;
+            old->liveTracks--;
+            recordLocation(id, newShards[i], newIds[i]);
+            newIds[i] = -1;
+            moved++;
+        }
+        if (!zeroed) {
+            discardCopies(newShards, newIds);
+            return moved;
+        }
+    }
+    return moved;
+}
+
+/**
+ * Discard Copies
+ * Zero the copies left by moves that did not complete, so their plays
+ * are not counted twice, and record them as left-behind copies so
+ * topTracks() asks for enough extra tracks. Best effort: a shard that
+ * cannot be reached keeps its copy, but it cannot be counted either.
+ * @param localIds Copy per target, or -1 for none
+ */
+void ShardRouter::discardCopies(const vector<int>& targets, const vector<int>& localIds) {
+    vector<int> copyShards;
+    vector<string> requests;
+    for (size_t i = 0; i < localIds.size(); i++) {
+        if (localIds[i] < 0) {
+            continue;
+        }
+        vector<int>& globalIds = shards[targets[i]]->globalIds;
+        if (localIds[i] >= (int)globalIds.size()) {
+            globalIds.resize(localIds[i] + 1, -1);
+        }
+        copyShards.push_back(targets[i]);
+        requests.push_back("SET " + numberText(localIds[i]) + " 0");
+    }
+    vector<string> responses;
+    exchange(copyShards, requests, responses);
+}
+
+// Tracks
+
+int ShardRouter::addTrack(const string& t, int d, const string& g) {
+    int id = (int)locations.size();
+    int shard = ring.owner(id);
+    if (shard < 0) {
+        return -1;
+    }
+    // The shard applies the usual defaults to empty text and d <= 0
+    string request = "ADD " + numberText(d > 0 ? d : 0) + " 0 " + protocolText(g) + "\t" + protocolText(t);
+    string response;
+    if (!shards[shard]->client.call(request, response) || !isOk(response)) {
+        return -1;
+    }
+    recordLocation(id, shard, (int)responseNumber(response));
+    return id;
+}
+
+int ShardRouter::size() const {
+    return (int)locations.size();
+}
+
+bool ShardRouter::isValidId(int id) const {
+    return id >= 0 && id < (int)locations.size();
+}
+
+int ShardRouter::getShardOf(int id) const {
+    return isValidId(id) ? locations[id].shard : -1;
+}
+
+bool ShardRouter::play(int id, int count) {
+    string response;
+    return count > 0 && forward(id, "PLAY", count, response);
+}
+
+bool ShardRouter::setPlayCount(int id, int p) {
+    string response;
+    return forward(id, "SET", p > 0 ? p : 0, response);
+}
+
+int ShardRouter::getPlayCount(int id) {
+    string response;
+    return forward(id, "GET", -1, response) ? (int)responseNumber(response) : 0;
+}
+
+bool ShardRouter::isPopular(int id) {
+    string response;
+    return forward(id, "POPULAR", -1, response) && response == "OK 1";
+}
+
+string ShardRouter::getTitle(int id) {
+    string response;
+    return forward(id, "TITLE", -1, response) ? response.substr(3) : "";
+}
+
+/**
+ * Apply Play Events
+ * One PLAY per track with its summed count, grouped into pipelined
+ * rounds across all shards
+ */
+int ShardRouter::applyPlayEvents(PlayEvent* events, int eventCount) {
+    if (events == NULL || eventCount <= 0) {
+        return 0;
+    }
+    sort(events, events + eventCount, eventBefore);
+
+    vector<int> targets;
+    vector<string> requests;
+    int applied = 0;
+    for (int i = 0; i < eventCount;) {
+        int id = events[i].trackId;
+        long long total = 0;
+        int group = 0;
+        for (; i < eventCount && events[i].trackId == id; i++) {
+            total += events[i].count;
+            group++;
+        }
+        if (!isValidId(id) || total <= 0) {
+            continue;
+        }
+        if (total > 0x7fffffffLL) {
+            total = 0x7fffffffLL;
+        }
+        targets.push_back(locations[id].shard);
+        requests.push_back("PLAY " + numberText(locations[id].localId) + " " + numberText(total));
+        applied += group;
+    }
+
+    vector<string> responses;
+    return exchange(targets, requests, responses) ? applied : 0;
+}
+
+// Aggregates
+
+long long ShardRouter::totalPlays() {
+    vector<int> targets;
+    for (size_t s = 0; s < shards.size(); s++) {
+        if (shards[s] != NULL) {
+            targets.push_back((int)s);
+        }
+    }
+    vector<string> requests(targets.size(), "STATS");
+    vector<string> responses;
+    if (!exchange(targets, requests, responses)) {
+        return 0;
+    }
+
+    // "OK <tracks> <total plays> <popular tracks>"
+    long long total = 0;
+    for (size_t i = 0; i < responses.size(); i++) {
+        stringstream fields(responses[i].substr(isOk(responses[i]) ? 3 : 0));
+        long long tracks = 0;
+        long long plays = 0;
+        fields >> tracks >> plays;
+        total += plays;
+    }
+    return total;
+}
+
+int ShardRouter::countPopular() {
+    vector<int> targets;
+    for (size_t s = 0; s < shards.size(); s++) {
+        if (shards[s] != NULL) {
+            targets.push_back((int)s);
+        }
+    }
+    vector<string> requests(targets.size(), "STATS");
+    vector<string> responses;
+    if (!exchange(targets, requests, responses)) {
+        return 0;
+    }
+
+    int popular = 0;
+    for (size_t i = 0; i < responses.size(); i++) {
+        stringstream fields(responses[i].substr(isOk(responses[i]) ? 3 : 0));
+        long long tracks = 0;
+        long long plays = 0;
+        int count = 0;
+        fields >> tracks >> plays >> count;
+        popular += count;
+    }
+    return popular;
+}
+
+/**
+ * Top Tracks
+ * Each shard is asked for k tracks plus one per left-behind copy it
+ * holds, since those may fill its own top; the answers are merged by
+ * play count
+ */
+vector<int> ShardRouter::topTracks(int k) {
+    vector<int> top;
+    if (k <= 0) {
+        return top;
+    }
+    vector<int> targets;
+    vector<string> requests;
+    for (size_t s = 0; s < shards.size(); s++) {
+        if (shards[s] != NULL) {
+            int stale = (int)shards[s]->globalIds.size() - shards[s]->liveTracks;
+            targets.push_back((int)s);
+            requests.push_back("TOP " + numberText(min(k + stale, MAX_TOP_TRACKS)));
+        }
+    }
+    vector<string> responses;
+    if (!exchange(targets, requests, responses)) {
+        return top;
+    }
+
+    // "OK <n> <id>:<plays> ..."; sorted by (-plays, global id)
+    vector<pair<long long, int> > candidates;
+    for (size_t i = 0; i < responses.size(); i++) {
+        if (!isOk(responses[i])) {
+            continue;
+        }
+        const vector<int>& globalIds = shards[targets[i]]->globalIds;
+        stringstream fields(responses[i].substr(3));
+        int count = 0;
+        fields >> count;
+        for (int n = 0; n < count; n++) {
+            int localId = -1;
+            long long plays = 0;
+            char colon;
+            fields >> localId >> colon >> plays;
+            if (localId >= 0 && localId < (int)globalIds.size() && globalIds[localId] >= 0) {
+                candidates.push_back(make_pair(-plays, globalIds[localId]));
+            }
+        }
+    }
+    sort(candidates.begin(), candidates.end());
+    for (size_t i = 0; i < candidates.size() && (int)top.size() < k; i++) {
+        top.push_back(candidates[i].second);
+    }
+    return top;
+}
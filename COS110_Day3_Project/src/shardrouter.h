@@ -0,0 +1,207 @@
+#ifndef SHARDROUTER_H
+#define SHARDROUTER_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdint.h>
+#include "catalogclient.h"
+#include "trackcatalog.h"
+using namespace std;
+
+/**
+ * HashRing Class - Maître Gims Studio Management System
+ *
+ * Consistent hashing: every node is placed at many pseudo-random
+ * points (virtual nodes) on a 64-bit ring, and a key belongs to the
+ * first point at or after its hash. Adding a node only takes over the
+ * keys just before its own points, about 1/N of them, and removing
+ * one only hands its keys to the next points; every other key stays
+ * where it was. A node's points depend only on its name, so a node
+ * that comes back gets the same keys as before.
+ */
+class HashRing {
+public:
+    /**
+     * Constructor
+     * @param virtualNodes Points per node (defaults to 64 if not positive);
+     *        more points spread the keys more evenly
+     */
+    explicit HashRing(int virtualNodes = 64);
+
+    /**
+     * Place a node on the ring
+     * @param node Node number returned by owner()
+     * @param name Name the points are derived from, e.g. an address
+     */
+    void addNode(int node, const string& name);
+
+    /**
+     * Take a node's points off the ring
+     * @param node Node number
+     */
+    void removeNode(int node);
+
+    /**
+     * Find the node a key belongs to
+     * @param key Key, e.g. a track id
+     * @return Node number, or -1 if the ring is empty
+     */
+    int owner(uint64_t key) const;
+
+    int nodeCount() const;
+
+private:
+    int virtualNodes;
+    vector<pair<uint64_t, int> > points;    // sorted by position
+};
+
+/**
+ * ShardRouter Class - Maître Gims Studio Management System
+ *
+ * Spreads one logical catalog over several CatalogServer processes
+ * (shards) and offers the TrackCatalog operations on top of them.
+ *
+ * Tracks get global ids 0, 1, 2, ... from addTrack(). A HashRing over
+ * the global ids picks each track's shard, and the router remembers
+ * the track's id inside that shard, so play(), setPlayCount() and the
+ * lookups are forwarded to one shard as one request. Batches
+ * (applyPlayEvents()) are split per shard and pipelined to all shards
+ * at once. Aggregates (size, total plays, popular tracks, top-K) are
+ * scatter-gathered: asked of every shard in parallel and combined.
+ *
+ * addShard() and removeShard() rebalance by moving only the tracks
+ * whose owner changed on the ring. A move copies the track to its new
+ * shard and sets the old copy's plays to 0 (shards cannot delete), and
+ * the router ignores such left-behind copies in top-K answers; with no
+ * plays they add nothing to the totals.
+ *
+ * The router keeps its id map in memory, so it is the one way into the
+ * shards while it runs. Shard addresses are "port" (127.0.0.1),
+ * "host:port" or a Unix socket path. Calls return false, -1 or empty
+ * values when a shard cannot be reached. Not thread-safe.
+ */
+class ShardRouter {
+public:
+    /**
+     * Constructor
+     * @param virtualNodes Ring points per shard
+     */
+    explicit ShardRouter(int virtualNodes = 64);
+
+    /**
+     * Destructor
+     * Disconnects from every shard; the shard processes keep running
+     */
+    ~ShardRouter();
+
+    /**
+     * Connect a shard and move the tracks it now owns onto it. Tracks
+     * that fail to move stay where they were, and any copy already made
+     * of them is zeroed so its plays are not counted twice.
+     * @param address Shard address
+     * @return Shard number (stable until removed), or -1 if it cannot be reached
+     */
+    int addShard(const string& address);
+
+    /**
+     * Move a shard's tracks to the other shards and disconnect it
+     * @param shard Shard number from addShard()
+     * @return false if the shard is unknown, the last one holding
+     *         tracks, or a move failed
+     */
+    bool removeShard(int shard);
+
+    /**
+     * Get the number of connected shards
+     * @return Shard count
+     */
+    int shardCount() const;
+
+    /**
+     * Get the number of tracks moved by the last addShard()/removeShard(),
+     * including the ones that completed before a shard failed
+     * @return Tracks moved
+     */
+    int getLastMoveCount() const;
+
+    /**
+     * Add a track to the shard that owns its new id
+     * @return Global track id, or -1 if there is no shard or it failed
+     */
+    int addTrack(const string& t, int d, const string& g);
+
+    /**
+     * Get the number of tracks added through the router
+     * @return Number of tracks
+     */
+    int size() const;
+
+    bool isValidId(int id) const;
+
+    /**
+     * Get the shard a track lives on
+     * @param id Global track id
+     * @return Shard number, or -1 for an invalid id
+     */
+    int getShardOf(int id) const;
+
+    // Forwarded to the track's shard - same semantics as TrackCatalog
+    bool play(int id, int count = 1);
+    bool setPlayCount(int id, int p);
+    int getPlayCount(int id);
+    bool isPopular(int id);
+    string getTitle(int id);
+
+    /**
+     * Apply a batch of play events, pipelined to all shards at once.
+     * Events are added up per track first (the buffer is sorted by
+     * id); a track whose total is not positive is skipped, since
+     * shards only take plays.
+     * @param events Events with global track ids (reordered by this call)
+     * @param eventCount Number of events
+     * @return Number of events applied (invalid ids are skipped)
+     */
+    int applyPlayEvents(PlayEvent* events, int eventCount);
+
+    // Scatter-gather aggregates over every shard
+    long long totalPlays();
+    int countPopular();
+
+    /**
+     * Get the most played tracks over all shards
+     * @param k Number of tracks wanted (at most 1000 per shard are considered)
+     * @return Up to k global ids, most played first
+     */
+    vector<int> topTracks(int k);
+
+private:
+    struct Shard {
+        string address;
+        CatalogClient client;
+        vector<int> globalIds;  // by id inside the shard, -1 if not a live track
+        int liveTracks;
+    };
+
+    struct Location {
+        int shard;
+        int localId;
+    };
+
+    HashRing ring;
+    vector<Shard*> shards;      // NULL once removed, so numbers stay stable
+    vector<Location> locations; // by global id
+    int lastMoveCount;
+
+    bool exchange(const vector<int>& targets, const vector<string>& requests, vector<string>& responses);
+    bool forward(int id, const char* command, long long argument, string& response);
+    int moveTracks(const vector<int>& ids);
+    void discardCopies(const vector<int>& targets, const vector<int>& localIds);
+    void recordLocation(int id, int shard, int localId);
+
+    // A router owns its connections - disable copying
+    ShardRouter(const ShardRouter&);
+    ShardRouter& operator=(const ShardRouter&);
+};
+
+#endif
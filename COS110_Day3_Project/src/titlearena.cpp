@@ -0,0 +1,127 @@
+#include "titlearena.h"
+#include <string>
+#include <vector>
+#include <cstring>
+using namespace std;
+
+/**
+ * Constructor
+ */
+TitleArena::TitleArena(size_t initialCapacity) : waste(0) {
+    bytes.reserve(initialCapacity);
+}
+
+/**
+ * Append
+ * Copy the bytes to the end of the buffer; the vector doubles its
+ * capacity when full, so n titles cost O(log n) allocations
+ */
+TitleHandle TitleArena::append(const char* text, int length) {
+    TitleHandle handle;
+    handle.offset = bytes.size();
+    handle.length = (text == NULL || length < 0) ? 0 : length;
+
+    // A title from this buffer is copied by offset, as growing moves it
+    const char* start = bytes.empty() ? NULL : &bytes[0];
+    if (start != NULL && text >= start && text < start + bytes.size()) {
+        size_t textOffset = text - start;
+        bytes.resize(handle.offset + handle.length);
+        memcpy(&bytes[handle.offset], &bytes[textOffset], handle.length);
+    } else {
+        bytes.insert(bytes.end(), text, text + handle.length);
+    }
+    return handle;
+}
+
+TitleHandle TitleArena::append(const string& text) {
+    return append(text.data(), (int)text.size());
+}
+
+TitleHandle TitleArena::replace(TitleHandle old, const string& text) {
+    waste += old.length;
+    return append(text);
+}
+
+/**
+ * Store
+ * Space is only ever grown, so an owner storing titles of varying
+ * length settles on a size that fits them all
+ */
+TitleHandle TitleArena::store(TitleHandle& space, const char* text, int length) {
+    TitleHandle handle;
+    handle.length = (text == NULL || length < 0) ? 0 : length;
+    if (handle.length > space.length) {
+        int room = 16;
+        while (room < handle.length && room < (1 << 30)) {
+            room *= 2;
+        }
+        if (room < handle.length) {
+            room = handle.length;
+        }
+
+        // The text may be another title in this buffer, which is about to move
+        const char* start = bytes.empty() ? NULL : &bytes[0];
+        bool inside = start != NULL && text >= start && text < start + bytes.size();
+        size_t textOffset = inside ? (size_t)(text - start) : 0;
+
+        waste += space.length;
+        space.offset = bytes.size();
+        space.length = room;
+        bytes.resize(bytes.size() + room);
+        if (inside) {
+            text = &bytes[textOffset];
+        }
+    }
+    handle.offset = space.offset;
+    if (handle.length > 0) {
+        memmove(&bytes[handle.offset], text, handle.length);
+    }
+    return handle;
+}
+
+string TitleArena::get(TitleHandle handle) const {
+    if (handle.length <= 0) {
+        return "";
+    }
+    return string(&bytes[handle.offset], handle.length);
+}
+
+const char* TitleArena::data(TitleHandle handle) const {
+    if (handle.length <= 0) {
+        return NULL;
+    }
+    return &bytes[handle.offset];
+}
+
+void TitleArena::reserve(size_t byteCount) {
+    bytes.reserve(byteCount);
+}
+
+size_t TitleArena::bytesUsed() const {
+    return bytes.size();
+}
+
+size_t TitleArena::wastedBytes() const {
+    return waste;
+}
+
+/**
+ * Clear
+ * Release the buffer itself, not just its contents
+ */
+void TitleArena::clear() {
+    vector<char>().swap(bytes);
+    waste = 0;
+}
+
+void TitleArena::rewind() {
+    bytes.clear();
+    waste = 0;
+}
+
+void TitleArena::swap(TitleArena& other) {
+    bytes.swap(other.bytes);
+    size_t otherWaste = other.waste;
+    other.waste = waste;
+    waste = otherWaste;
+}
@@ -0,0 +1,132 @@
+#ifndef TITLEARENA_H
+#define TITLEARENA_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+using namespace std;
+
+/**
+ * TitleHandle - where one title lives inside a TitleArena
+ */
+struct TitleHandle {
+    size_t offset;   // first byte of the title in the arena
+    int length;      // number of bytes
+};
+
+/**
+ * TitleArena Class - Maître Gims Studio Management System
+ *
+ * Append-only storage for track titles. Every title is copied into one
+ * contiguous byte buffer and referred to by an offset/length handle, so
+ * loading millions of titles costs a handful of large buffer growths
+ * instead of one heap allocation per title, and tearing everything down
+ * is a single free.
+ *
+ * Handles stay valid for the lifetime of the arena (until clear()).
+ * Replacing a title appends the new text; the old bytes are left in
+ * place and counted by wastedBytes() until the owner compacts.
+ *
+ * An arena is not thread-safe; share it only between tracks used by
+ * one thread at a time.
+ */
+class TitleArena {
+public:
+    /**
+     * Constructor
+     * @param initialCapacity Number of bytes to reserve up front
+     */
+    TitleArena(size_t initialCapacity = 0);
+
+    /**
+     * Copy a title into the arena
+     * @param text Title bytes (may be a title already in this arena)
+     * @param length Number of bytes
+     * @return Handle to the stored copy
+     */
+    TitleHandle append(const char* text, int length);
+
+    /**
+     * Copy a title into the arena
+     * @param text Title
+     * @return Handle to the stored copy
+     */
+    TitleHandle append(const string& text);
+
+    /**
+     * Replace a title: append the new text and count the old bytes as waste
+     * @param old Handle of the title being replaced
+     * @param text New title
+     * @return Handle to the new title
+     */
+    TitleHandle replace(TitleHandle old, const string& text);
+
+    /**
+     * Store a title in space an owner keeps for it, overwriting what
+     * was there: the title is written in place when it fits, otherwise
+     * new space is appended (the length rounded up to a power of two,
+     * at least 16 bytes) and the old space counted as waste. An owner
+     * that reuses its space this way keeps the arena from growing.
+     * @param space The owner's space ({0, 0} for none yet), updated when it grows
+     * @param text Title bytes (may point into this arena)
+     * @param length Number of bytes
+     * @return Handle to the stored title, inside space
+     */
+    TitleHandle store(TitleHandle& space, const char* text, int length);
+
+    /**
+     * Get a copy of a stored title
+     * @param handle Handle returned by append()
+     * @return Title text
+     */
+    string get(TitleHandle handle) const;
+
+    /**
+     * Get a pointer to a stored title (not '\0' terminated).
+     * The pointer is only valid until the next append().
+     * @param handle Handle returned by append()
+     * @return Pointer to the first byte, or NULL for an empty title
+     */
+    const char* data(TitleHandle handle) const;
+
+    /**
+     * Reserve room for more bytes so a bulk load grows the buffer once
+     * @param bytes Total number of bytes to make room for
+     */
+    void reserve(size_t bytes);
+
+    /**
+     * Get the number of bytes stored, including replaced titles
+     * @return Bytes in use
+     */
+    size_t bytesUsed() const;
+
+    /**
+     * Get the number of bytes taken by titles that were replaced
+     * @return Bytes no longer referenced
+     */
+    size_t wastedBytes() const;
+
+    /**
+     * Drop every title; all handles become invalid
+     */
+    void clear();
+
+    /**
+     * Drop every title but keep the buffer, so refilling the arena
+     * does not grow it again; all handles become invalid
+     */
+    void rewind();
+
+    /**
+     * Exchange the contents of two arenas (used to compact)
+     * @param other Arena to swap with
+     */
+    void swap(TitleArena& other);
+
+private:
+    vector<char> bytes;
+    size_t waste;
+};
+
+#endif
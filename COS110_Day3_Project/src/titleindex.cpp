@@ -0,0 +1,282 @@
+#include "titleindex.h"
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+/**
+ * Compare two (title, id) keys byte by byte
+ * @return <0, 0 or >0 like memcmp
+ */
+static int compareKeys(const char* a, int aLength, int aId, const char* b, int bLength, int bId) {
+    int common = aLength < bLength ? aLength : bLength;
+    int result = common > 0 ? memcmp(a, b, common) : 0;
+    if (result != 0) {
+        return result;
+    }
+    if (aLength != bLength) {
+        return aLength < bLength ? -1 : 1;
+    }
+    return aId < bId ? -1 : (aId > bId ? 1 : 0);
+}
+
+static bool startsWith(const char* text, int length, const char* prefix, int prefixLength) {
+    return length >= prefixLength && (prefixLength == 0 || memcmp(text, prefix, prefixLength) == 0);
+}
+
+/**
+ * Orders track ids by their current title, then by id
+ */
+struct CurrentTitleOrder {
+    const TitleArena* arena;
+    const vector<TitleHandle>* titles;
+
+    bool operator()(int a, int b) const {
+        const TitleHandle& ta = (*titles)[a];
+        const TitleHandle& tb = (*titles)[b];
+        return compareKeys(arena->data(ta), ta.length, a, arena->data(tb), tb.length, b) < 0;
+    }
+};
+
+/**
+ * Constructor
+ * Index every track the owner already has
+ */
+TitleIndex::TitleIndex(const TitleArena& titleArena, const vector<TitleHandle>& titleColumn)
+    : arena(titleArena), titles(titleColumn) {
+    rebuild();
+}
+
+/**
+ * Rebuild
+ * Sort every id by its current title; nothing is pending afterwards
+ */
+void TitleIndex::rebuild() {
+    int trackCount = (int)titles.size();
+    sorted.resize(trackCount);
+    for (int id = 0; id < trackCount; id++) {
+        sorted[id] = id;
+    }
+    CurrentTitleOrder order = { &arena, &titles };
+    sort(sorted.begin(), sorted.end(), order);
+
+    states.assign(trackCount, (unsigned char)IN_SORTED);
+    recent.clear();
+    staleTitles.clear();
+}
+
+void TitleIndex::trackAdded() {
+    int id = (int)states.size();
+    states.push_back((unsigned char)ADDED);
+    insertRecent(id);
+    if (recent.size() > mergeThreshold()) {
+        mergeRecent();
+    }
+}
+
+/**
+ * Title Changing
+ * A track still sorted under its current title keeps that entry as a
+ * tombstone (remembering the title it is sorted under); a track that
+ * is already in the recent array is taken out of it
+ */
+void TitleIndex::titleChanging(int id) {
+    if (id < 0 || id >= (int)states.size()) {
+        return;
+    }
+    if (states[id] == IN_SORTED) {
+        staleTitles[id] = titles[id];
+        states[id] = (unsigned char)RENAMED;
+    } else {
+        eraseRecent(id);
+    }
+}
+
+void TitleIndex::titleChanged(int id) {
+    if (id < 0 || id >= (int)states.size()) {
+        return;
+    }
+    insertRecent(id);
+    if (recent.size() > mergeThreshold()) {
+        mergeRecent();
+    }
+}
+
+/**
+ * Find Exact
+ * Binary search both arrays; in the sorted array, tombstones of renamed
+ * tracks are skipped
+ */
+int TitleIndex::findExact(const char* title, int length) const {
+    if (length < 0 || (title == NULL && length > 0)) {
+        return -1;
+    }
+    int found = -1;
+
+    for (size_t i = lowerBound(sorted, true, title, length, -1); i < sorted.size(); i++) {
+        int id = sorted[i];
+        TitleHandle handle = sortedTitle(id);
+        if (handle.length != length || compareKeys(arena.data(handle), length, 0, title, length, 0) != 0) {
+            break;
+        }
+        if (states[id] == IN_SORTED) {
+            found = id;
+            break;
+        }
+    }
+
+    size_t r = lowerBound(recent, false, title, length, -1);
+    if (r < recent.size()) {
+        int id = recent[r];
+        const TitleHandle& handle = titles[id];
+        if (handle.length == length && compareKeys(arena.data(handle), length, 0, title, length, 0) == 0 &&
+            (found < 0 || id < found)) {
+            found = id;
+        }
+    }
+    return found;
+}
+
+/**
+ * Find Prefix
+ * Walk both arrays from the prefix's position, merging them in title
+ * order, until the titles stop matching or the limit is reached
+ */
+void TitleIndex::findPrefix(const char* prefix, int length, int limit, vector<int>& ids) const {
+    ids.clear();
+    if (limit <= 0 || length < 0 || (prefix == NULL && length > 0)) {
+        return;
+    }
+
+    size_t i = lowerBound(sorted, true, prefix, length, -1);
+    size_t j = lowerBound(recent, false, prefix, length, -1);
+    while ((int)ids.size() < limit) {
+        // Next live entry of the sorted array that still matches
+        while (i < sorted.size() && states[sorted[i]] != IN_SORTED) {
+            TitleHandle stale = sortedTitle(sorted[i]);
+            if (!startsWith(arena.data(stale), stale.length, prefix, length)) {
+                i = sorted.size();
+            } else {
+                i++;
+            }
+        }
+        bool haveSorted = false;
+        if (i < sorted.size()) {
+            const TitleHandle& handle = titles[sorted[i]];
+            haveSorted = startsWith(arena.data(handle), handle.length, prefix, length);
+        }
+        bool haveRecent = false;
+        if (j < recent.size()) {
+            const TitleHandle& handle = titles[recent[j]];
+            haveRecent = startsWith(arena.data(handle), handle.length, prefix, length);
+        }
+
+        if (!haveSorted && !haveRecent) {
+            break;
+        }
+        bool takeSorted = haveSorted;
+        if (haveSorted && haveRecent) {
+            const TitleHandle& a = titles[sorted[i]];
+            const TitleHandle& b = titles[recent[j]];
+            takeSorted = compareKeys(arena.data(a), a.length, sorted[i],
+                                     arena.data(b), b.length, recent[j]) < 0;
+        }
+        if (takeSorted) {
+            ids.push_back(sorted[i++]);
+        } else {
+            ids.push_back(recent[j++]);
+        }
+    }
+}
+
+int TitleIndex::pendingCount() const {
+    return (int)recent.size();
+}
+
+// Private helpers
+
+/**
+ * Sorted Title
+ * The title a track is sorted under in the sorted array
+ */
+TitleHandle TitleIndex::sortedTitle(int id) const {
+    if (states[id] == RENAMED) {
+        map<int, TitleHandle>::const_iterator it = staleTitles.find(id);
+        if (it != staleTitles.end()) {
+            return it->second;
+        }
+    }
+    return titles[id];
+}
+
+/**
+ * Lower Bound
+ * First position whose (title, id) is not below (key, keyId)
+ */
+size_t TitleIndex::lowerBound(const vector<int>& ids, bool useSortedTitles,
+                              const char* key, int keyLength, int keyId) const {
+    size_t low = 0;
+    size_t high = ids.size();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int id = ids[middle];
+        TitleHandle handle = useSortedTitles ? sortedTitle(id) : titles[id];
+        if (compareKeys(arena.data(handle), handle.length, id, key, keyLength, keyId) < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+void TitleIndex::insertRecent(int id) {
+    const TitleHandle& handle = titles[id];
+    size_t position = lowerBound(recent, false, arena.data(handle), handle.length, id);
+    recent.insert(recent.begin() + position, id);
+}
+
+void TitleIndex::eraseRecent(int id) {
+    const TitleHandle& handle = titles[id];
+    size_t position = lowerBound(recent, false, arena.data(handle), handle.length, id);
+    if (position < recent.size() && recent[position] == id) {
+        recent.erase(recent.begin() + position);
+    }
+}
+
+/**
+ * Merge Recent
+ * Drop the tombstones from the sorted array and merge the recent array
+ * into it in one linear pass
+ */
+void TitleIndex::mergeRecent() {
+    vector<int> live;
+    live.reserve(sorted.size() - staleTitles.size() + recent.size());
+    for (size_t i = 0; i < sorted.size(); i++) {
+        if (states[sorted[i]] == IN_SORTED) {
+            live.push_back(sorted[i]);
+        }
+    }
+
+    vector<int> merged(live.size() + recent.size());
+    CurrentTitleOrder order = { &arena, &titles };
+    merge(live.begin(), live.end(), recent.begin(), recent.end(), merged.begin(), order);
+    sorted.swap(merged);
+
+    for (size_t i = 0; i < recent.size(); i++) {
+        states[recent[i]] = (unsigned char)IN_SORTED;
+    }
+    recent.clear();
+    staleTitles.clear();
+}
+
+/**
+ * Merge Threshold
+ * A few times sqrt(n): small enough that inserting into the recent
+ * array stays cheap, large enough that merges are rare
+ */
+size_t TitleIndex::mergeThreshold() const {
+    size_t threshold = (size_t)(4 * sqrt((double)sorted.size()));
+    return threshold < 1024 ? 1024 : threshold;
+}
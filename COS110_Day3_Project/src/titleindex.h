@@ -0,0 +1,112 @@
+#ifndef TITLEINDEX_H
+#define TITLEINDEX_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include "titlearena.h"
+using namespace std;
+
+/**
+ * TitleIndex Class - Maître Gims Studio Management System
+ *
+ * Exact and prefix title lookup over a catalog's title column, without
+ * copying any title. Titles are compared byte by byte, so UTF-8 titles
+ * such as "Où aller" sort and match exactly as stored (the comparison
+ * is case- and accent-sensitive). Equal titles are ordered by track id.
+ *
+ * Most ids live in one big array sorted by title. Tracks added or
+ * renamed since the last merge go into a small sorted "recent" array
+ * instead, and their old entry in the big array is skipped until the
+ * next merge. The merge (a linear pass) runs once the recent array
+ * outgrows a few times sqrt(n), so every update costs O(sqrt n) on
+ * average and every query is two binary searches.
+ *
+ * The index reads titles straight from the owner's TitleArena and
+ * handle column; the owner must call trackAdded(), titleChanging() /
+ * titleChanged() and rebuild() (after moving titles) to keep it in
+ * sync. Not thread-safe.
+ */
+class TitleIndex {
+public:
+    /**
+     * Constructor
+     * @param arena Arena holding the title bytes
+     * @param titles Title handle of each track id
+     */
+    TitleIndex(const TitleArena& arena, const vector<TitleHandle>& titles);
+
+    /**
+     * Sort every track again (after the owner compacts its titles)
+     */
+    void rebuild();
+
+    /**
+     * Index the next track (id == number of indexed tracks)
+     */
+    void trackAdded();
+
+    /**
+     * Call before a track's title handle changes
+     * @param id Track id
+     */
+    void titleChanging(int id);
+
+    /**
+     * Call after a track's title handle changed
+     * @param id Track id
+     */
+    void titleChanged(int id);
+
+    /**
+     * Find a track with exactly this title
+     * @param title Title bytes
+     * @param length Number of bytes
+     * @return Lowest id with that title, or -1
+     */
+    int findExact(const char* title, int length) const;
+
+    /**
+     * List tracks whose title starts with a prefix, in title order
+     * @param prefix Prefix bytes ("" lists every track)
+     * @param length Number of bytes
+     * @param limit Maximum number of ids to return
+     * @param ids Receives the ids (replaced)
+     */
+    void findPrefix(const char* prefix, int length, int limit, vector<int>& ids) const;
+
+    /**
+     * Get the number of tracks waiting for the next merge
+     * @return Size of the recent array
+     */
+    int pendingCount() const;
+
+private:
+    // Where a track's current entry lives
+    enum EntryState {
+        IN_SORTED = 0,   // sorted array, up to date
+        RENAMED = 1,     // stale entry in sorted, current one in recent
+        ADDED = 2        // only in recent
+    };
+
+    const TitleArena& arena;
+    const vector<TitleHandle>& titles;
+
+    vector<int> sorted;
+    vector<int> recent;
+    vector<unsigned char> states;
+
+    // Title each RENAMED track is sorted under in the sorted array
+    // (the old bytes stay in the arena until the owner compacts)
+    map<int, TitleHandle> staleTitles;
+
+    TitleHandle sortedTitle(int id) const;
+    size_t lowerBound(const vector<int>& ids, bool useSortedTitles,
+                      const char* key, int keyLength, int keyId) const;
+    void insertRecent(int id);
+    void eraseRecent(int id);
+    void mergeRecent();
+    size_t mergeThreshold() const;
+};
+
+#endif
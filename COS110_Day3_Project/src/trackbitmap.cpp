@@ -0,0 +1,411 @@
+#include "trackbitmap.h"
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+const int TrackBitmap::BLOCK_BITS;
+const int TrackBitmap::WORDS_PER_BLOCK;
+const int TrackBitmap::MAX_SPARSE;
+
+/**
+ * Default Constructor
+ */
+TrackBitmap::TrackBitmap() {
+}
+
+/**
+ * Add
+ * Insert into the block's sorted array, switching the block to a
+ * bitmap once the array would outgrow it
+ */
+void TrackBitmap::add(int id) {
+    if (id < 0) {
+        return;
+    }
+    uint16_t key = (uint16_t)(id >> 16);
+    uint16_t offset = (uint16_t)(id & 0xffff);
+
+    int index = findBlock(key);
+    if (index < 0) {
+        Block block;
+        block.key = key;
+        block.count = 0;
+        // Keep blocks sorted by key
+        index = 0;
+        while (index < (int)blocks.size() && blocks[index].key < key) {
+            index++;
+        }
+        blocks.insert(blocks.begin() + index, block);
+    }
+
+    Block& block = blocks[index];
+    if (!block.words.empty()) {
+        uint64_t bit = (uint64_t)1 << (offset & 63);
+        if ((block.words[offset >> 6] & bit) == 0) {
+            block.words[offset >> 6] |= bit;
+            block.count++;
+        }
+        return;
+    }
+
+    vector<uint16_t>::iterator pos = lower_bound(block.sparse.begin(), block.sparse.end(), offset);
+    if (pos != block.sparse.end() && *pos == offset) {
+        return;
+    }
+    block.sparse.insert(pos, offset);
+    block.count++;
+    if (block.count > MAX_SPARSE) {
+        makeDense(block);
+    }
+}
+
+/**
+ * Remove
+ * Dense blocks that shrink back to MAX_SPARSE ids become arrays again;
+ * empty blocks are dropped
+ */
+void TrackBitmap::remove(int id) {
+    if (id < 0) {
+        return;
+    }
+    int index = findBlock((uint16_t)(id >> 16));
+    if (index < 0) {
+        return;
+    }
+    uint16_t offset = (uint16_t)(id & 0xffff);
+
+    Block& block = blocks[index];
+    if (!block.words.empty()) {
+        uint64_t bit = (uint64_t)1 << (offset & 63);
+        if ((block.words[offset >> 6] & bit) == 0) {
+            return;
+        }
+        block.words[offset >> 6] &= ~bit;
+        block.count--;
+    } else {
+        vector<uint16_t>::iterator pos = lower_bound(block.sparse.begin(), block.sparse.end(), offset);
+        if (pos == block.sparse.end() || *pos != offset) {
+            return;
+        }
+        block.sparse.erase(pos);
+        block.count--;
+    }
+
+    if (block.count == 0) {
+        blocks.erase(blocks.begin() + index);
+    } else {
+        compactBlock(block);
+    }
+}
+
+bool TrackBitmap::contains(int id) const {
+    if (id < 0) {
+        return false;
+    }
+    int index = findBlock((uint16_t)(id >> 16));
+    return index >= 0 && blockContains(blocks[index], (uint16_t)(id & 0xffff));
+}
+
+bool TrackBitmap::empty() const {
+    return blocks.empty();
+}
+
+int TrackBitmap::cardinality() const {
+    int total = 0;
+    for (size_t i = 0; i < blocks.size(); i++) {
+        total += blocks[i].count;
+    }
+    return total;
+}
+
+void TrackBitmap::clear() {
+    blocks.clear();
+}
+
+/**
+ * Intersection
+ * Walk both block lists by key; only keys present in both can match
+ */
+TrackBitmap TrackBitmap::intersection(const TrackBitmap& other) const {
+    TrackBitmap result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < blocks.size() && j < other.blocks.size()) {
+        if (blocks[i].key < other.blocks[j].key) {
+            i++;
+        } else if (blocks[i].key > other.blocks[j].key) {
+            j++;
+        } else {
+            Block block = intersectBlocks(blocks[i], other.blocks[j]);
+            if (block.count > 0) {
+                result.blocks.push_back(block);
+            }
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+/**
+ * Union With
+ * Walk both block lists by key, copying blocks that only one side has
+ */
+TrackBitmap TrackBitmap::unionWith(const TrackBitmap& other) const {
+    TrackBitmap result;
+    size_t i = 0;
+    size_t j = 0;
+    while (i < blocks.size() || j < other.blocks.size()) {
+        if (j == other.blocks.size() || (i < blocks.size() && blocks[i].key < other.blocks[j].key)) {
+            result.blocks.push_back(blocks[i++]);
+        } else if (i == blocks.size() || other.blocks[j].key < blocks[i].key) {
+            result.blocks.push_back(other.blocks[j++]);
+        } else {
+            result.blocks.push_back(uniteBlocks(blocks[i], other.blocks[j]));
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+/**
+ * Filter Range
+ * Test the column value of each id in the set, one block at a time
+ */
+TrackBitmap TrackBitmap::filterRange(const int* column, int minValue, int maxValue) const {
+    TrackBitmap result;
+    if (column == NULL || minValue > maxValue) {
+        return result;
+    }
+
+    for (size_t b = 0; b < blocks.size(); b++) {
+        const Block& block = blocks[b];
+        const int* values = column + ((size_t)block.key << 16);
+
+        Block kept;
+        kept.key = block.key;
+        kept.count = 0;
+        if (block.words.empty()) {
+            for (size_t i = 0; i < block.sparse.size(); i++) {
+                int value = values[block.sparse[i]];
+                if (value >= minValue && value <= maxValue) {
+                    kept.sparse.push_back(block.sparse[i]);
+                }
+            }
+            kept.count = (int)kept.sparse.size();
+        } else {
+            kept.words.assign(WORDS_PER_BLOCK, 0);
+            for (int w = 0; w < WORDS_PER_BLOCK; w++) {
+                uint64_t word = block.words[w];
+                while (word != 0) {
+                    int bit = __builtin_ctzll(word);
+                    word &= word - 1;
+                    int value = values[w * 64 + bit];
+                    if (value >= minValue && value <= maxValue) {
+                        kept.words[w] |= (uint64_t)1 << bit;
+                        kept.count++;
+                    }
+                }
+            }
+            compactBlock(kept);
+        }
+
+        if (kept.count > 0) {
+            result.blocks.push_back(kept);
+        }
+    }
+    return result;
+}
+
+/**
+ * To Ids
+ * Blocks are sorted by key and offsets are sorted inside each block,
+ * so the ids come out in increasing order
+ */
+void TrackBitmap::toIds(vector<int>& ids) const {
+    ids.clear();
+    ids.reserve(cardinality());
+    for (size_t b = 0; b < blocks.size(); b++) {
+        const Block& block = blocks[b];
+        int base = (int)block.key << 16;
+        if (block.words.empty()) {
+            for (size_t i = 0; i < block.sparse.size(); i++) {
+                ids.push_back(base + block.sparse[i]);
+            }
+        } else {
+            for (int w = 0; w < WORDS_PER_BLOCK; w++) {
+                uint64_t word = block.words[w];
+                while (word != 0) {
+                    ids.push_back(base + w * 64 + __builtin_ctzll(word));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+}
+
+size_t TrackBitmap::memoryBytes() const {
+    size_t total = blocks.capacity() * sizeof(Block);
+    for (size_t b = 0; b < blocks.size(); b++) {
+        total += blocks[b].sparse.capacity() * sizeof(uint16_t);
+        total += blocks[b].words.capacity() * sizeof(uint64_t);
+    }
+    return total;
+}
+
+/**
+ * Equality
+ * Blocks are always stored in their canonical form (see compactBlock),
+ * so equal sets have identical blocks
+ */
+bool TrackBitmap::operator==(const TrackBitmap& other) const {
+    if (blocks.size() != other.blocks.size()) {
+        return false;
+    }
+    for (size_t b = 0; b < blocks.size(); b++) {
+        if (blocks[b].key != other.blocks[b].key || blocks[b].count != other.blocks[b].count ||
+            blocks[b].sparse != other.blocks[b].sparse || blocks[b].words != other.blocks[b].words) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Private helpers
+
+/**
+ * Find Block
+ * Binary search for the block holding ids with this high half
+ * @return Index into blocks, or -1
+ */
+int TrackBitmap::findBlock(uint16_t key) const {
+    int low = 0;
+    int high = (int)blocks.size() - 1;
+    while (low <= high) {
+        int middle = (low + high) / 2;
+        if (blocks[middle].key < key) {
+            low = middle + 1;
+        } else if (blocks[middle].key > key) {
+            high = middle - 1;
+        } else {
+            return middle;
+        }
+    }
+    return -1;
+}
+
+bool TrackBitmap::blockContains(const Block& block, uint16_t offset) {
+    if (!block.words.empty()) {
+        return (block.words[offset >> 6] >> (offset & 63)) & 1;
+    }
+    return binary_search(block.sparse.begin(), block.sparse.end(), offset);
+}
+
+void TrackBitmap::makeDense(Block& block) {
+    block.words.assign(WORDS_PER_BLOCK, 0);
+    for (size_t i = 0; i < block.sparse.size(); i++) {
+        block.words[block.sparse[i] >> 6] |= (uint64_t)1 << (block.sparse[i] & 63);
+    }
+    vector<uint16_t>().swap(block.sparse);
+}
+
+void TrackBitmap::makeSparse(Block& block) {
+    block.sparse.clear();
+    block.sparse.reserve(block.count);
+    for (int w = 0; w < WORDS_PER_BLOCK; w++) {
+        uint64_t word = block.words[w];
+        while (word != 0) {
+            block.sparse.push_back((uint16_t)(w * 64 + __builtin_ctzll(word)));
+            word &= word - 1;
+        }
+    }
+    vector<uint64_t>().swap(block.words);
+}
+
+/**
+ * Compact Block
+ * Canonical form: sparse when count <= MAX_SPARSE, dense otherwise.
+ * Sparse arrays that lost most of their ids give the memory back.
+ */
+void TrackBitmap::compactBlock(Block& block) {
+    if (block.words.empty() && block.count > MAX_SPARSE) {
+        makeDense(block);
+    } else if (!block.words.empty() && block.count <= MAX_SPARSE) {
+        makeSparse(block);
+    } else if (block.words.empty() && block.sparse.capacity() > 2 * block.sparse.size() + 16) {
+        vector<uint16_t>(block.sparse).swap(block.sparse);
+    }
+}
+
+TrackBitmap::Block TrackBitmap::intersectBlocks(const Block& a, const Block& b) {
+    Block result;
+    result.key = a.key;
+    result.count = 0;
+
+    if (!a.words.empty() && !b.words.empty()) {
+        result.words.resize(WORDS_PER_BLOCK);
+        for (int w = 0; w < WORDS_PER_BLOCK; w++) {
+            result.words[w] = a.words[w] & b.words[w];
+            result.count += __builtin_popcountll(result.words[w]);
+        }
+    } else if (a.words.empty() && b.words.empty()) {
+        result.sparse.resize(min(a.sparse.size(), b.sparse.size()));
+        vector<uint16_t>::iterator end = set_intersection(a.sparse.begin(), a.sparse.end(),
+                                                          b.sparse.begin(), b.sparse.end(),
+                                                          result.sparse.begin());
+        result.sparse.erase(end, result.sparse.end());
+        result.count = (int)result.sparse.size();
+    } else {
+        // Probe the bitmap with each entry of the array
+        const Block& sparse = a.words.empty() ? a : b;
+        const Block& dense = a.words.empty() ? b : a;
+        for (size_t i = 0; i < sparse.sparse.size(); i++) {
+            if (blockContains(dense, sparse.sparse[i])) {
+                result.sparse.push_back(sparse.sparse[i]);
+            }
+        }
+        result.count = (int)result.sparse.size();
+    }
+
+    compactBlock(result);
+    return result;
+}
+
+TrackBitmap::Block TrackBitmap::uniteBlocks(const Block& a, const Block& b) {
+    Block result;
+    result.key = a.key;
+    result.count = 0;
+
+    if (a.words.empty() && b.words.empty() && a.count + b.count <= MAX_SPARSE) {
+        result.sparse.resize(a.sparse.size() + b.sparse.size());
+        vector<uint16_t>::iterator end = set_union(a.sparse.begin(), a.sparse.end(),
+                                                   b.sparse.begin(), b.sparse.end(),
+                                                   result.sparse.begin());
+        result.sparse.erase(end, result.sparse.end());
+        result.count = (int)result.sparse.size();
+        return result;
+    }
+
+    // At least one side is large: OR into a bitmap
+    result.words.assign(WORDS_PER_BLOCK, 0);
+    const Block* sides[2] = { &a, &b };
+    for (int s = 0; s < 2; s++) {
+        const Block& side = *sides[s];
+        if (!side.words.empty()) {
+            for (int w = 0; w < WORDS_PER_BLOCK; w++) {
+                result.words[w] |= side.words[w];
+            }
+        } else {
+            for (size_t i = 0; i < side.sparse.size(); i++) {
+                result.words[side.sparse[i] >> 6] |= (uint64_t)1 << (side.sparse[i] & 63);
+            }
+        }
+    }
+    for (int w = 0; w < WORDS_PER_BLOCK; w++) {
+        result.count += __builtin_popcountll(result.words[w]);
+    }
+
+    compactBlock(result);
+    return result;
+}
@@ -0,0 +1,122 @@
+#ifndef TRACKBITMAP_H
+#define TRACKBITMAP_H
+
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+using namespace std;
+
+/**
+ * TrackBitmap Class - Maître Gims Studio Management System
+ *
+ * Compressed set of track ids, in the style of a Roaring bitmap. The
+ * id space is cut into blocks of 65536 ids and each block that holds
+ * at least one id is stored in whichever form is smaller:
+ *
+ * - sparse block: sorted array of 16-bit offsets (up to 4096 ids,
+ *   2 bytes per id)
+ * - dense block:  plain 65536-bit bitmap (8 KB, 1 bit per id)
+ *
+ * A genre with a few hundred tracks costs a few hundred bytes, and a
+ * genre covering half the catalog costs about 1 bit per track.
+ * Intersections and unions work block by block and never expand the
+ * sets into plain arrays of ids.
+ *
+ * Ids must be >= 0. Not thread-safe.
+ */
+class TrackBitmap {
+public:
+    /**
+     * Default Constructor
+     * Creates an empty set
+     */
+    TrackBitmap();
+
+    /**
+     * Add a track id
+     * @param id Track id (ignored if negative)
+     */
+    void add(int id);
+
+    /**
+     * Remove a track id
+     * @param id Track id
+     */
+    void remove(int id);
+
+    bool contains(int id) const;
+    bool empty() const;
+
+    /**
+     * Get the number of ids in the set
+     * @return Number of ids
+     */
+    int cardinality() const;
+
+    /**
+     * Remove every id
+     */
+    void clear();
+
+    /**
+     * Ids in both sets (AND)
+     * @param other Second set
+     * @return New set
+     */
+    TrackBitmap intersection(const TrackBitmap& other) const;
+
+    /**
+     * Ids in either set (OR)
+     * @param other Second set
+     * @return New set
+     */
+    TrackBitmap unionWith(const TrackBitmap& other) const;
+
+    /**
+     * Keep only the ids whose column value is inside a range.
+     * Only the column entries of ids in the set are read.
+     * @param column Column indexed by track id (e.g. durationData())
+     * @param minValue Smallest value to keep
+     * @param maxValue Largest value to keep
+     * @return New set
+     */
+    TrackBitmap filterRange(const int* column, int minValue, int maxValue) const;
+
+    /**
+     * Copy the ids out in increasing order
+     * @param ids Receives the ids (replaced)
+     */
+    void toIds(vector<int>& ids) const;
+
+    /**
+     * Get the memory used by the blocks
+     * @return Bytes of block storage
+     */
+    size_t memoryBytes() const;
+
+    bool operator==(const TrackBitmap& other) const;
+
+private:
+    static const int BLOCK_BITS = 65536;
+    static const int WORDS_PER_BLOCK = BLOCK_BITS / 64;
+    static const int MAX_SPARSE = 4096;
+
+    struct Block {
+        uint16_t key;              // id >> 16
+        int count;                 // ids in this block
+        vector<uint16_t> sparse;   // sorted offsets, used when words is empty
+        vector<uint64_t> words;    // dense bitmap, WORDS_PER_BLOCK words
+    };
+
+    vector<Block> blocks;
+
+    int findBlock(uint16_t key) const;
+    static bool blockContains(const Block& block, uint16_t offset);
+    static void makeDense(Block& block);
+    static void makeSparse(Block& block);
+    static void compactBlock(Block& block);
+    static Block intersectBlocks(const Block& a, const Block& b);
+    static Block uniteBlocks(const Block& a, const Block& b);
+};
+
+#endif
@@ -0,0 +1,732 @@
+#include "trackcatalog.h"
+#include "playlog.h"
+#include "seedcatalog.h"
+#include <string>
+#include <vector>
+#include <climits>
+#include <algorithm>
+using namespace std;
+
+/**
+ * Title stored for empty titles
+ * (function-local so it is ready even during static initialization)
+ */
+static const string& untitledTrack() {
+    static const string title("Untitled Track");
+    return title;
+}
+
+/**
+ * Order play events by track id so a batch can be applied in one pass
+ */
+static bool playEventLess(const PlayEvent& a, const PlayEvent& b) {
+    return a.trackId < b.trackId;
+}
+
+/**
+ * Default Constructor
+ * Start with no tracks and no genres
+ */
+TrackCatalog::TrackCatalog()
+    : concurrentPlays(NULL), popularity(NULL), genreTracks(NULL), titleIndex(NULL), playLog(NULL), changed(NULL),
+      windows(NULL) {
+}
+
+/**
+ * Destructor
+ */
+TrackCatalog::~TrackCatalog() {
+    delete concurrentPlays;
+    delete popularity;
+    delete genreTracks;
+    delete titleIndex;
+    delete changed;
+    delete windows;
+}
+
+/**
+ * Add Track
+ * Validate the values the same way the MusicTrack constructor does,
+ * then append one entry to every column
+ */
+int TrackCatalog::addTrack(const string& t, int d, const string& g) {
+    const string& title = t.empty() ? untitledTrack() : t;
+    return appendTrack(title.data(), (int)title.size(), d, genres.intern(g));
+}
+
+/**
+ * Add Track (from MusicTrack)
+ * Copy every field, including the current play count
+ */
+int TrackCatalog::addTrack(const MusicTrack& track) {
+    int id = addTrack(track.getTitle(), track.getDuration(), track.getGenre());
+    setPlayCount(id, track.getPlayCount());
+    return id;
+}
+
+/**
+ * Add Seed Tracks
+ * Reserve once, then append each entry; each distinct genre literal
+ * is interned once
+ */
+int TrackCatalog::addSeedTracks(const SeedTrack* seeds, int count) {
+    int first = size();
+    if (seeds == NULL || count <= 0) {
+        return first;
+    }
+
+    size_t titleBytes = 0;
+    for (int i = 0; i < count; i++) {
+        titleBytes += (seeds[i].titleLength > 0) ? seeds[i].titleLength : untitledTrack().size();
+    }
+    reserve(first + count, titleArena.bytesUsed() + titleBytes);
+
+    // Equal literals usually share one address, so this stays tiny
+    vector<pair<const char*, int> > genreIdsByText;
+    for (int i = 0; i < count; i++) {
+        const SeedTrack& seed = seeds[i];
+        int genreId = -1;
+        for (size_t g = 0; g < genreIdsByText.size() && genreId < 0; g++) {
+            if (genreIdsByText[g].first == seed.genre) {
+                genreId = genreIdsByText[g].second;
+            }
+        }
+        if (genreId < 0) {
+            genreId = genres.intern(string(seed.genre, seed.genreLength > 0 ? seed.genreLength : 0));
+            genreIdsByText.push_back(make_pair(seed.genre, genreId));
+        }
+
+        if (seed.titleLength > 0) {
+            appendTrack(seed.title, seed.titleLength, seed.duration, genreId);
+        } else {
+            appendTrack(untitledTrack().data(), (int)untitledTrack().size(), seed.duration, genreId);
+        }
+    }
+    return first;
+}
+
+/**
+ * Reserve
+ * Grow every column once so bulk loads don't reallocate repeatedly
+ */
+void TrackCatalog::reserve(int trackCount, size_t titleByteCount) {
+    if (trackCount > 0) {
+        durations.reserve(trackCount);
+        playCounts.reserve(trackCount);
+        genreIds.reserve(trackCount);
+        titles.reserve(trackCount);
+        if (windows != NULL) {
+            windows->reserve(trackCount);
+        }
+    }
+    titleArena.reserve(titleByteCount);
+}
+
+int TrackCatalog::size() const {
+    return (int)durations.size();
+}
+
+bool TrackCatalog::isValidId(int id) const {
+    return id >= 0 && id < size();
+}
+
+// Accessors
+
+string TrackCatalog::getTitle(int id) const {
+    return isValidId(id) ? titleArena.get(titles[id]) : "";
+}
+
+int TrackCatalog::getDuration(int id) const {
+    return isValidId(id) ? durations[id] : 0;
+}
+
+const string& TrackCatalog::getGenre(int id) const {
+    // getName(-1) is the table's empty string
+    return genres.getName(isValidId(id) ? genreIds[id] : -1);
+}
+
+const char* TrackCatalog::getTitleData(int id, int* length) const {
+    if (!isValidId(id)) {
+        *length = 0;
+        return NULL;
+    }
+    *length = titles[id].length;
+    return titleArena.data(titles[id]);
+}
+
+#if __cplusplus >= 201703L
+std::string_view TrackCatalog::getTitleView(int id) const {
+    if (!isValidId(id)) {
+        return std::string_view();
+    }
+    return std::string_view(titleArena.data(titles[id]), titles[id].length);
+}
+
+std::string_view TrackCatalog::getGenreView(int id) const {
+    return getGenre(id);
+}
+#endif
+
+/**
+ * Get Play Count
+ * In concurrent mode, add the plays not yet collected into the column
+ */
+int TrackCatalog::getPlayCount(int id) const {
+    if (!isValidId(id)) {
+        return 0;
+    }
+    if (concurrentPlays == NULL) {
+        return playCounts[id];
+    }
+
+    long long total = playCounts[id] + concurrentPlays->getPlayCount(id);
+    return total > INT_MAX ? INT_MAX : (int)total;
+}
+
+// Mutators
+
+/**
+ * Set Title
+ * The new title is appended to the title arena; the old bytes stay
+ * behind until compactTitles()
+ */
+void TrackCatalog::setTitle(int id, const string& t) {
+    if (!isValidId(id)) {
+        return;
+    }
+    if (titleIndex != NULL) {
+        titleIndex->titleChanging(id);
+    }
+    titles[id] = titleArena.replace(titles[id], t.empty() ? untitledTrack() : t);
+    if (titleIndex != NULL) {
+        titleIndex->titleChanged(id);
+    }
+    markChanged(id);
+}
+
+void TrackCatalog::setDuration(int id, int d) {
+    if (isValidId(id)) {
+        durations[id] = (d <= 0) ? 180 : d;
+        markChanged(id);
+    }
+}
+
+/**
+ * Set Genre
+ * With the genre index enabled, move the track to its new bitmap
+ */
+void TrackCatalog::setGenre(int id, const string& g) {
+    if (!isValidId(id)) {
+        return;
+    }
+    int oldGenre = genreIds[id];
+    genreIds[id] = genres.intern(g);
+    markChanged(id);
+
+    if (genreTracks != NULL && genreIds[id] != oldGenre) {
+        if ((int)genreTracks->size() <= genreIds[id]) {
+            genreTracks->resize(genreIds[id] + 1);
+        }
+        (*genreTracks)[oldGenre].remove(id);
+        (*genreTracks)[genreIds[id]].add(id);
+    }
+}
+
+/**
+ * Set Play Count
+ * Replaces the count completely, including plays not yet collected
+ */
+void TrackCatalog::setPlayCount(int id, int p) {
+    if (isValidId(id)) {
+        if (concurrentPlays != NULL) {
+            concurrentPlays->takePlayCount(id);
+        }
+        storePlayCount(id, (p < 0) ? 0 : p);
+    }
+}
+
+void TrackCatalog::play(int id) {
+    if (isValidId(id)) {
+        if (concurrentPlays != NULL) {
+            concurrentPlays->play(id);
+        } else {
+            storePlayCount(id, playCounts[id] + 1);
+            if (windows != NULL) {
+                windows->record(id, 1, windows->now());
+            }
+        }
+    }
+}
+
+void TrackCatalog::resetPlayCount(int id) {
+    setPlayCount(id, 0);
+}
+
+/**
+ * Apply Play Events
+ * Sort the batch by track, add up each run of events for the same
+ * track, then write that track's count once
+ */
+int TrackCatalog::applyPlayEvents(PlayEvent* events, int eventCount) {
+    if (events == NULL || eventCount <= 0) {
+        return 0;
+    }
+
+    sort(events, events + eventCount, playEventLess);
+
+    // One clock read for the whole batch
+    long long now = (windows != NULL) ? windows->now() : 0;
+    int applied = 0;
+    int i = 0;
+    while (i < eventCount) {
+        int id = events[i].trackId;
+        long long total = 0;
+        int runStart = i;
+        while (i < eventCount && events[i].trackId == id) {
+            total += events[i].count;
+            i++;
+        }
+
+        if (!isValidId(id)) {
+            continue;
+        }
+
+        long long updated = playCounts[id] + total;
+        if (updated < 0) {
+            updated = 0;
+        } else if (updated > INT_MAX) {
+            updated = INT_MAX;
+        }
+        queuePlayLogChange(id, (int)updated);
+        writePlayCount(id, (int)updated);
+        if (windows != NULL && total > 0) {
+            windows->record(id, total > INT_MAX ? INT_MAX : (int)total, now);
+        }
+        applied += i - runStart;
+    }
+    flushPlayLogChanges();
+
+    return applied;
+}
+
+bool TrackCatalog::isPopular(int id) const {
+    return getPlayCount(id) > 1000000;
+}
+
+/**
+ * Count Popular
+ * In concurrent mode the column misses the pending plays, so each
+ * count is merged through getPlayCount() instead
+ */
+int TrackCatalog::countPopular() const {
+    if (concurrentPlays != NULL) {
+        int popular = 0;
+        for (int id = 0; id < size(); id++) {
+            popular += isPopular(id) ? 1 : 0;
+        }
+        return popular;
+    }
+    return countAbove(playCountData(), size(), 1000000);
+}
+
+vector<int> TrackCatalog::findPopular() const {
+    vector<int> ids;
+    if (concurrentPlays != NULL) {
+        for (int id = 0; id < size(); id++) {
+            if (isPopular(id)) {
+                ids.push_back(id);
+            }
+        }
+        return ids;
+    }
+    ids.resize(size());
+    ids.resize(selectAbove(playCountData(), size(), 1000000, ids.empty() ? NULL : &ids[0]));
+    return ids;
+}
+
+ColumnStats TrackCatalog::playCountStats() const {
+    if (concurrentPlays != NULL) {
+        vector<int> counts(size());
+        for (int id = 0; id < size(); id++) {
+            counts[id] = getPlayCount(id);
+        }
+        return columnStats(counts.empty() ? NULL : &counts[0], size());
+    }
+    return columnStats(playCountData(), size());
+}
+
+ColumnStats TrackCatalog::durationStats() const {
+    return columnStats(durationData(), size());
+}
+
+/**
+ * Get Track
+ * Rebuild a standalone MusicTrack from the columns
+ */
+MusicTrack TrackCatalog::getTrack(int id) const {
+    MusicTrack track(getTitle(id), getDuration(id), getGenre(id));
+    track.setPlayCount(getPlayCount(id));
+    return track;
+}
+
+// Column access
+
+const int* TrackCatalog::durationData() const {
+    return durations.empty() ? NULL : &durations[0];
+}
+
+const int* TrackCatalog::playCountData() const {
+    return playCounts.empty() ? NULL : &playCounts[0];
+}
+
+const int* TrackCatalog::genreIdData() const {
+    return genreIds.empty() ? NULL : &genreIds[0];
+}
+
+int TrackCatalog::genreCount() const {
+    return genres.size();
+}
+
+string TrackCatalog::genreName(int genreId) const {
+    return genres.getName(genreId);
+}
+
+int TrackCatalog::findGenreId(const string& g) const {
+    return genres.find(g);
+}
+
+// Title storage
+
+/**
+ * Compact Titles
+ * Copy the live titles into a fresh arena sized exactly for them
+ */
+void TrackCatalog::compactTitles() {
+    if (titleArena.wastedBytes() == 0) {
+        return;
+    }
+
+    TitleArena compacted(titleArena.bytesUsed() - titleArena.wastedBytes());
+    for (size_t i = 0; i < titles.size(); i++) {
+        titles[i] = compacted.append(titleArena.data(titles[i]), titles[i].length);
+    }
+    titleArena.swap(compacted);
+
+    if (titleIndex != NULL) {
+        titleIndex->rebuild();
+    }
+}
+
+size_t TrackCatalog::titleWasteBytes() const {
+    return titleArena.wastedBytes();
+}
+
+// Concurrent play counting
+
+/**
+ * Enable Concurrent Plays
+ * Create the padded counter; existing counts stay in the column
+ */
+void TrackCatalog::enableConcurrentPlays(int stripeCount) {
+    if (concurrentPlays == NULL) {
+        concurrentPlays = new ConcurrentPlayCounter((int)durations.capacity(), stripeCount);
+    }
+}
+
+bool TrackCatalog::hasConcurrentPlays() const {
+    return concurrentPlays != NULL;
+}
+
+void TrackCatalog::markHotTrack(int id) {
+    if (concurrentPlays != NULL && isValidId(id)) {
+        concurrentPlays->markHot(id);
+    }
+}
+
+/**
+ * Collect Concurrent Plays
+ * Move each pending count into the column, saturating at INT_MAX
+ */
+void TrackCatalog::collectConcurrentPlays() {
+    if (concurrentPlays == NULL) {
+        return;
+    }
+
+    long long now = (windows != NULL) ? windows->now() : 0;
+    for (int id = 0; id < size(); id++) {
+        long long pending = concurrentPlays->takePlayCount(id);
+        if (pending != 0) {
+            long long total = playCounts[id] + pending;
+            int count = total > INT_MAX ? INT_MAX : (int)total;
+            queuePlayLogChange(id, count);
+            writePlayCount(id, count);
+            if (windows != NULL && pending > 0) {
+                windows->record(id, pending > INT_MAX ? INT_MAX : (int)pending, now);
+            }
+        }
+    }
+    flushPlayLogChanges();
+}
+
+// Play log
+
+void TrackCatalog::attachPlayLog(PlayLog* log) {
+    playLog = log;
+}
+
+bool TrackCatalog::hasPlayLog() const {
+    return playLog != NULL;
+}
+
+// Change tracking
+
+void TrackCatalog::enableChangeTracking() {
+    if (changed == NULL) {
+        changed = new TrackBitmap();
+    }
+}
+
+bool TrackCatalog::hasChangeTracking() const {
+    return changed != NULL;
+}
+
+TrackBitmap TrackCatalog::changedTracks() const {
+    return (changed != NULL) ? *changed : TrackBitmap();
+}
+
+void TrackCatalog::clearChangedTracks() {
+    if (changed != NULL) {
+        changed->clear();
+    }
+}
+
+// Popularity index
+
+/**
+ * Enable Popularity Index
+ * Build the index from the play count column in one pass
+ */
+void TrackCatalog::enablePopularityIndex() {
+    if (popularity == NULL) {
+        popularity = new PopularityIndex();
+        popularity->build(playCountData(), size());
+    }
+}
+
+bool TrackCatalog::hasPopularityIndex() const {
+    return popularity != NULL;
+}
+
+vector<int> TrackCatalog::topTracks(int k) const {
+    return popularity != NULL ? popularity->topTracks(k) : vector<int>();
+}
+
+vector<int> TrackCatalog::tracksAbove(int threshold) const {
+    return popularity != NULL ? popularity->tracksAbove(threshold) : vector<int>();
+}
+
+int TrackCatalog::getPopularityRank(int id) const {
+    return popularity != NULL ? popularity->rank(id) : 0;
+}
+
+// Genre index
+
+/**
+ * Enable Genre Index
+ * One pass over the genre id column; ids arrive in increasing order,
+ * so every add() appends to the end of its bitmap
+ */
+void TrackCatalog::enableGenreIndex() {
+    if (genreTracks != NULL) {
+        return;
+    }
+    genreTracks = new vector<TrackBitmap>(genreCount());
+    for (int id = 0; id < size(); id++) {
+        (*genreTracks)[genreIds[id]].add(id);
+    }
+}
+
+bool TrackCatalog::hasGenreIndex() const {
+    return genreTracks != NULL;
+}
+
+TrackBitmap TrackCatalog::findByGenre(const string& g) const {
+    TrackBitmap result;
+    int genreId = genres.find(g);
+    if (genreId < 0) {
+        return result;
+    }
+    if (genreTracks != NULL) {
+        return genreId < (int)genreTracks->size() ? (*genreTracks)[genreId] : result;
+    }
+
+    for (int id = 0; id < size(); id++) {
+        if (genreIds[id] == genreId) {
+            result.add(id);
+        }
+    }
+    return result;
+}
+
+TrackBitmap TrackCatalog::findByDuration(int minSeconds, int maxSeconds) const {
+    TrackBitmap result;
+    for (int id = 0; id < size(); id++) {
+        if (durations[id] >= minSeconds && durations[id] <= maxSeconds) {
+            result.add(id);
+        }
+    }
+    return result;
+}
+
+TrackBitmap TrackCatalog::filterByDuration(const TrackBitmap& tracks, int minSeconds, int maxSeconds) const {
+    return tracks.filterRange(durationData(), minSeconds, maxSeconds);
+}
+
+// Title index
+
+void TrackCatalog::enableTitleIndex() {
+    if (titleIndex == NULL) {
+        titleIndex = new TitleIndex(titleArena, titles);
+    }
+}
+
+bool TrackCatalog::hasTitleIndex() const {
+    return titleIndex != NULL;
+}
+
+int TrackCatalog::findTitle(const string& t) const {
+    if (titleIndex != NULL) {
+        return titleIndex->findExact(t.data(), (int)t.size());
+    }
+
+    for (int id = 0; id < size(); id++) {
+        int length = 0;
+        const char* data = getTitleData(id, &length);
+        if (length == (int)t.size() && t.compare(0, t.size(), data, length) == 0) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+vector<int> TrackCatalog::findTitlePrefix(const string& prefix, int limit) const {
+    vector<int> ids;
+    if (titleIndex != NULL) {
+        titleIndex->findPrefix(prefix.data(), (int)prefix.size(), limit, ids);
+    }
+    return ids;
+}
+
+// Play windows
+
+/**
+ * Enable Play Windows
+ * Every track starts with empty windows; earlier plays only count
+ * towards the lifetime play count
+ */
+void TrackCatalog::enablePlayWindows(PlayWindowClock clock) {
+    if (windows != NULL) {
+        return;
+    }
+    windows = new PlayWindows(clock);
+    windows->reserve((int)durations.capacity());
+    for (int id = 0; id < size(); id++) {
+        windows->addTrack();
+    }
+}
+
+bool TrackCatalog::hasPlayWindows() const {
+    return windows != NULL;
+}
+
+long long TrackCatalog::getRecentPlays(int id, PlayWindow window) const {
+    return windows != NULL ? windows->getPlays(id, window, windows->now()) : 0;
+}
+
+vector<int> TrackCatalog::trendingTracks(int k) const {
+    return windows != NULL ? windows->trendingTracks(k, windows->now()) : vector<int>();
+}
+
+/**
+ * Store Play Count
+ * Single updates are logged straight away; batch updates queue their
+ * changes and write them with writePlayCount(), then log the whole
+ * batch with one append
+ */
+void TrackCatalog::storePlayCount(int id, int count) {
+    if (playLog != NULL && count != playCounts[id]) {
+        playLog->append(id, count - playCounts[id]);
+    }
+    writePlayCount(id, count);
+}
+
+void TrackCatalog::queuePlayLogChange(int id, int count) {
+    if (playLog != NULL && count != playCounts[id]) {
+        PlayEvent change = { id, count - playCounts[id] };
+        playLogBatch.push_back(change);
+    }
+}
+
+void TrackCatalog::flushPlayLogChanges() {
+    if (!playLogBatch.empty()) {
+        playLog->append(&playLogBatch[0], (int)playLogBatch.size());
+        playLogBatch.clear();
+    }
+}
+
+/**
+ * Write Play Count
+ * Every change to the play count column ends here so the popularity
+ * index never falls behind
+ */
+void TrackCatalog::writePlayCount(int id, int count) {
+    playCounts[id] = count;
+    markChanged(id);
+    if (popularity != NULL) {
+        popularity->update(id, count);
+    }
+}
+
+void TrackCatalog::markChanged(int id) {
+    if (changed != NULL) {
+        changed->add(id);
+    }
+}
+
+/**
+ * Append Track
+ * Add one validated track to every column and keep the enabled
+ * indexes in step
+ */
+int TrackCatalog::appendTrack(const char* t, int titleLength, int d, int genreId) {
+    int id = size();
+
+    durations.push_back(d <= 0 ? 180 : d);
+    playCounts.push_back(0);
+    genreIds.push_back(genreId);
+    titles.push_back(titleArena.append(t, titleLength));
+
+    if (concurrentPlays != NULL) {
+        // Grow with the column capacity so repeated adds stay cheap; this
+        // frees the old slots, hence no adding while plays are counted
+        concurrentPlays->resize((int)durations.capacity());
+    }
+    if (popularity != NULL) {
+        popularity->addTrack(0);
+    }
+    if (genreTracks != NULL) {
+        if ((int)genreTracks->size() <= genreIds[id]) {
+            genreTracks->resize(genreIds[id] + 1);
+        }
+        (*genreTracks)[genreIds[id]].add(id);
+    }
+    if (titleIndex != NULL) {
+        titleIndex->trackAdded();
+    }
+    if (windows != NULL) {
+        windows->addTrack();
+    }
+    markChanged(id);
+
+    return id;
+}
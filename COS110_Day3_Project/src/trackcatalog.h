@@ -0,0 +1,515 @@
+#ifndef TRACKCATALOG_H
+#define TRACKCATALOG_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "musictrack.h"
+#include "playcounter.h"
+#include "genretable.h"
+#include "titlearena.h"
+#include "popularityindex.h"
+#include "trackbitmap.h"
+#include "titleindex.h"
+#include "columnkernels.h"
+#include "playwindows.h"
+using namespace std;
+
+/**
+ * PlayEvent - one entry of a play batch
+ * "Track trackId was played count times"
+ */
+struct PlayEvent {
+    int trackId;
+    int count;
+};
+
+class PlayLog;
+struct SeedTrack;
+
+/**
+ * TrackCatalog Class - Maître Gims Studio Management System
+ *
+ * Stores a large number of tracks in struct-of-arrays form: every
+ * field lives in its own contiguous column instead of inside one
+ * MusicTrack object per track. A scan over play counts or durations
+ * therefore streams through a dense array of ints instead of hopping
+ * over string data.
+ *
+ * Each track is identified by a stable integer id (0, 1, 2, ...)
+ * handed out by addTrack(). Ids never change once assigned.
+ *
+ * The accessors follow the same rules as MusicTrack:
+ * - empty title  -> "Untitled Track"
+ * - duration <= 0 -> 180 seconds
+ * - empty genre  -> "Unknown"
+ * - negative play count -> 0
+ *
+ * Invalid ids are ignored by setters and return empty values
+ * ("" or 0) from getters.
+ *
+ * By default a catalog is meant for one thread at a time. For
+ * multi-threaded ingest, call enableConcurrentPlays(): play() then
+ * becomes safe to call from many threads at once and counts go into a
+ * ConcurrentPlayCounter until collectConcurrentPlays() folds them back
+ * into the play count column. Adding tracks (addTrack(),
+ * addSeedTracks()) is still single-threaded: it grows the columns and
+ * frees the counter's old slots, so it must not run while another
+ * thread is in play(). Add tracks before starting the ingest threads
+ * or after joining them. Nothing checks this rule.
+ *
+ * enablePopularityIndex() keeps the tracks ordered by play count as
+ * counts change, for top-K, threshold and rank queries without a scan.
+ * enableGenreIndex() keeps one compressed TrackBitmap of track ids per
+ * genre, for filtered queries such as "Pop tracks over 4 minutes".
+ * enableTitleIndex() adds exact and prefix title lookup.
+ * enablePlayWindows() counts recent plays per minute, hour and day
+ * for trending queries.
+ */
+class TrackCatalog {
+public:
+    /**
+     * Default Constructor
+     * Creates an empty catalog
+     */
+    TrackCatalog();
+
+    /**
+     * Destructor
+     * Releases the concurrent play counter, if one was enabled
+     */
+    ~TrackCatalog();
+
+    /**
+     * Add a track to the catalog
+     * Never call while other threads are in play() (see the class comment)
+     * @param t Track title
+     * @param d Duration in seconds
+     * @param g Genre of the track
+     * @return Id of the new track
+     */
+    int addTrack(const string& t, int d, const string& g);
+
+    /**
+     * Add a copy of an existing MusicTrack (including its play count)
+     * @param track Track to copy into the catalog
+     * @return Id of the new track
+     */
+    int addTrack(const MusicTrack& track);
+
+    /**
+     * Add every track of a compile-time seed array (seedcatalog.h).
+     * The columns and title storage grow once for the whole array and
+     * titles are copied straight from the static text, so no memory
+     * is allocated per track.
+     * @param seeds Seed array, e.g. GIMS_SEED_TRACKS
+     * @param count Number of entries
+     * @return Id of the first added track (ids are consecutive)
+     */
+    int addSeedTracks(const SeedTrack* seeds, int count);
+
+    /**
+     * Reserve room for a number of tracks and title bytes up front
+     * @param trackCount Expected number of tracks
+     * @param titleByteCount Expected total size of all titles in bytes
+     */
+    void reserve(int trackCount, size_t titleByteCount = 0);
+
+    /**
+     * Get the number of tracks in the catalog
+     * @return Number of tracks
+     */
+    int size() const;
+
+    /**
+     * Check whether an id refers to a track in this catalog
+     * @param id Track id
+     * @return true if 0 <= id < size()
+     */
+    bool isValidId(int id) const;
+
+    // Accessors - same semantics as the MusicTrack getters
+    string getTitle(int id) const;
+    int getDuration(int id) const;
+    const string& getGenre(int id) const;
+    int getPlayCount(int id) const;
+
+    /**
+     * Get the stored title bytes without copying them
+     * The pointer is only valid until the next addTrack()/setTitle()
+     * @param id Track id
+     * @param length Receives the title length in bytes (0 for invalid ids)
+     * @return Pointer to the first byte (not '\0' terminated), or NULL
+     */
+    const char* getTitleData(int id, int* length) const;
+
+#if __cplusplus >= 201703L
+    // Copy-free accessors (C++17 build mode); a title view is only
+    // valid until the next addTrack()/setTitle()/compactTitles()
+    std::string_view getTitleView(int id) const;
+    std::string_view getGenreView(int id) const;
+#endif
+
+    // Mutators - same validation as the MusicTrack setters
+    void setTitle(int id, const string& t);
+    void setDuration(int id, int d);
+    void setGenre(int id, const string& g);
+    void setPlayCount(int id, int p);
+
+    /**
+     * Increment the play count of a track by 1
+     * Thread-safe once enableConcurrentPlays() has been called
+     * @param id Track id
+     */
+    void play(int id);
+
+    /**
+     * Reset the play count of a track to zero
+     * @param id Track id
+     */
+    void resetPlayCount(int id);
+
+    /**
+     * Apply a whole buffer of play events in one pass.
+     * The buffer is sorted by track id in place, so all events for one
+     * track are added up first and each play count is written once.
+     * Counts may be negative (corrections); like setPlayCount() the
+     * result never goes below 0, and it saturates at INT_MAX.
+     * Events with invalid track ids are skipped.
+     * @param events Event buffer (reordered by this call)
+     * @param eventCount Number of events in the buffer
+     * @return Number of events applied
+     */
+    int applyPlayEvents(PlayEvent* events, int eventCount);
+
+    /**
+     * Check if a track has more than 1,000,000 plays
+     * @param id Track id
+     * @return true if the track is popular
+     */
+    bool isPopular(int id) const;
+
+    /**
+     * Count the tracks with more than 1,000,000 plays
+     * Scans the play count column with the vector kernels of
+     * columnkernels.h; gives exactly the same answer as isPopular()
+     * @return Number of popular tracks
+     */
+    int countPopular() const;
+
+    /**
+     * List the tracks with more than 1,000,000 plays
+     * @return Ids for which isPopular() is true, in ascending order
+     */
+    vector<int> findPopular() const;
+
+    /**
+     * Get minimum, maximum and 64-bit total of the play counts
+     * @return Play count statistics (all 0 for an empty catalog)
+     */
+    ColumnStats playCountStats() const;
+
+    /**
+     * Get minimum, maximum and 64-bit total of the durations
+     * @return Duration statistics (all 0 for an empty catalog)
+     */
+    ColumnStats durationStats() const;
+
+    /**
+     * Copy a track out of the catalog as a standalone MusicTrack
+     * @param id Track id
+     * @return MusicTrack with the same title, duration, genre and plays
+     */
+    MusicTrack getTrack(int id) const;
+
+    // Raw column access for scans - each array has size() entries
+    const int* durationData() const;
+    const int* playCountData() const;
+    const int* genreIdData() const;
+
+    /**
+     * Get the number of distinct genres stored in the catalog
+     * @return Number of genre ids in use
+     */
+    int genreCount() const;
+
+    /**
+     * Get the genre name for a genre id from genreIdData()
+     * @param genreId Genre id
+     * @return Genre name, or "" for an invalid id
+     */
+    string genreName(int genreId) const;
+
+    /**
+     * Look up the genre id used by this catalog for a genre name,
+     * so genre filters can compare genreIdData() entries as ints
+     * @param g Genre name (empty means "Unknown")
+     * @return Genre id, or -1 if no track ever had this genre
+     */
+    int findGenreId(const string& g) const;
+
+    /**
+     * Rewrite the title storage so it only holds the current titles.
+     * setTitle() leaves the replaced title bytes behind; call this after
+     * many renames to give that memory back.
+     */
+    void compactTitles();
+
+    /**
+     * Get the number of title bytes left behind by setTitle()
+     * @return Bytes that compactTitles() would free
+     */
+    size_t titleWasteBytes() const;
+
+    /**
+     * Switch play() to concurrent mode: plays are counted in cache-line
+     * padded atomic slots and merged on read by getPlayCount().
+     * Call before starting ingest threads, and don't add tracks while
+     * they run (see the class comment).
+     * @param stripeCount Number of per-thread stripes for hot tracks
+     */
+    void enableConcurrentPlays(int stripeCount = 8);
+
+    /**
+     * Check whether concurrent play counting is enabled
+     * @return true after enableConcurrentPlays()
+     */
+    bool hasConcurrentPlays() const;
+
+    /**
+     * Give a heavily played track per-thread striped counters
+     * (only has an effect in concurrent mode)
+     * @param id Track id
+     */
+    void markHotTrack(int id);
+
+    /**
+     * Record every play count change in a write-ahead log (see
+     * playlog.h). applyPlayEvents() and collectConcurrentPlays() log
+     * their whole batch with one append; in concurrent mode plays are
+     * logged when they are collected.
+     * @param log Open log (not owned), or NULL to stop logging
+     */
+    void attachPlayLog(PlayLog* log);
+
+    /**
+     * Check whether a play log is attached
+     * @return true after attachPlayLog() with a log
+     */
+    bool hasPlayLog() const;
+
+    /**
+     * Start recording which tracks change: added tracks, setTitle(),
+     * setDuration(), setGenre() and every play count change. Used for
+     * incremental checkpoints (see checkpoint.h). In concurrent mode
+     * plays are recorded when they are collected.
+     */
+    void enableChangeTracking();
+
+    /**
+     * Check whether change tracking is enabled
+     * @return true after enableChangeTracking()
+     */
+    bool hasChangeTracking() const;
+
+    /**
+     * Get the tracks changed since tracking started or the last
+     * clearChangedTracks()
+     * @return Set of track ids (empty when tracking is off)
+     */
+    TrackBitmap changedTracks() const;
+
+    /**
+     * Forget the recorded changes, e.g. once they are checkpointed
+     */
+    void clearChangedTracks();
+
+    /**
+     * Fold the plays counted concurrently into the play count column,
+     * so that playCountData() scans see them. Plays recorded while this
+     * runs are kept for the next call. Call from a single thread.
+     */
+    void collectConcurrentPlays();
+
+    /**
+     * Build a PopularityIndex over the current play counts and keep it
+     * up to date from then on. In concurrent mode the index sees plays
+     * once collectConcurrentPlays() folds them into the column.
+     */
+    void enablePopularityIndex();
+
+    /**
+     * Check whether the popularity index is enabled
+     * @return true after enablePopularityIndex()
+     */
+    bool hasPopularityIndex() const;
+
+    /**
+     * Get the most played tracks (needs enablePopularityIndex())
+     * @param k Number of tracks wanted
+     * @return Up to k track ids, most played first
+     */
+    vector<int> topTracks(int k) const;
+
+    /**
+     * Get every track with more plays than a threshold
+     * (needs enablePopularityIndex())
+     * @param threshold Play count to beat; 1000000 lists the popular tracks
+     * @return Track ids, most played first
+     */
+    vector<int> tracksAbove(int threshold) const;
+
+    /**
+     * Get the popularity rank of a track (needs enablePopularityIndex())
+     * @param id Track id
+     * @return 1 for the most played track, 0 if unknown
+     */
+    int getPopularityRank(int id) const;
+
+    /**
+     * Build one TrackBitmap per genre and keep them up to date as
+     * tracks are added and setGenre() moves them
+     */
+    void enableGenreIndex();
+
+    /**
+     * Check whether the genre index is enabled
+     * @return true after enableGenreIndex()
+     */
+    bool hasGenreIndex() const;
+
+    /**
+     * Get every track of a genre. Uses the genre index when enabled,
+     * otherwise scans the genre id column.
+     * @param g Genre name (empty means "Unknown")
+     * @return Set of track ids
+     */
+    TrackBitmap findByGenre(const string& g) const;
+
+    /**
+     * Get every track whose duration is inside a range (column scan)
+     * @param minSeconds Shortest duration to keep
+     * @param maxSeconds Longest duration to keep
+     * @return Set of track ids
+     */
+    TrackBitmap findByDuration(int minSeconds, int maxSeconds) const;
+
+    /**
+     * Narrow a set of tracks down to a duration range. Only the
+     * durations of tracks in the set are read.
+     * @param tracks Candidate tracks, e.g. from findByGenre()
+     * @param minSeconds Shortest duration to keep
+     * @param maxSeconds Longest duration to keep
+     * @return Set of track ids
+     */
+    TrackBitmap filterByDuration(const TrackBitmap& tracks, int minSeconds, int maxSeconds) const;
+
+    /**
+     * Sort the titles into a TitleIndex and keep it up to date as
+     * tracks are added and setTitle() renames them
+     */
+    void enableTitleIndex();
+
+    /**
+     * Check whether the title index is enabled
+     * @return true after enableTitleIndex()
+     */
+    bool hasTitleIndex() const;
+
+    /**
+     * Find a track by its exact title (byte for byte). Uses the title
+     * index when enabled, otherwise scans the title column.
+     * @param t Title to look for
+     * @return Lowest id with that title, or -1
+     */
+    int findTitle(const string& t) const;
+
+    /**
+     * List tracks whose title starts with a prefix, in title order
+     * (needs enableTitleIndex())
+     * @param prefix Typed text, e.g. "Où" or "J'me"
+     * @param limit Maximum number of tracks to return
+     * @return Track ids
+     */
+    vector<int> findTitlePrefix(const string& prefix, int limit) const;
+
+    /**
+     * Count every play from now on in per-track minute, hour and day
+     * windows (see playwindows.h). play(), applyPlayEvents() and
+     * collected concurrent plays are counted; setPlayCount() and
+     * resetPlayCount() only change the lifetime count.
+     * @param clock Time source in seconds, or NULL for monotonicSeconds()
+     */
+    void enablePlayWindows(PlayWindowClock clock = NULL);
+
+    /**
+     * Check whether play windows are enabled
+     * @return true after enablePlayWindows()
+     */
+    bool hasPlayWindows() const;
+
+    /**
+     * Get the recent plays of a track (needs enablePlayWindows())
+     * @param id Track id
+     * @param window Last minute, hour or day
+     * @return Plays in the window, 0 if unknown
+     */
+    long long getRecentPlays(int id, PlayWindow window) const;
+
+    /**
+     * Get the tracks gaining plays fastest right now: most plays in
+     * the last hour compared with their average hour over the day
+     * (needs enablePlayWindows())
+     * @param k Number of tracks wanted
+     * @return Up to k track ids, fastest rising first
+     */
+    vector<int> trendingTracks(int k) const;
+
+private:
+    // Numeric columns - one entry per track
+    vector<int> durations;
+    vector<int> playCounts;
+    vector<int> genreIds;
+
+    // Title column - each handle points into titleArena
+    vector<TitleHandle> titles;
+    TitleArena titleArena;
+
+    // Genre dictionary for genreIds (ids are local to this catalog)
+    GenreTable genres;
+
+    // Pending plays in concurrent mode, NULL otherwise
+    ConcurrentPlayCounter* concurrentPlays;
+
+    // Tracks ordered by play count, NULL until enabled
+    PopularityIndex* popularity;
+
+    // Track ids per genre id, NULL until enabled
+    vector<TrackBitmap>* genreTracks;
+
+    // Sorted titles, NULL until enabled
+    TitleIndex* titleIndex;
+
+    // Write-ahead log of play count changes, NULL unless attached (not owned)
+    PlayLog* playLog;
+    vector<PlayEvent> playLogBatch;
+
+    // Tracks changed since the last checkpoint, NULL until enabled
+    TrackBitmap* changed;
+
+    // Recent plays per track, NULL until enabled
+    PlayWindows* windows;
+
+    void storePlayCount(int id, int count);
+    void queuePlayLogChange(int id, int count);
+    void flushPlayLogChanges();
+    void writePlayCount(int id, int count);
+    void markChanged(int id);
+    int appendTrack(const char* t, int titleLength, int d, int genreId);
+
+    // Catalogs are large and own a play counter - disable copying
+    TrackCatalog(const TrackCatalog&);
+    TrackCatalog& operator=(const TrackCatalog&);
+};
+
+#endif
@@ -0,0 +1,195 @@
+#include "trackpool.h"
+#include <new>
+using namespace std;
+
+// Construction and destruction
+
+MusicTrackPool::MusicTrackPool(int slabSize) : slabSize(slabSize > 0 ? slabSize : 1024), liveTracks(0) {
+}
+
+MusicTrackPool::~MusicTrackPool() {
+    for (int slot = 0; slot < (int)live.size(); slot++) {
+        if (live[slot]) {
+            slotAddress(slot)->~MusicTrack();
+        }
+    }
+    for (size_t i = 0; i < slabs.size(); i++) {
+        operator delete(slabs[i]);
+    }
+}
+
+// Slabs and slots
+
+/**
+ * Add Slab
+ * Raw storage from operator new is aligned for any type, and
+ * sizeof(MusicTrack) is a multiple of its alignment, so every slot is
+ * aligned too. Free slots are pushed high to low so the slab fills
+ * from its start.
+ */
+void MusicTrackPool::addSlab() {
+    char* storage = (char*)operator new((size_t)slabSize * sizeof(MusicTrack));
+    int first = (int)live.size();
+    slabIndex[storage] = (int)slabs.size();
+    slabs.push_back(storage);
+    live.resize(live.size() + slabSize, 0);
+    TitleHandle noSpace = { 0, 0 };
+    slotTitles.resize(live.size(), noSpace);
+
+    // Room for every slot, so release() never allocates
+    freeSlots.reserve(live.size());
+    for (int i = slabSize - 1; i >= 0; i--) {
+        freeSlots.push_back(first + i);
+    }
+}
+
+/**
+ * Next Slot
+ * The slot stays on the free list until its track is constructed, so a
+ * constructor that throws leaves the pool unchanged
+ */
+int MusicTrackPool::nextSlot() {
+    if (freeSlots.empty()) {
+        addSlab();
+    }
+    return freeSlots.back();
+}
+
+void MusicTrackPool::markLive(int slot) {
+    freeSlots.pop_back();
+    live[slot] = 1;
+    liveTracks++;
+}
+
+MusicTrack* MusicTrackPool::slotAddress(int slot) const {
+    return (MusicTrack*)(slabs[slot / slabSize] + (size_t)(slot % slabSize) * sizeof(MusicTrack));
+}
+
+/**
+ * Find Slot
+ * The slab holding a track is the one with the highest start address
+ * not above it
+ * @return Slot number, or -1 if the track is not in this pool
+ */
+int MusicTrackPool::findSlot(const MusicTrack* track) const {
+    const char* address = (const char*)track;
+    map<const char*, int>::const_iterator it = slabIndex.upper_bound(address);
+    if (it == slabIndex.begin()) {
+        return -1;
+    }
+    --it;
+    size_t offset = address - it->first;
+    if (offset >= (size_t)slabSize * sizeof(MusicTrack) || offset % sizeof(MusicTrack) != 0) {
+        return -1;
+    }
+    return it->second * slabSize + (int)(offset / sizeof(MusicTrack));
+}
+
+// Creating tracks
+
+MusicTrack* MusicTrackPool::create(const string& t, int d, const string& g) {
+    static const char untitled[] = "Untitled Track";
+    int slot = nextSlot();
+    TitleHandle title = t.empty() ? titles.store(slotTitles[slot], untitled, (int)sizeof(untitled) - 1)
+                                  : titles.store(slotTitles[slot], t.data(), (int)t.size());
+    MusicTrack* track = new (slotAddress(slot)) MusicTrack(titles, title, d, g);
+    markLive(slot);
+    return track;
+}
+
+/**
+ * Create (copy)
+ * The title goes into the slot's own space even when the source is a
+ * track of this pool, whose slot may be reused later
+ */
+MusicTrack* MusicTrackPool::create(const MusicTrack& source) {
+    int slot = nextSlot();
+    int length = 0;
+    const char* text = source.getTitleData(&length);
+    TitleHandle title = titles.store(slotTitles[slot], text, length);
+    MusicTrack* track = new (slotAddress(slot)) MusicTrack(titles, title, source);
+    markLive(slot);
+    return track;
+}
+
+void MusicTrackPool::createMany(const MusicTrack* sources, int count, MusicTrack** out) {
+    if (sources == NULL || out == NULL || count <= 0) {
+        return;
+    }
+    reserve(count);
+    for (int i = 0; i < count; i++) {
+        out[i] = create(sources[i]);
+    }
+}
+
+void MusicTrackPool::reserve(int count) {
+    while ((int)freeSlots.size() < count) {
+        addSlab();
+    }
+}
+
+// Releasing tracks
+
+void MusicTrackPool::release(MusicTrack* track) {
+    if (track == NULL) {
+        return;
+    }
+    int slot = findSlot(track);
+    if (slot < 0 || !live[slot]) {
+        return;
+    }
+    track->~MusicTrack();
+    live[slot] = 0;
+    freeSlots.push_back(slot);
+    liveTracks--;
+}
+
+void MusicTrackPool::releaseMany(MusicTrack** tracks, int count) {
+    if (tracks == NULL) {
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        release(tracks[i]);
+    }
+}
+
+/**
+ * Release All
+ * One pass over the live flags instead of a lookup per track; the
+ * free list is rebuilt in slab order. With no track left the arena
+ * starts over, dropping renamed titles and outgrown slot space.
+ */
+void MusicTrackPool::releaseAll() {
+    for (int slot = 0; slot < (int)live.size(); slot++) {
+        if (live[slot]) {
+            slotAddress(slot)->~MusicTrack();
+            live[slot] = 0;
+        }
+    }
+    freeSlots.clear();
+    for (int slot = (int)live.size() - 1; slot >= 0; slot--) {
+        freeSlots.push_back(slot);
+    }
+    liveTracks = 0;
+    titles.rewind();
+    TitleHandle noSpace = { 0, 0 };
+    slotTitles.assign(slotTitles.size(), noSpace);
+}
+
+// Statistics
+
+int MusicTrackPool::liveCount() const {
+    return liveTracks;
+}
+
+int MusicTrackPool::capacity() const {
+    return (int)live.size();
+}
+
+int MusicTrackPool::slabCount() const {
+    return (int)slabs.size();
+}
+
+size_t MusicTrackPool::memoryBytes() const {
+    return slabs.size() * (size_t)slabSize * sizeof(MusicTrack) + titles.bytesUsed();
+}
@@ -0,0 +1,148 @@
+#ifndef TRACKPOOL_H
+#define TRACKPOOL_H
+
+#include <map>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include "musictrack.h"
+#include "titlearena.h"
+using namespace std;
+
+/**
+ * MusicTrackPool Class - Maître Gims Studio Management System
+ *
+ * Typed slab allocator for services that build many short-lived
+ * MusicTrack objects (one per request, per import row, per report)
+ * and throw them away soon after.
+ *
+ * Tracks are constructed in place in slabs of slabSize slots, and the
+ * slots of released tracks are handed out again, so after warm-up a
+ * create() makes no call to operator new. Titles go into the pool's
+ * TitleArena instead of their own strings, so a pool track holds no
+ * heap memory of its own and destroying it frees nothing. releaseAll()
+ * destroys every live track at once and keeps the slabs for the next
+ * batch.
+ *
+ * Each slot keeps its own title space in the arena and the next track
+ * in that slot writes over it (see TitleArena::store()), so the arena
+ * stays bounded by the slots however many tracks come and go. Only
+ * setTitle() on a pool track appends a new title, like on any arena
+ * track; releaseAll() reclaims that too. Plain copies of pool tracks
+ * own their titles, so they outlive the track and the pool.
+ * Not thread-safe.
+ */
+class MusicTrackPool {
+public:
+    /**
+     * Constructor
+     * No memory is allocated until the first create()
+     * @param slabSize Tracks per slab (defaults to 1024 if not positive)
+     */
+    explicit MusicTrackPool(int slabSize = 1024);
+
+    /**
+     * Destructor
+     * Destroys every live track and frees the slabs
+     */
+    ~MusicTrackPool();
+
+    /**
+     * Create a track, with the same validation as the MusicTrack
+     * parameterized constructor
+     * @param t Track title
+     * @param d Duration in seconds
+     * @param g Genre of the track
+     * @return New track, owned by the pool
+     */
+    MusicTrack* create(const string& t, int d, const string& g);
+
+    /**
+     * Create a copy of a track (the copy's title lives in the pool)
+     * @param source Track to copy, from this pool or anywhere else
+     * @return New track, owned by the pool
+     */
+    MusicTrack* create(const MusicTrack& source);
+
+    /**
+     * Create copies of count tracks at once; slabs are added up front
+     * for the whole batch
+     * @param sources Tracks to copy
+     * @param count Number of tracks
+     * @param out Receives the count new tracks, in order
+     */
+    void createMany(const MusicTrack* sources, int count, MusicTrack** out);
+
+    /**
+     * Destroy a track and recycle its slot and its title space. Tracks
+     * that are NULL, already released or from another pool are ignored
+     * @param track Track returned by create()
+     */
+    void release(MusicTrack* track);
+
+    /**
+     * Destroy count tracks at once
+     * @param tracks Tracks returned by create() or createMany()
+     * @param count Number of tracks
+     */
+    void releaseMany(MusicTrack** tracks, int count);
+
+    /**
+     * Destroy every live track and drop the pool's titles; the slabs
+     * and the arena's buffer are kept for the next batch
+     */
+    void releaseAll();
+
+    /**
+     * Make room for count more tracks, so a batch of that size needs
+     * no further slabs
+     * @param count Number of tracks about to be created
+     */
+    void reserve(int count);
+
+    /**
+     * Get the number of tracks created and not yet released
+     * @return Live tracks
+     */
+    int liveCount() const;
+
+    /**
+     * Get the number of slots in all slabs
+     * @return Tracks the pool can hold without allocating a slab
+     */
+    int capacity() const;
+
+    /**
+     * Get the number of slabs allocated
+     * @return Slab count
+     */
+    int slabCount() const;
+
+    /**
+     * Get the number of bytes in the slabs and the pool's titles
+     * @return Bytes used by the pool
+     */
+    size_t memoryBytes() const;
+
+private:
+    int slabSize;
+    vector<char*> slabs;                // slabSize * sizeof(MusicTrack) bytes each
+    map<const char*, int> slabIndex;    // slab start -> position in slabs
+    vector<unsigned char> live;         // one flag per slot, slot = slab * slabSize + i
+    vector<int> freeSlots;              // unused slots, the next one at the back
+    vector<TitleHandle> slotTitles;     // title space of each slot in titles
+    int liveTracks;
+    TitleArena titles;
+
+    void addSlab();
+    int nextSlot();
+    void markLive(int slot);
+    MusicTrack* slotAddress(int slot) const;
+    int findSlot(const MusicTrack* track) const;
+
+    // A pool owns its slabs - disable copying
+    MusicTrackPool(const MusicTrackPool&);
+    MusicTrackPool& operator=(const MusicTrackPool&);
+};
+
+#endif
@@ -0,0 +1,163 @@
+#include "trackreport.h"
+#include "durationformat.h"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+using namespace std;
+
+// Layout pieces, matching displayTrackInfo() in main.cpp
+static const char TRACK_LABEL[] = "🎵 Track: ";
+static const char DURATION_LABEL[] = "\n   Duration: ";
+static const char SECONDS_OPEN[] = " (";
+static const char SECONDS_CLOSE[] = " seconds)\n   Genre: ";
+static const char PLAY_COUNT_LABEL[] = "\n   Play Count: ";
+static const char POPULAR_YES[] = "\n   Popular: Yes\n\n";
+static const char POPULAR_NO[] = "\n   Popular: No\n\n";
+
+// Smallest buffer the writer will use
+static const size_t MIN_BUFFER_SIZE = 4096;
+
+/**
+ * Constructor
+ * The buffer is allocated once and reused for the writer's lifetime
+ */
+TrackReportWriter::TrackReportWriter(int outputFd, size_t bufferSize)
+    : fd(outputFd), buffer(bufferSize < MIN_BUFFER_SIZE ? MIN_BUFFER_SIZE : bufferSize),
+      used(0), bytesWritten(0), failed(false) {
+}
+
+TrackReportWriter::~TrackReportWriter() {
+    flush();
+}
+
+/**
+ * Write Track (MusicTrack)
+ * Reads the title in place, wherever the track stores it
+ */
+void TrackReportWriter::writeTrack(const MusicTrack& track) {
+    int titleLength = 0;
+    const char* title = track.getTitleData(&titleLength);
+    appendRecord(title, titleLength, track.getDuration(), track.getGenre(),
+                 track.getPlayCount(), track.isPopular());
+}
+
+void TrackReportWriter::writeTrack(const TrackCatalog& catalog, int id) {
+    if (!catalog.isValidId(id)) {
+        return;
+    }
+    int titleLength = 0;
+    const char* title = catalog.getTitleData(id, &titleLength);
+    int playCount = catalog.getPlayCount(id);
+    appendRecord(title, titleLength, catalog.getDuration(id), catalog.getGenre(id),
+                 playCount, playCount > 1000000);
+}
+
+void TrackReportWriter::writeCatalog(const TrackCatalog& catalog) {
+    int trackCount = catalog.size();
+    for (int id = 0; id < trackCount; id++) {
+        writeTrack(catalog, id);
+    }
+}
+
+void TrackReportWriter::writeText(const char* text, size_t length) {
+    append(text, length);
+}
+
+void TrackReportWriter::writeText(const string& text) {
+    append(text.data(), text.size());
+}
+
+bool TrackReportWriter::flush() {
+    if (used > 0) {
+        writeAll(&buffer[0], used);
+        used = 0;
+    }
+    return !failed;
+}
+
+bool TrackReportWriter::hasFailed() const {
+    return failed;
+}
+
+long long TrackReportWriter::getBytesWritten() const {
+    return bytesWritten;
+}
+
+// Private helpers
+
+/**
+ * Append
+ * Text that does not fit goes out with the buffer; text larger than
+ * the whole buffer is written straight through
+ */
+void TrackReportWriter::append(const char* text, size_t length) {
+    if (used + length > buffer.size()) {
+        flush();
+        if (length > buffer.size()) {
+            writeAll(text, length);
+            return;
+        }
+    }
+    if (length > 0) {
+        memcpy(&buffer[used], text, length);
+        used += length;
+    }
+}
+
+void TrackReportWriter::appendNumber(long long value) {
+    char digits[24];
+    int position = sizeof(digits);
+    bool negative = value < 0;
+    unsigned long long magnitude = negative ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        digits[--position] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (negative) {
+        digits[--position] = '-';
+    }
+    append(digits + position, sizeof(digits) - position);
+}
+
+void TrackReportWriter::appendRecord(const char* title, size_t titleLength, int duration,
+                                     const string& genre, int playCount, bool popular) {
+    char formatted[DURATION_TEXT_SIZE];
+    int formattedLength = formatDuration(duration, formatted, DURATION_TEXT_SIZE);
+
+    append(TRACK_LABEL, sizeof(TRACK_LABEL) - 1);
+    append(title, titleLength);
+    append(DURATION_LABEL, sizeof(DURATION_LABEL) - 1);
+    append(formatted, formattedLength > 0 ? formattedLength : 0);
+    append(SECONDS_OPEN, sizeof(SECONDS_OPEN) - 1);
+    appendNumber(duration);
+    append(SECONDS_CLOSE, sizeof(SECONDS_CLOSE) - 1);
+    append(genre.data(), genre.size());
+    append(PLAY_COUNT_LABEL, sizeof(PLAY_COUNT_LABEL) - 1);
+    appendNumber(playCount);
+    if (popular) {
+        append(POPULAR_YES, sizeof(POPULAR_YES) - 1);
+    } else {
+        append(POPULAR_NO, sizeof(POPULAR_NO) - 1);
+    }
+}
+
+/**
+ * Write All
+ * Loop over short writes and EINTR; any other error marks the writer
+ * failed and drops the rest of the report
+ */
+void TrackReportWriter::writeAll(const char* data, size_t length) {
+    while (length > 0 && !failed) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            failed = true;
+        } else {
+            data += written;
+            length -= (size_t)written;
+            bytesWritten += written;
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef TRACKREPORT_H
+#define TRACKREPORT_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "musictrack.h"
+#include "trackcatalog.h"
+using namespace std;
+
+/**
+ * TrackReportWriter Class - Maître Gims Studio Management System
+ *
+ * Renders track reports in the same layout as displayTrackInfo() in
+ * main.cpp:
+ *
+ *   🎵 Track: Bella
+ *      Duration: 3:26 (206 seconds)
+ *      Genre: Hip-Hop
+ *      Play Count: 1500000
+ *      Popular: Yes
+ *   (blank line)
+ *
+ * Text is appended to one reusable buffer, with no string copies and
+ * no heap allocation per track, and written to a file descriptor only
+ * when the buffer fills up (or on flush()), so a million-track report
+ * costs a few hundred write() calls instead of millions of flushes.
+ *
+ * Usage:
+ *   TrackReportWriter report(STDOUT_FILENO);
+ *   report.writeCatalog(catalog);
+ *   report.flush();
+ *
+ * If a write() fails, the writer stops writing and hasFailed() turns
+ * true; the destructor flushes whatever is left.
+ */
+class TrackReportWriter {
+public:
+    static const size_t DEFAULT_BUFFER_SIZE = 256 * 1024;
+
+    /**
+     * Constructor
+     * @param fd File descriptor to write to (not closed by the writer)
+     * @param bufferSize Output buffer size in bytes (at least 4 KB is used)
+     */
+    explicit TrackReportWriter(int fd, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Destructor
+     * Flushes any buffered text
+     */
+    ~TrackReportWriter();
+
+    /**
+     * Render one track
+     * @param track Track to report
+     */
+    void writeTrack(const MusicTrack& track);
+
+    /**
+     * Render one catalog track, reading its columns in place
+     * @param catalog Catalog holding the track
+     * @param id Track id (invalid ids are skipped)
+     */
+    void writeTrack(const TrackCatalog& catalog, int id);
+
+    /**
+     * Render every track of a catalog, in id order
+     * @param catalog Catalog to report
+     */
+    void writeCatalog(const TrackCatalog& catalog);
+
+    /**
+     * Append raw text (headings, separators)
+     * @param text Bytes to append
+     * @param length Number of bytes
+     */
+    void writeText(const char* text, size_t length);
+    void writeText(const string& text);
+
+    /**
+     * Write all buffered text to the file descriptor
+     * @return false if a write has failed
+     */
+    bool flush();
+
+    /**
+     * Check whether a write to the file descriptor has failed
+     * @return true after the first failed write()
+     */
+    bool hasFailed() const;
+
+    /**
+     * Get the number of bytes handed to the file descriptor so far
+     * @return Bytes written (not counting text still buffered)
+     */
+    long long getBytesWritten() const;
+
+private:
+    int fd;
+    vector<char> buffer;
+    size_t used;
+    long long bytesWritten;
+    bool failed;
+
+    void append(const char* text, size_t length);
+    void appendNumber(long long value);
+    void appendRecord(const char* title, size_t titleLength, int duration,
+                      const string& genre, int playCount, bool popular);
+    void writeAll(const char* data, size_t length);
+
+    // Not copyable: two writers would interleave one buffer's text
+    TrackReportWriter(const TrackReportWriter&);
+    TrackReportWriter& operator=(const TrackReportWriter&);
+};
+
+#endif
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <cassert>
+#include <climits>
+#include <string>
+#include <vector>
+#include <map>
+#include "../src/genreaggregator.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+// Serial reference: the loop the reports used to run
+map<string, GenreTotals> serialTotals(const TrackCatalog& catalog) {
+    map<string, GenreTotals> totals;
+    for (int i = 0; i < catalog.size(); i++) {
+        if (totals.find(catalog.getGenre(i)) == totals.end()) {
+            GenreTotals empty = { -1, catalog.getGenre(i), 0, 0, 0 };
+            totals[catalog.getGenre(i)] = empty;
+        }
+        GenreTotals& genre = totals[catalog.getGenre(i)];
+        genre.trackCount++;
+        genre.totalPlays += catalog.getPlayCount(i);
+        genre.totalSeconds += catalog.getDuration(i);
+    }
+    return totals;
+}
+
+bool matchesSerial(const vector<GenreTotals>& totals, const TrackCatalog& catalog) {
+    map<string, GenreTotals> expected = serialTotals(catalog);
+    if (totals.size() != expected.size()) {
+        return false;
+    }
+    for (size_t g = 0; g < totals.size(); g++) {
+        map<string, GenreTotals>::const_iterator it = expected.find(totals[g].genre);
+        if (it == expected.end() || it->second.trackCount != totals[g].trackCount ||
+            it->second.totalPlays != totals[g].totalPlays || it->second.totalSeconds != totals[g].totalSeconds) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_small_catalog() {
+    cout << "\n🧪 Testing Genre Totals..." << endl;
+
+    TrackCatalog catalog;
+    GenreAggregator aggregator(catalog);
+    test_assert(aggregator.aggregate().empty(), "Empty catalog should have no totals");
+
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");
+    catalog.addTrack("Zombie", 223, "Hip-Hop");
+    catalog.addTrack("Où aller", 267, "R&B");
+    catalog.setPlayCount(0, 1500000);
+    catalog.setPlayCount(1, 50000);
+    catalog.setPlayCount(2, 500000);
+
+    vector<GenreTotals> totals = aggregator.aggregate();
+    test_assert(totals.size() == 3, "One entry per genre");
+    test_assert(totals[0].genre == "Hip-Hop" && totals[0].trackCount == 2 &&
+                totals[0].totalPlays == 2000000 && totals[0].totalSeconds == 429,
+                "Hip-Hop totals should add up both tracks");
+    test_assert(totals[0].averagePlays() == 1000000.0 && totals[0].averageSeconds() == 214.5,
+                "Averages should divide by the track count");
+    test_assert(totals[2].genre == "R&B" && totals[2].totalPlays == 0, "Unplayed genre should total 0 plays");
+
+    // Genres no track uses any more are left out
+    catalog.setGenre(3, "Pop");
+    totals = aggregator.aggregate();
+    test_assert(totals.size() == 2 && totals[1].genre == "Pop" && totals[1].trackCount == 2,
+                "Genres without tracks should be skipped");
+}
+
+void test_large_sums() {
+    cout << "\n🧪 Testing 64-bit Sums..." << endl;
+
+    TrackCatalog catalog;
+    for (int i = 0; i < 1000; i++) {
+        int id = catalog.addTrack("Sapés comme jamais", INT_MAX, "Pop");
+        catalog.setPlayCount(id, INT_MAX);
+    }
+    vector<GenreTotals> totals = GenreAggregator(catalog).aggregate();
+    test_assert(totals.size() == 1 && totals[0].totalPlays == 1000LL * INT_MAX,
+                "Play totals should not overflow int");
+    test_assert(totals[0].totalSeconds == 1000LL * INT_MAX, "Runtime totals should not overflow int");
+    test_assert(totals[0].averagePlays() == (double)INT_MAX, "Average should stay exact");
+}
+
+void test_threaded_aggregation() {
+    cout << "\n🧪 Testing Threaded Aggregation..." << endl;
+
+    const int NUM_TRACKS = 600000;
+    const char* GENRES[] = { "Hip-Hop", "Pop", "R&B", "Rap", "Afro-Trap" };
+    TrackCatalog catalog;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        int id = catalog.addTrack("Track", 60 + i % 500, GENRES[(i * 7) % 5]);
+        catalog.setPlayCount(id, (int)((long long)i * 7919 % 3000000));
+    }
+
+    GenreAggregator aggregator(catalog);
+    test_assert(aggregator.getThreadCount() >= 1, "Default thread count should be at least 1");
+
+    aggregator.setThreadCount(1);
+    vector<GenreTotals> serial = aggregator.aggregate();
+    test_assert(matchesSerial(serial, catalog), "One thread should match the serial loop");
+
+    bool allMatch = true;
+    int counts[] = { 2, 3, 7, 64 };
+    for (int c = 0; c < 4; c++) {
+        aggregator.setThreadCount(counts[c]);
+        vector<GenreTotals> threaded = aggregator.aggregate();
+        allMatch = allMatch && matchesSerial(threaded, catalog);
+    }
+    test_assert(allMatch, "Any thread count should match the serial loop");
+
+    aggregator.setThreadCount(1000);
+    test_assert(aggregator.getThreadCount() == 64, "Thread count should be clamped to 64");
+
+    // Concurrent plays count once they are collected
+    catalog.enableConcurrentPlays();
+    for (int i = 0; i < 1000; i++) {
+        catalog.play(i);
+    }
+    catalog.collectConcurrentPlays();
+    test_assert(matchesSerial(aggregator.aggregate(), catalog), "Collected concurrent plays should be included");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Genre Aggregation Tests" << endl;
+    cout << "=====================================================" << endl;
+
+    test_small_catalog();
+    test_large_sums();
+    test_threaded_aggregation();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All genre aggregation tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some genre aggregation tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
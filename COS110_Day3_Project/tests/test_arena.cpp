@@ -0,0 +1,221 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <sstream>
+#include <vector>
+#include "../src/musictrack.h"
+#include "../src/titlearena.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// GCC cannot tell that the replacement operators below pair malloc/free
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+// Count every heap allocation made by the test program
+static long allocationCount = 0;
+
+#if __cplusplus >= 201103L
+void* operator new(size_t size) {
+#else
+void* operator new(size_t size) throw(bad_alloc) {
+#endif
+    allocationCount++;
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == NULL) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) throw() {
+    free(memory);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+#endif
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+void test_arena_basics() {
+    cout << "\n🧪 Testing Title Arena..." << endl;
+
+    TitleArena arena;
+    TitleHandle bella = arena.append("Bella");
+    TitleHandle ouAller = arena.append("Où aller");
+
+    test_assert(arena.get(bella) == "Bella", "Stored title should be returned");
+    test_assert(arena.get(ouAller) == "Où aller", "Accented title should be stored byte for byte");
+    test_assert(bella.offset == 0 && ouAller.offset == (size_t)bella.length, "Titles should be packed back to back");
+    test_assert(arena.bytesUsed() == bella.length + (size_t)ouAller.length, "bytesUsed() should count every byte");
+
+    TitleHandle zombie = arena.replace(bella, "Zombie");
+    test_assert(arena.get(zombie) == "Zombie", "replace() should store the new title");
+    test_assert(arena.get(ouAller) == "Où aller", "replace() should not disturb other titles");
+    test_assert(arena.wastedBytes() == 5, "replace() should count the old bytes as waste");
+
+    TitleHandle empty = arena.append("");
+    test_assert(arena.get(empty) == "" && arena.data(empty) == NULL, "Empty title should give an empty handle");
+
+    // Owner-kept space is overwritten in place and only grows when outgrown
+    TitleHandle space = { 0, 0 };
+    TitleHandle first = arena.store(space, "Bella", 5);
+    size_t used = arena.bytesUsed();
+    TitleHandle second = arena.store(space, "Zombie", 6);
+    test_assert(arena.get(second) == "Zombie" && second.offset == first.offset && arena.bytesUsed() == used &&
+                space.length == 16, "store() should reuse space that fits");
+    string longTitle(40, 'x');
+    TitleHandle third = arena.store(space, longTitle.data(), 40);
+    test_assert(arena.get(third) == longTitle && space.length == 64 && arena.wastedBytes() == 5 + 16,
+                "store() should grow outgrown space by powers of two");
+    TitleHandle other = { 0, 0 };
+    TitleHandle copy = arena.store(other, arena.data(third), third.length);
+    test_assert(arena.get(copy) == longTitle, "store() should copy a title from the same arena");
+    TitleHandle again = arena.append(arena.data(ouAller), ouAller.length);
+    test_assert(arena.get(again) == "Où aller" && again.offset != ouAller.offset,
+                "append() should copy a title from the same arena");
+
+    arena.clear();
+    test_assert(arena.bytesUsed() == 0 && arena.wastedBytes() == 0, "clear() should drop everything");
+}
+
+void test_musictrack_arena_policy() {
+    cout << "\n🧪 Testing MusicTrack Arena Storage..." << endl;
+
+    TitleArena arena;
+    MusicTrack zombie(arena, "Zombie", 223, "Hip-Hop");
+    MusicTrack untitled(arena, "", -5, "");
+    MusicTrack plain("Bella", 206, "Hip-Hop");
+
+    test_assert(zombie.usesTitleArena() && !plain.usesTitleArena(), "Storage policy should follow the constructor");
+    test_assert(zombie.getTitle() == "Zombie", "Arena title should be returned");
+    test_assert(zombie.getDuration() == 223 && zombie.getGenre() == "Hip-Hop", "Other fields should be unaffected");
+    test_assert(untitled.getTitle() == "Untitled Track", "Empty arena title should default to 'Untitled Track'");
+    test_assert(untitled.getDuration() == 180 && untitled.getGenre() == "Unknown", "Arena constructor should validate");
+
+    size_t before = arena.bytesUsed();
+    zombie.setTitle("J'me tire");
+    test_assert(zombie.getTitle() == "J'me tire", "setTitle() should rewrite into the arena");
+    test_assert(arena.bytesUsed() > before, "setTitle() should append to the arena");
+
+    zombie.setTitle("");
+    test_assert(zombie.getTitle() == "Untitled Track", "setTitle('') should keep the 'Untitled Track' fallback");
+
+    MusicTrack copy = zombie;
+    copy.setTitle("Tout donner");
+    test_assert(zombie.getTitle() == "Untitled Track" && copy.getTitle() == "Tout donner",
+                "Copies should keep independent titles");
+
+    // A same-arena copy has its own bytes, so waste never counts bytes in use
+    MusicTrack sibling(arena, zombie);
+    sibling.setTitle("Est-ce que tu m'aimes");
+    int zombieLength = 0;
+    int untitledLength = 0;
+    int siblingLength = 0;
+    zombie.getTitleData(&zombieLength);
+    untitled.getTitleData(&untitledLength);
+    sibling.getTitleData(&siblingLength);
+    test_assert(zombie.getTitle() == "Untitled Track" && sibling.getTitle() == "Est-ce que tu m'aimes" &&
+                arena.wastedBytes() + zombieLength + untitledLength + siblingLength == arena.bytesUsed(),
+                "Same-arena copies should not share bytes counted as waste");
+
+    // Copies own their titles, so rewriting or dropping the arena cannot change them
+    TitleArena* scratch = new TitleArena();
+    MusicTrack bella(*scratch, "Bella", 206, "Hip-Hop");
+    MusicTrack copied(bella);
+    MusicTrack assigned;
+    assigned = bella;
+    scratch->rewind();
+    scratch->append("Zombie");
+    delete scratch;
+    test_assert(!copied.usesTitleArena() && !assigned.usesTitleArena() && copied.getTitle() == "Bella" &&
+                assigned.getTitle() == "Bella", "Copies should keep their titles after the arena changes");
+
+    int length = 0;
+    const char* data = plain.getTitleData(&length);
+    test_assert(length == 5 && string(data, length) == "Bella", "getTitleData() should point at the title");
+}
+
+void test_bulk_load_allocations() {
+    cout << "\n🧪 Testing Bulk Load Allocations..." << endl;
+
+    const int NUM_TRACKS = 20000;
+    vector<string> names;
+    names.reserve(NUM_TRACKS);
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "Sapés Comme Jamais - live take number " << i;
+        names.push_back(ss.str());
+    }
+
+    long before = allocationCount;
+    TrackCatalog* catalog = new TrackCatalog();
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        catalog->addTrack(names[i], 200, "Hip-Hop");
+    }
+    long used = allocationCount - before;
+    cout << "   " << NUM_TRACKS << " titles loaded with " << used << " allocations" << endl;
+
+    test_assert(catalog->getTitle(NUM_TRACKS - 1) == names[NUM_TRACKS - 1], "Last title should be stored correctly");
+    test_assert(used < 200, "Loading titles should take a handful of allocations, not one per title");
+
+    delete catalog;
+}
+
+void test_catalog_compaction() {
+    cout << "\n🧪 Testing Catalog Title Compaction..." << endl;
+
+    TrackCatalog catalog;
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    catalog.addTrack("Zombie", 223, "Hip-Hop");
+
+    for (int i = 0; i < 100; i++) {
+        stringstream ss;
+        ss << "Remix " << i;
+        catalog.setTitle(0, ss.str());
+    }
+    test_assert(catalog.titleWasteBytes() > 0, "Renames should leave waste behind");
+
+    catalog.compactTitles();
+    test_assert(catalog.titleWasteBytes() == 0, "compactTitles() should remove all waste");
+    test_assert(catalog.getTitle(0) == "Remix 99", "Renamed title should survive compaction");
+    test_assert(catalog.getTitle(1) == "Zombie", "Other titles should survive compaction");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Title Arena Tests" << endl;
+    cout << "==============================================" << endl;
+
+    test_arena_basics();
+    test_musictrack_arena_policy();
+    test_bulk_load_allocations();
+    test_catalog_compaction();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All title arena tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some title arena tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
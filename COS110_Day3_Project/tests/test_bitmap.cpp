@@ -0,0 +1,219 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <set>
+#include "../src/trackcatalog.h"
+#include "../src/trackbitmap.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+bool sameIds(const TrackBitmap& bitmap, const set<int>& expected) {
+    vector<int> ids;
+    bitmap.toIds(ids);
+    return bitmap.cardinality() == (int)expected.size() &&
+           vector<int>(expected.begin(), expected.end()) == ids;
+}
+
+void test_bitmap_basics() {
+    cout << "\n🧪 Testing TrackBitmap..." << endl;
+
+    TrackBitmap bitmap;
+    test_assert(bitmap.empty() && bitmap.cardinality() == 0, "New bitmap should be empty");
+
+    bitmap.add(5);
+    bitmap.add(70000);
+    bitmap.add(5);
+    bitmap.add(-1);
+    test_assert(bitmap.cardinality() == 2, "Duplicates and negative ids should be ignored");
+    test_assert(bitmap.contains(5) && bitmap.contains(70000) && !bitmap.contains(6), "contains() should find added ids");
+
+    bitmap.remove(70000);
+    bitmap.remove(123);
+    test_assert(bitmap.cardinality() == 1 && !bitmap.contains(70000), "remove() should drop an id");
+
+    // Grow one block past the sparse limit and back
+    set<int> expected;
+    expected.insert(5);
+    for (int id = 0; id < 20000; id += 2) {
+        bitmap.add(id);
+        expected.insert(id);
+    }
+    size_t denseBytes = bitmap.memoryBytes();
+    test_assert(sameIds(bitmap, expected), "Dense block should hold every id");
+    for (int id = 0; id < 20000; id += 4) {
+        bitmap.remove(id);
+        expected.erase(id);
+    }
+    test_assert(sameIds(bitmap, expected), "Removing from a dense block should keep the rest");
+    for (int id = 2; id < 20000; id += 8) {
+        bitmap.remove(id);
+        expected.erase(id);
+    }
+    test_assert(sameIds(bitmap, expected), "Block should go back to a sorted array");
+    for (int id = 1000; id < 20000; id++) {
+        bitmap.remove(id);
+        expected.erase(id);
+    }
+    test_assert(sameIds(bitmap, expected) && bitmap.memoryBytes() < denseBytes / 4,
+                "Shrinking block should give memory back");
+
+    TrackBitmap sparse;
+    for (int i = 0; i < 100; i++) {
+        sparse.add(i * 1000003 % 50000000);
+    }
+    test_assert(sparse.memoryBytes() < 100 * 100, "Scattered ids should stay small");
+}
+
+void test_set_operations() {
+    cout << "\n🧪 Testing Bitmap AND/OR..." << endl;
+
+    srand(110);
+    TrackBitmap a;
+    TrackBitmap b;
+    set<int> setA;
+    set<int> setB;
+    for (int i = 0; i < 60000; i++) {
+        int id = rand() % 300000;
+        a.add(id);
+        setA.insert(id);
+    }
+    for (int i = 0; i < 3000; i++) {
+        int id = rand() % 300000;
+        b.add(id);
+        setB.insert(id);
+    }
+    for (int id = 131072; id < 140000; id++) {   // dense in both
+        a.add(id);
+        b.add(id);
+        setA.insert(id);
+        setB.insert(id);
+    }
+
+    set<int> both;
+    set<int> either(setA);
+    either.insert(setB.begin(), setB.end());
+    for (set<int>::iterator it = setA.begin(); it != setA.end(); ++it) {
+        if (setB.count(*it)) {
+            both.insert(*it);
+        }
+    }
+
+    test_assert(sameIds(a.intersection(b), both), "AND should match std::set intersection");
+    test_assert(sameIds(a.unionWith(b), either), "OR should match std::set union");
+    test_assert(a.intersection(b) == b.intersection(a), "AND should be symmetric");
+    test_assert(a.unionWith(b) == b.unionWith(a), "OR should be symmetric");
+    test_assert(a.intersection(TrackBitmap()).empty(), "AND with an empty set should be empty");
+
+    vector<int> column(300000);
+    for (int i = 0; i < 300000; i++) {
+        column[i] = i % 500;
+    }
+    set<int> inRange;
+    for (set<int>::iterator it = setA.begin(); it != setA.end(); ++it) {
+        if (column[*it] >= 100 && column[*it] <= 199) {
+            inRange.insert(*it);
+        }
+    }
+    test_assert(sameIds(a.filterRange(&column[0], 100, 199), inRange), "filterRange() should keep in-range ids only");
+}
+
+void test_catalog_genre_queries() {
+    cout << "\n🧪 Testing Catalog Genre Queries..." << endl;
+
+    const int NUM_TRACKS = 200000;
+    const char* GENRES[] = { "Hip-Hop", "Pop", "R&B", "Rap" };
+    TrackCatalog indexed;
+    TrackCatalog scanned;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        const char* genre = (i % 10 < 6) ? GENRES[0] : GENRES[1 + i % 3];
+        indexed.addTrack("Track", 120 + i % 240, genre);
+        scanned.addTrack("Track", 120 + i % 240, genre);
+        if (i == 1000) {
+            indexed.enableGenreIndex();
+        }
+    }
+    test_assert(indexed.hasGenreIndex() && !scanned.hasGenreIndex(), "Only one catalog should be indexed");
+
+    for (int i = 0; i < NUM_TRACKS; i += 7) {
+        indexed.setGenre(i, "Pop");
+        scanned.setGenre(i, "Pop");
+    }
+    indexed.setGenre(42, "Afro-Trap");
+    scanned.setGenre(42, "Afro-Trap");
+
+    bool allMatch = true;
+    for (int g = 0; g < 4; g++) {
+        allMatch = allMatch && indexed.findByGenre(GENRES[g]) == scanned.findByGenre(GENRES[g]);
+    }
+    test_assert(allMatch, "Index should stay in sync with setGenre()");
+
+    TrackBitmap afroTrap = indexed.findByGenre("Afro-Trap");
+    test_assert(afroTrap.cardinality() == 1 && afroTrap.contains(42), "New genres should be indexed");
+    test_assert(indexed.findByGenre("Zouk").empty(), "Unknown genre should match nothing");
+
+    int hipHopCount = 0;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        if (scanned.getGenre(i) == "Hip-Hop") {
+            hipHopCount++;
+        }
+    }
+    test_assert(indexed.findByGenre("Hip-Hop").cardinality() == hipHopCount, "Count should match a getGenre() scan");
+
+    // "Pop tracks over 4 minutes"
+    TrackBitmap longPop = indexed.filterByDuration(indexed.findByGenre("Pop"), 241, 100000);
+    bool longPopOk = true;
+    int longPopCount = 0;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        bool expected = scanned.getGenre(i) == "Pop" && scanned.getDuration(i) > 240;
+        longPopOk = longPopOk && longPop.contains(i) == expected;
+        longPopCount += expected ? 1 : 0;
+    }
+    test_assert(longPopOk && longPop.cardinality() == longPopCount, "Genre AND duration range should match a scan");
+
+    // "R&B or Rap, or anything under 2:05"
+    TrackBitmap mix = indexed.findByGenre("R&B").unionWith(indexed.findByGenre("Rap"))
+                             .unionWith(indexed.findByDuration(0, 124));
+    bool mixOk = true;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        const string& genre = scanned.getGenre(i);
+        bool expected = genre == "R&B" || genre == "Rap" || scanned.getDuration(i) <= 124;
+        mixOk = mixOk && mix.contains(i) == expected;
+    }
+    test_assert(mixOk, "OR of genres and a duration range should match a scan");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Genre Bitmap Tests" << endl;
+    cout << "================================================" << endl;
+
+    test_bitmap_basics();
+    test_set_operations();
+    test_catalog_genre_queries();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All genre bitmap tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some genre bitmap tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -0,0 +1,229 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <sstream>
+#include "../src/musictrack.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+void test_add_and_get() {
+    cout << "\n🧪 Testing Catalog Add and Get..." << endl;
+
+    TrackCatalog catalog;
+    test_assert(catalog.size() == 0, "New catalog should be empty");
+
+    int bella = catalog.addTrack("Bella", 206, "Hip-Hop");
+    int ouAller = catalog.addTrack("Où aller", 267, "R&B");
+
+    test_assert(bella == 0 && ouAller == 1, "Track ids should be handed out in order");
+    test_assert(catalog.size() == 2, "Catalog should hold two tracks");
+    test_assert(catalog.getTitle(ouAller) == "Où aller", "getTitle() should return the stored title");
+    test_assert(catalog.getDuration(bella) == 206, "getDuration() should return the stored duration");
+    test_assert(catalog.getGenre(ouAller) == "R&B", "getGenre() should return the stored genre");
+    test_assert(catalog.getPlayCount(bella) == 0, "Play count should start at 0");
+}
+
+void test_validation() {
+    cout << "\n🧪 Testing Catalog Validation..." << endl;
+
+    TrackCatalog catalog;
+    int id = catalog.addTrack("", -50, "");
+
+    test_assert(catalog.getTitle(id) == "Untitled Track", "Empty title should default to 'Untitled Track'");
+    test_assert(catalog.getDuration(id) == 180, "Negative duration should default to 180 seconds");
+    test_assert(catalog.getGenre(id) == "Unknown", "Empty genre should default to 'Unknown'");
+
+    catalog.setPlayCount(id, -10);
+    test_assert(catalog.getPlayCount(id) == 0, "Negative play count should be set to 0");
+
+    catalog.setDuration(id, 0);
+    test_assert(catalog.getDuration(id) == 180, "setDuration(0) should default to 180 seconds");
+
+    test_assert(!catalog.isValidId(-1) && !catalog.isValidId(1), "Out of range ids should be invalid");
+    test_assert(catalog.getTitle(5) == "" && catalog.getPlayCount(5) == 0, "Invalid ids should return empty values");
+    catalog.play(5);
+    test_assert(catalog.size() == 1, "Setters on invalid ids should be ignored");
+}
+
+void test_setters_and_plays() {
+    cout << "\n🧪 Testing Catalog Setters and Plays..." << endl;
+
+    TrackCatalog catalog;
+    int id = catalog.addTrack("Zombie", 223, "Hip-Hop");
+    int other = catalog.addTrack("J'me tire", 205, "Hip-Hop");
+
+    catalog.setTitle(id, "Tout donner");
+    test_assert(catalog.getTitle(id) == "Tout donner", "setTitle() should replace the title");
+    test_assert(catalog.getTitle(other) == "J'me tire", "setTitle() should not touch other tracks");
+
+    catalog.setGenre(id, "Pop");
+    test_assert(catalog.getGenre(id) == "Pop", "setGenre() should replace the genre");
+    test_assert(catalog.getGenre(other) == "Hip-Hop", "setGenre() should not touch other tracks");
+
+    for (int i = 0; i < 1000; i++) {
+        catalog.play(id);
+    }
+    test_assert(catalog.getPlayCount(id) == 1000, "1000 plays should register correctly");
+    test_assert(catalog.getPlayCount(other) == 0, "play() should not touch other tracks");
+
+    catalog.setPlayCount(id, 1000001);
+    test_assert(catalog.isPopular(id), "1,000,001 plays should be popular");
+    catalog.resetPlayCount(id);
+    test_assert(!catalog.isPopular(id) && catalog.getPlayCount(id) == 0, "resetPlayCount() should set plays to 0");
+}
+
+void test_genre_ids() {
+    cout << "\n🧪 Testing Catalog Genre Ids..." << endl;
+
+    TrackCatalog catalog;
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");
+    catalog.addTrack("Zombie", 223, "Hip-Hop");
+
+    const int* genres = catalog.genreIdData();
+    test_assert(catalog.genreCount() == 2, "Repeated genres should share one genre id");
+    test_assert(genres[0] == genres[2], "Tracks with the same genre should have the same genre id");
+    test_assert(genres[0] != genres[1], "Tracks with different genres should have different genre ids");
+    test_assert(catalog.genreName(genres[1]) == "Pop", "genreName() should resolve a genre id");
+    test_assert(catalog.genreName(99) == "", "genreName() should return '' for an invalid id");
+}
+
+void test_columns() {
+    cout << "\n🧪 Testing Catalog Columns..." << endl;
+
+    const int NUM_TRACKS = 10000;
+    TrackCatalog catalog;
+    catalog.reserve(NUM_TRACKS, NUM_TRACKS * 12);
+
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "Track " << i;
+        int id = catalog.addTrack(ss.str(), 100 + i, "Genre");
+        catalog.setPlayCount(id, i);
+    }
+
+    const int* durations = catalog.durationData();
+    const int* plays = catalog.playCountData();
+    long long totalDuration = 0;
+    long long totalPlays = 0;
+    for (int i = 0; i < catalog.size(); i++) {
+        totalDuration += durations[i];
+        totalPlays += plays[i];
+    }
+
+    test_assert(totalDuration == 100LL * NUM_TRACKS + (long long)NUM_TRACKS * (NUM_TRACKS - 1) / 2,
+                "Duration column scan should see every track");
+    test_assert(totalPlays == (long long)NUM_TRACKS * (NUM_TRACKS - 1) / 2,
+                "Play count column scan should see every track");
+    test_assert(catalog.getTitle(9999) == "Track 9999", "Last title should be stored correctly");
+}
+
+void test_musictrack_round_trip() {
+    cout << "\n🧪 Testing MusicTrack Round Trip..." << endl;
+
+    MusicTrack bella("Bella", 206, "Hip-Hop");
+    bella.setPlayCount(1500000);
+
+    TrackCatalog catalog;
+    int id = catalog.addTrack(bella);
+    test_assert(catalog.getPlayCount(id) == 1500000, "addTrack(MusicTrack) should copy the play count");
+
+    MusicTrack copy = catalog.getTrack(id);
+    test_assert(copy.getTitle() == "Bella", "getTrack() should copy the title");
+    test_assert(copy.getDuration() == 206, "getTrack() should copy the duration");
+    test_assert(copy.getGenre() == "Hip-Hop", "getTrack() should copy the genre");
+    test_assert(copy.isPopular() == catalog.isPopular(id), "getTrack() should agree on popularity");
+}
+
+void test_play_event_batches() {
+    cout << "\n🧪 Testing Play Event Batches..." << endl;
+
+    TrackCatalog catalog;
+    int bella = catalog.addTrack("Bella", 206, "Hip-Hop");
+    int estCeQue = catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");
+    int toutDonner = catalog.addTrack("Tout donner", 198, "Hip-Hop");
+    catalog.setPlayCount(toutDonner, 10);
+
+    PlayEvent events[] = {
+        { estCeQue, 30000 },
+        { bella, 1500000 },
+        { estCeQue, 20000 },
+        { 42, 5 },            // unknown track - skipped
+        { toutDonner, -50 },  // correction larger than the count
+        { bella, 1 }
+    };
+    int applied = catalog.applyPlayEvents(events, 6);
+
+    test_assert(applied == 5, "Events for unknown tracks should be skipped");
+    test_assert(catalog.getPlayCount(bella) == 1500001, "Events for one track should be added up");
+    test_assert(catalog.getPlayCount(estCeQue) == 50000, "Unordered events should be grouped by track");
+    test_assert(catalog.getPlayCount(toutDonner) == 0, "Batch should never make a play count negative");
+    test_assert(catalog.isPopular(bella), "Batched plays should count towards popularity");
+
+    PlayEvent overflow[] = { { bella, 2000000000 }, { bella, 2000000000 } };
+    catalog.applyPlayEvents(overflow, 2);
+    test_assert(catalog.getPlayCount(bella) == 2147483647, "Batch should saturate instead of overflowing");
+
+    test_assert(catalog.applyPlayEvents(NULL, 3) == 0, "NULL batch should apply nothing");
+
+    // Same result as calling play() once per event
+    TrackCatalog perCall;
+    TrackCatalog batched;
+    perCall.addTrack("Zombie", 223, "Hip-Hop");
+    perCall.addTrack("J'me tire", 205, "Hip-Hop");
+    batched.addTrack("Zombie", 223, "Hip-Hop");
+    batched.addTrack("J'me tire", 205, "Hip-Hop");
+
+    const int NUM_EVENTS = 25000;
+    PlayEvent* stream = new PlayEvent[NUM_EVENTS];
+    for (int i = 0; i < NUM_EVENTS; i++) {
+        stream[i].trackId = (i % 3 == 0) ? 0 : 1;
+        stream[i].count = 1;
+        perCall.play(stream[i].trackId);
+    }
+    batched.applyPlayEvents(stream, NUM_EVENTS);
+    delete[] stream;
+
+    test_assert(batched.getPlayCount(0) == perCall.getPlayCount(0) &&
+                batched.getPlayCount(1) == perCall.getPlayCount(1),
+                "Batch should match calling play() once per event");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Track Catalog Tests" << endl;
+    cout << "=================================================" << endl;
+
+    test_add_and_get();
+    test_validation();
+    test_setters_and_plays();
+    test_genre_ids();
+    test_columns();
+    test_musictrack_round_trip();
+    test_play_event_batches();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All catalog tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some catalog tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
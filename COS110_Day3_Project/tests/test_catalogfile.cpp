@@ -0,0 +1,176 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <unistd.h>
+#include "../src/trackcatalog.h"
+#include "../src/catalogfile.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+const string CATALOG_PATH = "test_catalogfile.bin";
+
+void test_round_trip() {
+    cout << "\n🧪 Testing Catalog File Round Trip..." << endl;
+
+    TrackCatalog catalog;
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");
+    catalog.addTrack("Où aller", 267, "R&B");
+    catalog.addTrack("J'me tire", 205, "Hip-Hop");
+    catalog.setPlayCount(0, 1500000);
+    catalog.setPlayCount(1, 50000);
+
+    test_assert(writeCatalogFile(catalog, CATALOG_PATH), "Catalog should be written to disk");
+
+    MappedCatalog mapped;
+    test_assert(mapped.open(CATALOG_PATH), "Written catalog should map successfully");
+    test_assert(mapped.size() == 4, "Mapped catalog should have every track");
+
+    CatalogTrackView bella = mapped.getTrack(0);
+    test_assert(bella.getTitle() == "Bella", "View should return the title");
+    test_assert(bella.getDuration() == 206, "View should return the duration");
+    test_assert(bella.getGenre() == "Hip-Hop", "View should return the genre");
+    test_assert(bella.getPlayCount() == 1500000, "View should return the play count");
+    test_assert(bella.isPopular(), "View should agree on popularity");
+    test_assert(bella.getFormattedDuration() == "3:26", "View should format the duration like MusicTrack");
+
+    CatalogTrackView ouAller = mapped.getTrack(2);
+    test_assert(ouAller.getTitle() == "Où aller" && ouAller.getGenre() == "R&B", "Accented titles should survive");
+
+    bool allMatch = true;
+    for (int i = 0; i < catalog.size(); i++) {
+        CatalogTrackView view = mapped.getTrack(i);
+        allMatch = allMatch && view.getTitle() == catalog.getTitle(i)
+                            && view.getGenre() == catalog.getGenre(i)
+                            && view.getDuration() == catalog.getDuration(i)
+                            && view.getPlayCount() == catalog.getPlayCount(i);
+    }
+    test_assert(allMatch, "Every view should match the original catalog");
+
+    int length = 0;
+    const char* data = mapped.getTrack(1).getTitleData(&length);
+    test_assert(length == 21 && memcmp(data, "Est-ce que tu m'aimes", 21) == 0, "Title data should point into the mapping");
+
+    test_assert(mapped.getTrack(4).getTitle() == "" && mapped.getPlayCount(-1) == 0, "Invalid ids should return empty values");
+    test_assert(mapped.genreIdData()[0] == mapped.genreIdData()[3], "Genre ids should be kept");
+
+    mapped.close();
+    test_assert(!mapped.isOpen() && mapped.size() == 0, "close() should unmap the catalog");
+    remove(CATALOG_PATH.c_str());
+}
+
+void test_large_catalog() {
+    cout << "\n🧪 Testing Large Catalog File..." << endl;
+
+    const int NUM_TRACKS = 100000;
+    TrackCatalog catalog;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "Track " << i;
+        int id = catalog.addTrack(ss.str(), 100 + i % 500, (i % 3 == 0) ? "Pop" : "Hip-Hop");
+        catalog.setPlayCount(id, i * 20);
+    }
+
+    test_assert(writeCatalogFile(catalog, CATALOG_PATH), "Large catalog should be written");
+
+    MappedCatalog mapped;
+    test_assert(mapped.open(CATALOG_PATH), "Large catalog should map");
+
+    long long popular = 0;
+    const int32_t* plays = mapped.playCountData();
+    for (int i = 0; i < mapped.size(); i++) {
+        if (plays[i] > 1000000) {
+            popular++;
+        }
+    }
+    test_assert(popular == NUM_TRACKS - 50001, "Column scans should run over the mapped play counts");
+    test_assert(mapped.getTrack(NUM_TRACKS - 1).getTitle() == "Track 99999", "Last title should be readable");
+    remove(CATALOG_PATH.c_str());
+}
+
+void test_invalid_files() {
+    cout << "\n🧪 Testing Invalid Catalog Files..." << endl;
+
+    MappedCatalog mapped;
+    test_assert(!mapped.open("does_not_exist.bin"), "Missing file should be rejected");
+
+    FILE* file = fopen(CATALOG_PATH.c_str(), "wb");
+    fputs("Bella, 206, Hip-Hop\n", file);
+    fclose(file);
+    test_assert(!mapped.open(CATALOG_PATH), "File that is too small should be rejected");
+
+    TrackCatalog catalog;
+    catalog.addTrack("Zombie", 223, "Hip-Hop");
+    writeCatalogFile(catalog, CATALOG_PATH);
+
+    // Flip the magic
+    file = fopen(CATALOG_PATH.c_str(), "r+b");
+    fputc('X', file);
+    fclose(file);
+    test_assert(!mapped.open(CATALOG_PATH), "Wrong magic should be rejected");
+
+    // Truncate a valid file
+    writeCatalogFile(catalog, CATALOG_PATH);
+    file = fopen(CATALOG_PATH.c_str(), "r+b");
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    test_assert(truncate(CATALOG_PATH.c_str(), size - 8) == 0, "Test file should be truncated");
+    test_assert(!mapped.open(CATALOG_PATH), "Truncated file should be rejected");
+    test_assert(!mapped.isOpen(), "Failed open should leave the catalog closed");
+
+    // An offset so large that offset + column size wraps around to a small number
+    for (int i = 0; i < 3; i++) {
+        catalog.addTrack("Bella", 206, "Hip-Hop");
+    }
+    writeCatalogFile(catalog, CATALOG_PATH);
+    CatalogFileHeader header;
+    file = fopen(CATALOG_PATH.c_str(), "r+b");
+    bool patched = fread(&header, sizeof(header), 1, file) == 1;
+    header.durationsOffset = 0xFFFFFFFFFFFFFFF8ULL;   // + 4 tracks * 4 bytes wraps to 8
+    patched = patched && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+    fclose(file);
+    test_assert(patched && !mapped.open(CATALOG_PATH), "Huge section offset should be rejected");
+
+    TrackCatalog empty;
+    test_assert(writeCatalogFile(empty, CATALOG_PATH) && mapped.open(CATALOG_PATH) && mapped.size() == 0,
+                "Empty catalog should round trip");
+    remove(CATALOG_PATH.c_str());
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Catalog File Tests" << endl;
+    cout << "================================================" << endl;
+
+    test_round_trip();
+    test_large_catalog();
+    test_invalid_files();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All catalog file tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some catalog file tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -0,0 +1,235 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../src/checkpoint.h"
+#include "../src/catalogfile.h"
+#include "../src/playlog.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+const string BASE_PATH = "test_checkpoint.bin";
+const string LOG_PATH = "test_checkpoint.log";
+
+void removeFiles() {
+    remove(BASE_PATH.c_str());
+    remove((BASE_PATH + ".delta").c_str());
+    remove((BASE_PATH + ".next").c_str());
+    remove(LOG_PATH.c_str());
+}
+
+bool sameCatalog(const TrackCatalog& a, const TrackCatalog& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int id = 0; id < a.size(); id++) {
+        if (a.getTitle(id) != b.getTitle(id) || a.getDuration(id) != b.getDuration(id) ||
+            a.getGenre(id) != b.getGenre(id) || a.getPlayCount(id) != b.getPlayCount(id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void addTracks(TrackCatalog& catalog, int count) {
+    const char* GENRES[] = { "Hip-Hop", "Pop", "R&B" };
+    for (int i = 0; i < count; i++) {
+        int id = catalog.addTrack(i % 2 == 0 ? "Bella" : "Zombie", 150 + i, GENRES[i % 3]);
+        catalog.setPlayCount(id, i * 1000);
+    }
+}
+
+void test_change_tracking() {
+    cout << "\n🧪 Testing Change Tracking..." << endl;
+
+    TrackCatalog catalog;
+    addTracks(catalog, 10);
+    test_assert(!catalog.hasChangeTracking() && catalog.changedTracks().empty(), "Tracking should be off by default");
+
+    catalog.enableChangeTracking();
+    catalog.setTitle(1, "Sapés comme jamais");
+    catalog.setDuration(2, 267);
+    catalog.setGenre(3, "Pop");
+    catalog.setPlayCount(4, 1500000);
+    catalog.play(5);
+    catalog.resetPlayCount(6);
+    PlayEvent events[1] = { { 7, 3 } };
+    catalog.applyPlayEvents(events, 1);
+    int added = catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");
+
+    vector<int> ids;
+    catalog.changedTracks().toIds(ids);
+    int expected[] = { 1, 2, 3, 4, 5, 6, 7, added };
+    test_assert(ids == vector<int>(expected, expected + 8), "Every kind of change should be recorded");
+
+    catalog.clearChangedTracks();
+    test_assert(catalog.changedTracks().empty(), "clearChangedTracks() should forget the changes");
+
+    catalog.enableConcurrentPlays();
+    catalog.play(9);
+    test_assert(catalog.changedTracks().empty(), "Concurrent plays should wait for collection");
+    catalog.collectConcurrentPlays();
+    test_assert(catalog.changedTracks().contains(9), "Collected plays should be recorded");
+}
+
+void test_delta_round_trip() {
+    cout << "\n🧪 Testing Delta Checkpoints..." << endl;
+
+    removeFiles();
+    TrackCatalog live;
+    CatalogCheckpoint checkpoints(BASE_PATH);
+    test_assert(!checkpoints.checkpoint(live), "checkpoint() should need a load() first");
+    test_assert(checkpoints.load(live) && live.size() == 0, "Missing files should load as an empty catalog");
+
+    live.enableChangeTracking();
+    addTracks(live, 1000);
+    checkpoints.setCompactionPercent(50);
+    test_assert(checkpoints.checkpoint(live) && checkpoints.lastCompacted(), "First checkpoint should write a base image");
+
+    live.setTitle(10, "Où aller");
+    live.setPlayCount(20, 2000000);
+    live.play(30);
+    live.addTrack("Tu vas me manquer", 201, "R&B");
+    test_assert(checkpoints.checkpoint(live) && !checkpoints.lastCompacted() && checkpoints.getLastEntryCount() == 4,
+                "Checkpoint should write only the changed tracks");
+    test_assert(checkpoints.checkpoint(live) && checkpoints.getLastEntryCount() == 0, "Nothing changed, nothing written");
+
+    TrackCatalog restored;
+    CatalogCheckpoint reader(BASE_PATH);
+    CheckpointLoad report;
+    test_assert(reader.load(restored, &report) && sameCatalog(live, restored), "Base plus delta should rebuild the catalog");
+    test_assert(report.baseTracks == 1000 && report.deltaRecords == 1 && report.deltaEntries == 4,
+                "Load should read the base and the small delta");
+    test_assert(!reader.load(restored), "load() should need an empty catalog");
+
+    // Keep changing until the delta passes the compaction limit
+    bool compactedOnce = false;
+    for (int round = 0; round < 20 && !compactedOnce; round++) {
+        for (int id = round * 50; id < round * 50 + 50; id++) {
+            live.setDuration(id, 100 + round);
+        }
+        checkpoints.checkpoint(live);
+        compactedOnce = checkpoints.lastCompacted();
+    }
+    test_assert(compactedOnce, "A large delta should be compacted into the base");
+    TrackCatalog compacted;
+    test_assert(CatalogCheckpoint(BASE_PATH).load(compacted, &report) && report.deltaRecords == 0 &&
+                sameCatalog(live, compacted), "Compacted base should hold everything");
+}
+
+void test_crash_recovery() {
+    cout << "\n🧪 Testing Crash Recovery..." << endl;
+
+    removeFiles();
+    TrackCatalog live;
+    CatalogCheckpoint checkpoints(BASE_PATH);
+    checkpoints.load(live);
+    live.enableChangeTracking();
+    addTracks(live, 100);
+    checkpoints.checkpoint(live);
+    live.setPlayCount(5, 555);
+    checkpoints.checkpoint(live);
+
+    // A record torn in the middle of writing
+    FILE* file = fopen((BASE_PATH + ".delta").c_str(), "ab");
+    CheckpointRecordHeader torn = { 2, 0, 500, 3, 0 };
+    fwrite(&torn, sizeof(torn), 1, file);
+    fputs("Bella", file);
+    fclose(file);
+
+    TrackCatalog restored;
+    CatalogCheckpoint reader(BASE_PATH);
+    CheckpointLoad report;
+    test_assert(reader.load(restored, &report) && report.truncatedTail && sameCatalog(live, restored),
+                "Torn delta record should be ignored");
+    restored.enableChangeTracking();
+    restored.setPlayCount(6, 666);
+    TrackCatalog again;
+    test_assert(reader.checkpoint(restored) && CatalogCheckpoint(BASE_PATH).load(again, &report) &&
+                !report.truncatedTail && again.getPlayCount(6) == 666, "Checkpoints should continue after the good records");
+
+    // Crash after the new base was written but before it was renamed
+    again.setPlayCount(7, 777);
+    writeCatalogFile(again, BASE_PATH + ".next");
+    TrackCatalog recovered;
+    test_assert(CatalogCheckpoint(BASE_PATH).load(recovered, &report) && report.finishedCompaction &&
+                report.deltaRecords == 0 && sameCatalog(again, recovered), "Interrupted compaction should be finished");
+}
+
+void test_play_log() {
+    cout << "\n🧪 Testing Checkpoints With a Play Log..." << endl;
+
+    removeFiles();
+    TrackCatalog live;
+    CatalogCheckpoint checkpoints(BASE_PATH);
+    checkpoints.load(live);
+    live.enableChangeTracking();
+    addTracks(live, 200);
+
+    PlayLog log;
+    log.open(LOG_PATH, PLAYLOG_GROUP_COMMIT);
+    live.attachPlayLog(&log);
+    srand(206);
+    for (int i = 0; i < 3000; i++) {
+        live.play(rand() % 200);
+    }
+    checkpoints.checkpoint(live, &log);
+    for (int i = 0; i < 500; i++) {
+        live.play(rand() % 200);
+    }
+    log.close();   // crash: these plays are only in the log
+    live.attachPlayLog(NULL);
+
+    TrackCatalog restored;
+    CheckpointLoad loaded;
+    PlayLogReplay replayed;
+    CatalogCheckpoint(BASE_PATH).load(restored, &loaded);
+    PlayLog::replay(LOG_PATH, restored, &replayed, loaded.logSequence);
+    test_assert(loaded.logSequence > 0 && sameCatalog(live, restored), "Checkpoint plus log should rebuild every play");
+    test_assert(replayed.eventsRead <= 500, "Only plays after the checkpoint should be in the log");
+
+    // Crash before the log was reset: covered frames are skipped
+    TrackCatalog doubled;
+    addTracks(doubled, 200);
+    PlayLog::replay(LOG_PATH, doubled, &replayed, replayed.lastSequence);
+    test_assert(replayed.eventsRead > 0 && replayed.eventsApplied == 0, "Frames covered by a checkpoint should be skipped");
+    removeFiles();
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Checkpoint Tests" << endl;
+    cout << "==============================================" << endl;
+
+    test_change_tracking();
+    test_delta_round_trip();
+    test_crash_recovery();
+    test_play_log();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All checkpoint tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some checkpoint tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include "../src/compacttrack.h"
+#include "../src/durationformat.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+bool sameTrack(const MusicTrack& a, const MusicTrack& b) {
+    return a.getTitle() == b.getTitle() && a.getDuration() == b.getDuration() &&
+           a.getGenre() == b.getGenre() && a.getPlayCount() == b.getPlayCount();
+}
+
+void test_hot_record() {
+    cout << "\n🧪 Testing CompactTrack Records..." << endl;
+
+    test_assert(sizeof(CompactTrack) == 8, "Hot record should be 8 bytes");
+    test_assert(sizeof(CompactTrack) * 4 < sizeof(MusicTrack), "Hot record should be far smaller than MusicTrack");
+
+    CompactTrackStore store;
+    int bella = store.addTrack("Bella", 206, "Hip-Hop");
+    test_assert(bella == 0 && store.size() == 1, "First track should get index 0");
+
+    CompactTrack& record = store[bella];
+    record.setPlayCount(1000000);
+    test_assert(!record.isPopular(), "1,000,000 plays should not be popular");
+    record.play();
+    test_assert(record.isPopular() && record.getPlayCount() == 1000001, "play() should add one play");
+    record.setPlayCount(-5);
+    test_assert(record.getPlayCount() == 0, "Negative play counts should become 0");
+    record.setDuration(-1);
+    test_assert(record.getDuration() == 180, "Invalid durations should become 180");
+    record.setDuration(3661);
+    char formatted[DURATION_TEXT_SIZE];
+    int length = record.getFormattedDuration(formatted, DURATION_TEXT_SIZE);
+    test_assert(string(formatted, length) == "61:01", "Formatted duration should match MusicTrack");
+}
+
+void test_store_matches_musictrack() {
+    cout << "\n🧪 Testing CompactTrackStore Against MusicTrack..." << endl;
+
+    vector<MusicTrack> tracks;
+    tracks.push_back(MusicTrack("Bella", 206, "Hip-Hop"));
+    tracks.push_back(MusicTrack("Où aller", 267, "R&B"));
+    tracks.push_back(MusicTrack("", -3, ""));
+    tracks.push_back(MusicTrack("Est-ce que tu m'aimes", 234, "Pop"));
+    tracks[0].setPlayCount(1500000);
+    tracks[3].setPlayCount(50000);
+
+    CompactTrackStore store;
+    store.reserve((int)tracks.size(), 64);
+    bool allSame = true;
+    for (size_t i = 0; i < tracks.size(); i++) {
+        int index = store.addTrack(tracks[i]);
+        allSame = allSame && sameTrack(store.getTrack(index), tracks[i]);
+    }
+    test_assert(allSame, "Tracks should round-trip through the store");
+    test_assert(store.getTitle(2) == "Untitled Track" && store.getGenre(2) == "Unknown" && store[2].getDuration() == 180,
+                "Store should apply MusicTrack's validation");
+
+    int fresh = store.addTrack("", 0, "");
+    test_assert(sameTrack(store.getTrack(fresh), MusicTrack("", 0, "")), "addTrack() should validate like the constructor");
+
+    store.setTitle(1, "Zombie");
+    store.setGenre(1, "Hip-Hop");
+    int length = 0;
+    const char* title = store.getTitleData(1, &length);
+    test_assert(string(title, length) == "Zombie" && store.getGenreId(1) == tracks[0].getGenreId(),
+                "Cold fields should be updatable");
+    store.setTitle(1, "");
+    test_assert(store.getTitle(1) == "Untitled Track", "Empty titles should become 'Untitled Track'");
+
+    // Scans only need the hot array
+    const CompactTrack* hot = store.records();
+    long long plays = 0;
+    int popular = 0;
+    for (int i = 0; i < store.size(); i++) {
+        plays += hot[i].playCount;
+        popular += hot[i].isPopular() ? 1 : 0;
+    }
+    test_assert(plays == 1550000 && popular == 1, "Hot records should be scannable as an array");
+    test_assert(store.hotBytes() == store.size() * sizeof(CompactTrack) && store.coldBytes() > 0,
+                "Memory should be split into hot and cold bytes");
+    test_assert(CompactTrackStore().records() == NULL, "Empty store should have no records");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Compact Track Tests" << endl;
+    cout << "================================================" << endl;
+
+    test_hot_record();
+    test_store_matches_musictrack();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All compact track tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some compact track tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <pthread.h>
+#include "../src/musictrack.h"
+#include "../src/playcounter.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+const int NUM_THREADS = 8;
+const int PLAYS_PER_THREAD = 200000;
+
+// Each worker plays its target PLAYS_PER_THREAD times
+struct Worker {
+    MusicTrack* track;
+    TrackCatalog* catalog;
+    ConcurrentPlayCounter* counter;
+    int trackId;
+};
+
+void* playSharedTrack(void* arg) {
+    Worker* w = (Worker*)arg;
+    for (int i = 0; i < PLAYS_PER_THREAD; i++) {
+        w->track->play();
+    }
+    return NULL;
+}
+
+void* playCounterTrack(void* arg) {
+    Worker* w = (Worker*)arg;
+    for (int i = 0; i < PLAYS_PER_THREAD; i++) {
+        w->counter->play(w->trackId);
+    }
+    return NULL;
+}
+
+void* playCatalogTrack(void* arg) {
+    Worker* w = (Worker*)arg;
+    for (int i = 0; i < PLAYS_PER_THREAD; i++) {
+        w->catalog->play(w->trackId);
+        // Every thread also plays the hot track
+        w->catalog->play(0);
+    }
+    return NULL;
+}
+
+void runWorkers(void* (*fn)(void*), Worker* workers) {
+    pthread_t threads[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_create(&threads[i], NULL, fn, &workers[i]);
+    }
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+}
+
+void test_shared_musictrack() {
+    cout << "\n🧪 Testing Concurrent MusicTrack::play()..." << endl;
+
+    MusicTrack bella("Bella", 206, "Hip-Hop");
+    Worker workers[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        workers[i].track = &bella;
+    }
+
+    runWorkers(playSharedTrack, workers);
+
+    test_assert(bella.getPlayCount() == NUM_THREADS * PLAYS_PER_THREAD,
+                "No plays should be lost when threads share one MusicTrack");
+    test_assert(bella.isPopular(), "1,600,000 concurrent plays should make the track popular");
+}
+
+void test_counter_hot_and_cold() {
+    cout << "\n🧪 Testing ConcurrentPlayCounter..." << endl;
+
+    ConcurrentPlayCounter counter(NUM_THREADS, 4);
+    counter.markHot(0);
+    test_assert(counter.isHot(0) && !counter.isHot(1), "markHot() should only affect one track");
+
+    // Half the threads hammer the hot track, the rest play their own track
+    Worker workers[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        workers[i].counter = &counter;
+        workers[i].trackId = (i % 2 == 0) ? 0 : i;
+    }
+
+    runWorkers(playCounterTrack, workers);
+
+    test_assert(counter.getPlayCount(0) == (long long)(NUM_THREADS / 2) * PLAYS_PER_THREAD,
+                "Striped hot track should merge all stripes on read");
+    test_assert(counter.getPlayCount(1) == PLAYS_PER_THREAD,
+                "Neighbouring cold track should count its own plays");
+    test_assert(counter.getPlayCount(2) == 0, "Unplayed track should stay at 0");
+
+    long long taken = counter.takePlayCount(0);
+    test_assert(taken == (long long)(NUM_THREADS / 2) * PLAYS_PER_THREAD && counter.getPlayCount(0) == 0,
+                "takePlayCount() should return and clear the merged count");
+    test_assert(counter.getPlayCount(-1) == 0 && counter.getPlayCount(NUM_THREADS) == 0,
+                "Invalid ids should read as 0");
+}
+
+void test_catalog_concurrent_mode() {
+    cout << "\n🧪 Testing TrackCatalog Concurrent Mode..." << endl;
+
+    TrackCatalog catalog;
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    for (int i = 1; i <= NUM_THREADS; i++) {
+        catalog.addTrack("Track", 180, "Pop");
+    }
+    catalog.setPlayCount(0, 1000);
+
+    catalog.enableConcurrentPlays(4);
+    catalog.markHotTrack(0);
+    test_assert(catalog.hasConcurrentPlays(), "Concurrent mode should be enabled");
+
+    Worker workers[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        workers[i].catalog = &catalog;
+        workers[i].trackId = i + 1;
+    }
+
+    runWorkers(playCatalogTrack, workers);
+
+    int expectedHot = 1000 + NUM_THREADS * PLAYS_PER_THREAD;
+    test_assert(catalog.getPlayCount(0) == expectedHot,
+                "getPlayCount() should merge uncollected plays of the hot track");
+    test_assert(catalog.isPopular(0), "isPopular() should see uncollected plays");
+
+    bool allCold = true;
+    for (int i = 1; i <= NUM_THREADS; i++) {
+        allCold = allCold && catalog.getPlayCount(i) == PLAYS_PER_THREAD;
+    }
+    test_assert(allCold, "Every per-thread track should count exactly its own plays");
+
+    test_assert(catalog.playCountData()[0] == 1000, "Column should not change before collecting");
+    catalog.collectConcurrentPlays();
+    test_assert(catalog.playCountData()[0] == expectedHot, "collectConcurrentPlays() should fold plays into the column");
+    test_assert(catalog.getPlayCount(0) == expectedHot, "Collecting should not double count");
+
+    catalog.play(1);
+    catalog.setPlayCount(1, 5);
+    test_assert(catalog.getPlayCount(1) == 5, "setPlayCount() should discard uncollected plays");
+
+    int added = catalog.addTrack("Zombie", 223, "Hip-Hop");
+    catalog.play(added);
+    test_assert(catalog.getPlayCount(added) == 1, "Tracks added in concurrent mode should be counted");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Concurrency Tests" << endl;
+    cout << "===============================================" << endl;
+
+    test_shared_musictrack();
+    test_counter_hot_and_cold();
+    test_catalog_concurrent_mode();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All concurrency tests passed! No plays were lost." << endl;
+    } else {
+        cout << "⚠️  Some concurrency tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
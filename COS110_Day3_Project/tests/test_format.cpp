@@ -0,0 +1,112 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include "../src/musictrack.h"
+#include "../src/durationformat.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+// Format into a stack buffer and compare with the expected text
+bool formatsAs(int seconds, const char* expected) {
+    char buffer[DURATION_TEXT_SIZE];
+    int length = formatDuration(seconds, buffer, DURATION_TEXT_SIZE);
+    return length == (int)strlen(expected) && strcmp(buffer, expected) == 0;
+}
+
+void test_single_format() {
+    cout << "\n🧪 Testing Buffer Duration Formatting..." << endl;
+
+    test_assert(formatsAs(206, "3:26"), "206 seconds should format as 3:26");
+    test_assert(formatsAs(125, "2:05"), "125 seconds should format as 2:05");
+    test_assert(formatsAs(61, "1:01"), "61 seconds should format as 1:01");
+    test_assert(formatsAs(3661, "61:01"), "3661 seconds should format as 61:01");
+    test_assert(formatsAs(36000, "600:00"), "36000 seconds should format as 600:00");
+    test_assert(formatsAs(1, "0:01"), "1 second should format as 0:01");
+    test_assert(formatsAs(59, "0:59"), "59 seconds should format as 0:59");
+    test_assert(formatsAs(60, "1:00"), "60 seconds should format as 1:00");
+    test_assert(formatsAs(0, "0:00"), "0 seconds should format as 0:00");
+    test_assert(formatsAs(2147483647, "35791394:07"), "INT_MAX seconds should fit the buffer");
+    test_assert(formatsAs(-65, "-1:05"), "Negative durations should get a leading '-'");
+    test_assert(formatsAs(-2147483647 - 1, "-35791394:08"), "INT_MIN seconds should fit the buffer");
+}
+
+void test_small_buffer() {
+    cout << "\n🧪 Testing Small Buffers..." << endl;
+
+    char buffer[5];
+    test_assert(formatDuration(3661, buffer, 5) == -1, "Too small buffer should be rejected");
+    test_assert(buffer[0] == '\0', "Rejected buffer should be left empty");
+    test_assert(formatDuration(206, buffer, 5) == 4, "Exactly fitting buffer should be accepted");
+    test_assert(formatDuration(206, NULL, 5) == -1, "NULL buffer should be rejected");
+}
+
+void test_matches_musictrack() {
+    cout << "\n🧪 Testing MusicTrack Formatting..." << endl;
+
+    int samples[] = { 1, 59, 60, 65, 125, 206, 245, 3661, 36000, 999999 };
+    bool allMatch = true;
+    for (int i = 0; i < 10; i++) {
+        MusicTrack track("Test", samples[i], "Test");
+        char buffer[DURATION_TEXT_SIZE];
+        int length = track.getFormattedDuration(buffer, DURATION_TEXT_SIZE);
+        allMatch = allMatch && track.getFormattedDuration() == string(buffer, length);
+    }
+    test_assert(allMatch, "Buffer and string versions should produce the same text");
+}
+
+void test_bulk_format() {
+    cout << "\n🧪 Testing Bulk Formatting..." << endl;
+
+    int durations[] = { 206, 234, 198, 267, 223, 205 };
+    const char* expected[] = { "3:26", "3:54", "3:18", "4:27", "3:43", "3:25" };
+    char output[6 * DURATION_TEXT_SIZE];
+    int lengths[6];
+
+    formatDurations(durations, 6, output, lengths);
+
+    bool allMatch = true;
+    for (int i = 0; i < 6; i++) {
+        const char* entry = output + i * DURATION_TEXT_SIZE;
+        allMatch = allMatch && strcmp(entry, expected[i]) == 0 && lengths[i] == (int)strlen(expected[i]);
+    }
+    test_assert(allMatch, "Bulk formatting should match the Gims catalog durations");
+
+    formatDurations(durations, 2, output);
+    test_assert(strcmp(output + DURATION_TEXT_SIZE, "3:54") == 0, "Lengths array should be optional");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Duration Formatting Tests" << endl;
+    cout << "======================================================" << endl;
+
+    test_single_format();
+    test_small_buffer();
+    test_matches_musictrack();
+    test_bulk_format();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All formatting tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some formatting tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
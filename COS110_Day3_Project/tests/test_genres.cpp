@@ -0,0 +1,169 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <sstream>
+#include <pthread.h>
+#include "../src/musictrack.h"
+#include "../src/genretable.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+void test_genre_table() {
+    cout << "\n🧪 Testing Genre Table..." << endl;
+
+    GenreTable table;
+    test_assert(table.size() == 0, "New genre table should be empty");
+
+    int hipHop = table.intern("Hip-Hop");
+    int pop = table.intern("Pop");
+    test_assert(hipHop == 0 && pop == 1, "Genre ids should be handed out in order of first use");
+    test_assert(table.intern("Hip-Hop") == hipHop, "Interning the same name should return the same id");
+    test_assert(table.size() == 2, "Repeated names should not grow the table");
+
+    test_assert(table.getName(pop) == "Pop", "getName() should resolve a genre id");
+    test_assert(table.getName(-1) == "" && table.getName(2) == "", "getName() should return '' for invalid ids");
+
+    test_assert(table.find("R&B") == -1, "find() should not add missing genres");
+    test_assert(table.size() == 2, "find() should leave the table unchanged");
+
+    int unknown = table.intern("");
+    test_assert(table.getName(unknown) == "Unknown", "Empty genre should be interned as 'Unknown'");
+    test_assert(table.find("") == unknown && table.find("Unknown") == unknown, "'' and 'Unknown' should share one id");
+
+    const string& name = table.getName(hipHop);
+    for (int i = 0; i < 1000; i++) {
+        stringstream ss;
+        ss << "Genre " << i;
+        table.intern(ss.str());
+    }
+    test_assert(name == "Hip-Hop", "Names should stay valid while the table grows");
+}
+
+struct NameReader {
+    GenreTable* table;
+    bool consistent;
+};
+
+// Resolve every published id while another thread keeps interning
+void* readNames(void* arg) {
+    NameReader* reader = (NameReader*)arg;
+    reader->consistent = true;
+    for (int round = 0; round < 200; round++) {
+        int published = reader->table->size();
+        for (int id = 0; id < published; id++) {
+            stringstream ss;
+            ss << "Genre " << id;
+            if (reader->table->getName(id) != ss.str()) {
+                reader->consistent = false;
+            }
+        }
+    }
+    return NULL;
+}
+
+void test_concurrent_lookup() {
+    cout << "\n🧪 Testing Lookup While Interning..." << endl;
+
+    GenreTable table;
+    NameReader readers[2] = { { &table, false }, { &table, false } };
+    pthread_t threads[2];
+    for (int i = 0; i < 2; i++) {
+        pthread_create(&threads[i], NULL, readNames, &readers[i]);
+    }
+    for (int i = 0; i < 5000; i++) {
+        stringstream ss;
+        ss << "Genre " << i;
+        table.intern(ss.str());
+    }
+    for (int i = 0; i < 2; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    test_assert(readers[0].consistent && readers[1].consistent, "Published names should resolve while the table grows");
+    test_assert(table.size() == 5000 && table.getName(4999) == "Genre 4999", "All interned names should be published");
+}
+
+void test_musictrack_genre_ids() {
+    cout << "\n🧪 Testing MusicTrack Genre Ids..." << endl;
+
+    MusicTrack bella("Bella", 206, "Hip-Hop");
+    MusicTrack zombie("Zombie", 223, "Hip-Hop");
+    MusicTrack estCeQue("Est-ce que tu m'aimes", 234, "Pop");
+    MusicTrack defaultTrack;
+
+    test_assert(bella.getGenreId() == zombie.getGenreId(), "Same genre should give the same id");
+    test_assert(bella.getGenreId() != estCeQue.getGenreId(), "Different genres should give different ids");
+    test_assert(defaultTrack.getGenreId() == bella.getGenreId(), "Default track should be Hip-Hop");
+    test_assert(GenreTable::shared().getName(bella.getGenreId()) == "Hip-Hop", "Track genre ids should resolve through the shared table");
+
+    zombie.setGenre("Pop");
+    test_assert(zombie.getGenreId() == estCeQue.getGenreId(), "setGenre() should intern through the shared table");
+    test_assert(zombie.getGenre() == "Pop", "getGenre() should resolve the interned name");
+
+    zombie.setGenre("");
+    test_assert(zombie.getGenre() == "Unknown", "setGenre('') should still fall back to 'Unknown'");
+
+    MusicTrack copy = bella;
+    copy.setGenre("R&B");
+    test_assert(bella.getGenre() == "Hip-Hop" && copy.getGenre() == "R&B", "Copies should keep independent genres");
+}
+
+void test_catalog_genre_filter() {
+    cout << "\n🧪 Testing Catalog Genre Filter..." << endl;
+
+    TrackCatalog catalog;
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");
+    catalog.addTrack("Tout donner", 198, "Hip-Hop");
+    catalog.addTrack("Où aller", 267, "R&B");
+    catalog.addTrack("Zombie", 223, "Hip-Hop");
+
+    int hipHop = catalog.findGenreId("Hip-Hop");
+    const int* genres = catalog.genreIdData();
+    int count = 0;
+    for (int i = 0; i < catalog.size(); i++) {
+        if (genres[i] == hipHop) {
+            count++;
+        }
+    }
+
+    test_assert(count == 3, "Integer genre filter should find the three Hip-Hop tracks");
+    test_assert(catalog.findGenreId("Afrobeat") == -1, "Unused genres should not have an id");
+    test_assert(catalog.genreName(hipHop) == "Hip-Hop", "Catalog genre ids should resolve to names");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Genre Dictionary Tests" << endl;
+    cout << "===================================================" << endl;
+
+    test_genre_table();
+    test_concurrent_lookup();
+    test_musictrack_genre_ids();
+    test_catalog_genre_filter();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All genre dictionary tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some genre dictionary tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <sstream>
+#include "../src/trackcatalog.h"
+#include "../src/catalogimporter.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+const string IMPORT_PATH = "test_importer.csv";
+
+void importText(CatalogImporter& importer, const string& text) {
+    importer.importBuffer(text.data(), text.size());
+}
+
+void test_csv_rows() {
+    cout << "\n🧪 Testing CSV Import..." << endl;
+
+    TrackCatalog catalog;
+    CatalogImporter importer(catalog);
+    importer.setSkipHeader(true);
+    importText(importer,
+               "title,duration,genre,plays\n"
+               "Bella,206,Hip-Hop,1500000\n"
+               "Est-ce que tu m'aimes, 234 , Pop\n"
+               "\"Sapés comme jamais, remix\",215,Hip-Hop,42\n"
+               "\"Le \"\"Prince\"\"\",190,\"R&B\",7\r\n"
+               "\n"
+               "Où aller,267,R&B,");
+
+    const ImportReport& report = importer.getReport();
+    test_assert(catalog.size() == 5 && report.tracksImported == 5, "Every row should be imported");
+    test_assert(report.rowsRejected == 0 && report.errors.empty(), "Valid rows should not be rejected");
+    test_assert(report.linesRead == 7, "Header and blank lines should be counted as lines");
+    test_assert(catalog.getTitle(0) == "Bella" && catalog.getPlayCount(0) == 1500000, "Plays column should be read");
+    test_assert(catalog.getTitle(1) == "Est-ce que tu m'aimes" && catalog.getDuration(1) == 234,
+                "Spaces around fields should be trimmed");
+    test_assert(catalog.getPlayCount(1) == 0, "Missing plays column should mean 0 plays");
+    test_assert(catalog.getTitle(2) == "Sapés comme jamais, remix", "Quoted fields should keep the delimiter");
+    test_assert(catalog.getTitle(3) == "Le \"Prince\"" && catalog.getGenre(3) == "R&B",
+                "Doubled quotes should become one quote");
+    test_assert(catalog.getPlayCount(3) == 7, "Windows line endings should be handled");
+    test_assert(catalog.getTitle(4) == "Où aller" && catalog.getPlayCount(4) == 0,
+                "Last line without a newline should be imported");
+}
+
+void test_tsv_rows() {
+    cout << "\n🧪 Testing TSV Import..." << endl;
+
+    TrackCatalog catalog;
+    CatalogImporter importer(catalog);
+    importer.setDelimiter('\t');
+    importText(importer, "Zombie\t223\tHip-Hop\t10\nJ'me tire, version live\t205\tHip-Hop\n");
+
+    test_assert(catalog.size() == 2, "TSV rows should be imported");
+    test_assert(catalog.getTitle(1) == "J'me tire, version live", "Commas should be plain text in TSV");
+    test_assert(catalog.getPlayCount(0) == 10, "TSV plays column should be read");
+}
+
+void test_validation() {
+    cout << "\n🧪 Testing Import Validation..." << endl;
+
+    TrackCatalog catalog;
+    CatalogImporter importer(catalog);
+    importText(importer,
+               ",0,,-5\n"
+               "Tout donner,-20,Pop,100\n");
+
+    test_assert(catalog.getTitle(0) == "Untitled Track", "Empty title should default to 'Untitled Track'");
+    test_assert(catalog.getDuration(0) == 180, "Zero duration should default to 180 seconds");
+    test_assert(catalog.getGenre(0) == "Unknown", "Empty genre should default to 'Unknown'");
+    test_assert(catalog.getPlayCount(0) == 0, "Negative play count should be set to 0");
+    test_assert(catalog.getDuration(1) == 180, "Negative duration should default to 180 seconds");
+    test_assert(importer.getReport().rowsRejected == 0, "Values that can be fixed should not be rejected");
+}
+
+void test_rejected_rows() {
+    cout << "\n🧪 Testing Rejected Rows..." << endl;
+
+    TrackCatalog catalog;
+    CatalogImporter importer(catalog);
+    importText(importer,
+               "Bella,206,Hip-Hop\n"             // line 1
+               "Just a title\n"                  // line 2 - too few fields
+               "Zombie,3:43,Hip-Hop\n"           // line 3 - not seconds
+               "Mon coeur avait raison,200,Pop,lots\n" // line 4 - bad plays
+               "\"Broken,200,Pop\n"              // line 5 - unterminated quote
+               "A,1,B,2,extra\n"                 // line 6 - too many fields
+               "Big,99999999999,Pop\n"           // line 7 - out of range
+               "Tout donner,198,Hip-Hop\n");     // line 8
+
+    const ImportReport& report = importer.getReport();
+    test_assert(catalog.size() == 2 && report.tracksImported == 2, "Only the valid rows should be imported");
+    test_assert(catalog.getTitle(1) == "Tout donner", "Rows after rejected ones should still be imported");
+    test_assert(report.rowsRejected == 6 && report.errors.size() == 6, "Every bad row should be reported");
+
+    bool linesMatch = report.errors.size() == 6;
+    for (size_t i = 0; linesMatch && i < report.errors.size(); i++) {
+        linesMatch = report.errors[i].line == (long long)i + 2;
+    }
+    test_assert(linesMatch, "Rejected rows should carry their line numbers");
+    test_assert(report.errors[0].reason.find("too few fields") != string::npos, "Reason should explain a short row");
+    test_assert(report.errors[3].reason == "unterminated quote", "Reason should explain a broken quote");
+}
+
+string buildExport(int rowCount) {
+    stringstream ss;
+    for (int i = 0; i < rowCount; i++) {
+        if (i % 1000 == 999) {
+            ss << "corrupt row " << i << "\n";
+        } else {
+            ss << "\"Track, " << i << "\"," << 100 + i % 300 << "," << ((i % 2) ? "Pop" : "Hip-Hop") << "," << i << "\n";
+        }
+    }
+    return ss.str();
+}
+
+bool sameCatalog(const TrackCatalog& a, const TrackCatalog& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int i = 0; i < a.size(); i++) {
+        if (a.getTitle(i) != b.getTitle(i) || a.getDuration(i) != b.getDuration(i) ||
+            a.getGenre(i) != b.getGenre(i) || a.getPlayCount(i) != b.getPlayCount(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void test_chunks_and_threads() {
+    cout << "\n🧪 Testing Chunked Multi-threaded Import..." << endl;
+
+    const int NUM_ROWS = 20000;
+    string text = buildExport(NUM_ROWS);
+
+    TrackCatalog single;
+    CatalogImporter singleImporter(single);
+    singleImporter.setThreadCount(1);
+    importText(singleImporter, text);
+
+    TrackCatalog parallel;
+    CatalogImporter parallelImporter(parallel);
+    parallelImporter.setThreadCount(4);
+    parallelImporter.setChunkSize(997);   // cut lines everywhere
+    importText(parallelImporter, text);
+
+    test_assert(single.size() == NUM_ROWS - NUM_ROWS / 1000, "Single-threaded import should keep valid rows");
+    test_assert(sameCatalog(single, parallel), "Threads and chunk size should not change the result");
+    test_assert(parallelImporter.getReport().rowsRejected == NUM_ROWS / 1000, "Bad rows should be counted once");
+    test_assert(parallelImporter.getReport().errors.size() == NUM_ROWS / 1000 &&
+                parallelImporter.getReport().errors[19].line == 20000,
+                "Line numbers should stay right across chunks");
+
+    // Same file streamed from disk with small reads
+    FILE* file = fopen(IMPORT_PATH.c_str(), "wb");
+    fputs("title,duration,genre,plays\n", file);
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+
+    TrackCatalog fromFile;
+    CatalogImporter fileImporter(fromFile);
+    fileImporter.setThreadCount(3);
+    fileImporter.setChunkSize(10);        // shorter than a line
+    fileImporter.setSkipHeader(true);
+    test_assert(fileImporter.importFile(IMPORT_PATH), "File import should succeed");
+    test_assert(sameCatalog(single, fromFile), "Streaming from a file should match an in-memory import");
+    test_assert(fileImporter.getReport().bytesRead == (long long)text.size() + 27, "Every byte should be read");
+    test_assert(fileImporter.getReport().errors[0].line == 1001, "Header line should count in line numbers");
+    remove(IMPORT_PATH.c_str());
+
+    TrackCatalog missing;
+    CatalogImporter missingImporter(missing);
+    test_assert(!missingImporter.importFile("does_not_exist.csv"), "Missing file should fail");
+    test_assert(missing.size() == 0, "Failed import should add nothing");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Catalog Import Tests" << endl;
+    cout << "==================================================" << endl;
+
+    test_csv_rows();
+    test_tsv_rows();
+    test_validation();
+    test_rejected_rows();
+    test_chunks_and_threads();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All import tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some import tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
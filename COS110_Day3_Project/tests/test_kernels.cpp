@@ -0,0 +1,170 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <climits>
+#include <string>
+#include <vector>
+#include "../src/columnkernels.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+// Plain loops the kernels must agree with
+bool kernelsMatchLoops(const int* values, int count, int threshold) {
+    int expectedCount = 0;
+    vector<int> expectedIds;
+    int minimum = INT_MAX;
+    int maximum = INT_MIN;
+    long long sum = 0;
+    for (int i = 0; i < count; i++) {
+        if (values[i] > threshold) {
+            expectedCount++;
+            expectedIds.push_back(i);
+        }
+        minimum = values[i] < minimum ? values[i] : minimum;
+        maximum = values[i] > maximum ? values[i] : maximum;
+        sum += values[i];
+    }
+    if (count == 0) {
+        minimum = 0;
+        maximum = 0;
+    }
+
+    vector<int> ids(count + 1, -1);
+    int found = selectAbove(values, count, threshold, &ids[0]);
+    ids.resize(found);
+    ColumnStats stats = columnStats(values, count);
+    return countAbove(values, count, threshold) == expectedCount && ids == expectedIds &&
+           stats.minimum == minimum && stats.maximum == maximum && stats.sum == sum;
+}
+
+void test_levels() {
+    cout << "\n🧪 Testing Kernel Levels..." << endl;
+
+    KernelLevel best = getSupportedKernelLevel();
+    cout << "   CPU supports: " << kernelLevelName(best) << endl;
+    test_assert(getKernelLevel() == best, "Best supported level should be picked by default");
+
+    setKernelLevel(KERNEL_SCALAR);
+    test_assert(getKernelLevel() == KERNEL_SCALAR, "Scalar level should always be available");
+    setKernelLevel(KERNEL_AVX2);
+    test_assert(getKernelLevel() == best, "Unsupported levels should fall back to the best one");
+    test_assert(string(kernelLevelName(KERNEL_SSE4)) == "sse4", "Levels should have names");
+}
+
+void test_kernels_match_loops() {
+    cout << "\n🧪 Testing Kernels Against Plain Loops..." << endl;
+
+    srand(110);
+    vector<int> values(100003);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = rand() % 3 == 0 ? rand() % 2000000 : rand() - RAND_MAX / 2;
+    }
+    values[17] = INT_MAX;
+    values[99] = INT_MIN;
+    values[5000] = 1000000;
+    values[5001] = 1000001;
+
+    const int THRESHOLDS[] = { 1000000, 0, -1, INT_MIN, INT_MAX, 999999 };
+    for (int level = KERNEL_SCALAR; level <= (int)getSupportedKernelLevel(); level++) {
+        setKernelLevel((KernelLevel)level);
+        bool allMatch = true;
+        for (int t = 0; t < 6; t++) {
+            // Every short length (tail handling) and an unaligned start
+            for (int count = 0; count < 40; count++) {
+                allMatch = allMatch && kernelsMatchLoops(&values[0], count, THRESHOLDS[t]);
+            }
+            allMatch = allMatch && kernelsMatchLoops(&values[0], (int)values.size(), THRESHOLDS[t]);
+            allMatch = allMatch && kernelsMatchLoops(&values[3], (int)values.size() - 3, THRESHOLDS[t]);
+        }
+        test_assert(allMatch, string("Kernels should match plain loops (") + kernelLevelName((KernelLevel)level) + ")");
+    }
+
+    vector<int> big(1000, INT_MAX);
+    ColumnStats stats = columnStats(&big[0], 1000);
+    test_assert(stats.sum == 1000LL * INT_MAX, "Sum should not overflow int");
+    test_assert(countAbove(NULL, 10, 0) == 0 && columnStats(NULL, 0).sum == 0, "NULL columns should be empty");
+    setKernelLevel(KERNEL_AVX2);
+}
+
+void test_catalog_popularity() {
+    cout << "\n🧪 Testing Catalog Popularity Scans..." << endl;
+
+    const int NUM_TRACKS = 50000;
+    TrackCatalog catalog;
+    test_assert(catalog.countPopular() == 0 && catalog.findPopular().empty(), "Empty catalog has no popular tracks");
+
+    srand(1500000);
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        int id = catalog.addTrack("Bella", 60 + rand() % 600, "Hip-Hop");
+        catalog.setPlayCount(id, 999990 + rand() % 20);   // both sides of the line
+    }
+
+    bool allMatch = true;
+    for (int level = KERNEL_SCALAR; level <= (int)getSupportedKernelLevel(); level++) {
+        setKernelLevel((KernelLevel)level);
+        vector<int> expected;
+        for (int id = 0; id < catalog.size(); id++) {
+            if (catalog.isPopular(id)) {
+                expected.push_back(id);
+            }
+        }
+        allMatch = allMatch && catalog.countPopular() == (int)expected.size() && catalog.findPopular() == expected;
+    }
+    test_assert(allMatch, "countPopular()/findPopular() should match isPopular() exactly");
+
+    // Pending concurrent plays push tracks over the line before collection
+    catalog.enableConcurrentPlays();
+    for (int id = 0; id < catalog.size(); id++) {
+        catalog.play(id);
+    }
+    int concurrentCount = 0;
+    for (int id = 0; id < catalog.size(); id++) {
+        concurrentCount += catalog.isPopular(id) ? 1 : 0;
+    }
+    test_assert(catalog.countPopular() == concurrentCount && (int)catalog.findPopular().size() == concurrentCount,
+                "Pending concurrent plays should count");
+
+    long long totalPlays = 0;
+    int maxDuration = 0;
+    for (int id = 0; id < catalog.size(); id++) {
+        totalPlays += catalog.getPlayCount(id);
+        maxDuration = catalog.getDuration(id) > maxDuration ? catalog.getDuration(id) : maxDuration;
+    }
+    test_assert(catalog.playCountStats().sum == totalPlays, "Play count total should include pending plays");
+    test_assert(catalog.durationStats().maximum == maxDuration, "Longest duration should be found");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Column Kernel Tests" << endl;
+    cout << "================================================" << endl;
+
+    test_levels();
+    test_kernels_match_loops();
+    test_catalog_popularity();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All column kernel tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some column kernel tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -3,7 +3,10 @@
 #include <string>
 #include <vector>
 #include <sstream>
+#include <cstdlib>
+#include <new>
 #include "../src/musictrack.h"
+#include "../src/trackpool.h"
 
 using namespace std;
 
@@ -11,6 +14,35 @@ using namespace std;
 int tests_passed = 0;
 int total_tests = 0;
 
+// GCC cannot tell that the replacement operators below pair malloc/free
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+// Count every heap allocation, so the pool tests can compare them
+static long allocationCount = 0;
+
+#if __cplusplus >= 201103L
+void* operator new(size_t size) {
+#else
+void* operator new(size_t size) throw(bad_alloc) {
+#endif
+    allocationCount++;
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == NULL) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) throw() {
+    free(memory);
+}
+
+#if __cplusplus >= 201402L
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+#endif
+
 void test_assert(bool condition, const string& test_name) {
     total_tests++;
     if (condition) {
@@ -218,6 +250,102 @@ void test_stress_operations() {
     cout << "   Successfully completed stress testing with 100,000+ operations" << endl;
 }
 
+void test_pool_allocation() {
+    cout << "\n🧪 Testing Pooled Track Allocation..." << endl;
+
+    const int NUM_TRACKS = 1000;
+    vector<MusicTrack> requests;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "Requested Track With A Long Title " << i;
+        requests.push_back(MusicTrack(ss.str(), 180 + i, "Pop"));
+    }
+
+    // Plain new/delete: every track and every long title is an allocation
+    vector<MusicTrack*> plain(NUM_TRACKS);
+    long before = allocationCount;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        plain[i] = new MusicTrack(requests[i]);
+    }
+    long plainAllocations = allocationCount - before;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        delete plain[i];
+    }
+
+    MusicTrackPool pool(256);
+    vector<MusicTrack*> pooled(NUM_TRACKS);
+    before = allocationCount;
+    pool.createMany(&requests[0], NUM_TRACKS, &pooled[0]);
+    long firstBatchAllocations = allocationCount - before;
+
+    test_assert(pool.liveCount() == NUM_TRACKS && pool.slabCount() == 4, "Pool should hold the batch in four slabs");
+    test_assert(pooled[0]->getTitle() == requests[0].getTitle() && pooled[999]->getDuration() == 1179 &&
+                pooled[999]->getGenre() == "Pop" && pooled[999]->usesTitleArena(),
+                "Pooled tracks should copy every field");
+    test_assert(firstBatchAllocations < plainAllocations / 10,
+                "Pooled batch should allocate far less than new/delete");
+
+    // Released slots and the title buffer are reused by the next batch
+    pool.releaseAll();
+    test_assert(pool.liveCount() == 0 && pool.capacity() == 1024, "Release all should keep the slabs");
+    before = allocationCount;
+    pool.createMany(&requests[0], NUM_TRACKS, &pooled[0]);
+    long secondBatchAllocations = allocationCount - before;
+    test_assert(secondBatchAllocations == 0, "Second batch should not allocate at all");
+    test_assert(pooled[500]->getTitle() == requests[500].getTitle(), "Reused slots should hold the new tracks");
+
+    MusicTrack* last = pooled[9];
+    pool.releaseMany(&pooled[0], 10);
+    test_assert(pool.liveCount() == NUM_TRACKS - 10, "Bulk release should free each track");
+    MusicTrack* again = pool.create("Bella", 206, "Hip-Hop");
+    test_assert(again == last && again->getTitle() == "Bella", "The last released slot should be handed out first");
+
+    MusicTrack outside("Outside", 180, "Pop");
+    pool.release(again);
+    pool.release(again);
+    pool.release(&outside);
+    pool.release(NULL);
+    test_assert(pool.liveCount() == NUM_TRACKS - 10, "Double, foreign and NULL releases should be ignored");
+
+    // The rest of the batch is destroyed by the pool's destructor
+    {
+        MusicTrackPool scoped(16);
+        for (int i = 0; i < 100; i++) {
+            scoped.create(requests[i])->play();
+        }
+        test_assert(scoped.liveCount() == 100 && scoped.slabCount() == 7, "Scoped pool should grow by slabs");
+    }
+    test_assert(true, "Pool destruction with live tracks completed without errors");
+
+    // One track lives on while many others come and go
+    MusicTrackPool churn(64);
+    MusicTrack* resident = churn.create("Bella", 206, "Hip-Hop");
+    size_t settled = 0;
+    for (int i = 0; i < 200000; i++) {
+        churn.release(churn.create(requests[i % NUM_TRACKS]));
+        if (i == NUM_TRACKS) {
+            settled = churn.memoryBytes();
+        }
+    }
+    test_assert(churn.memoryBytes() == settled && resident->getTitle() == "Bella",
+                "Create/release cycles should not grow the pool while a track stays live");
+
+    // A plain copy owns its title, so reusing the slot cannot change it
+    MusicTrack* pooledBella = churn.create("Bella", 206, "Hip-Hop");
+    MusicTrack copy = *pooledBella;
+    churn.release(pooledBella);
+    churn.release(resident);
+    churn.create("Zombie", 223, "Hip-Hop");
+    test_assert(copy.getTitle() == "Bella" && !copy.usesTitleArena(),
+                "A copy of a pooled track should survive its release");
+
+    MusicTrack* original = churn.create("Est-ce que tu m'aimes", 234, "Pop");
+    MusicTrack* copied = churn.create(*original);
+    churn.release(original);
+    churn.create("Zombie", 223, "Hip-Hop");
+    test_assert(copied->getTitle() == "Est-ce que tu m'aimes", "A pool copy of a pool track should keep its own title");
+}
+
 int main() {
     cout << "🎵 Maître Gims Music Studio - Memory Management Tests" << endl;
     cout << "====================================================" << endl;
@@ -229,6 +357,7 @@ int main() {
     test_string_memory_management();
     test_scope_and_lifetime();
     test_stress_operations();
+    test_pool_allocation();
 
     cout << "\n📊 Test Results:" << endl;
     cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
@@ -0,0 +1,300 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <unistd.h>
+#include "../src/playlog.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+const string LOG_PATH = "test_playlog.log";
+
+void addTracks(TrackCatalog& catalog, int count) {
+    for (int i = 0; i < count; i++) {
+        catalog.addTrack(i % 2 == 0 ? "Bella" : "Sapés comme jamais", 200 + i, "Hip-Hop");
+    }
+}
+
+bool sameCounts(const TrackCatalog& a, const TrackCatalog& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (int id = 0; id < a.size(); id++) {
+        if (a.getPlayCount(id) != b.getPlayCount(id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Play, set and correct counts with the log attached, then rebuild a
+// fresh catalog from the log
+bool replayMatches(PlayLogDurability durability) {
+    remove(LOG_PATH.c_str());
+    TrackCatalog live;
+    addTracks(live, 100);
+
+    PlayLog log;
+    if (!log.open(LOG_PATH, durability)) {
+        return false;
+    }
+    log.setGroupSize(64);
+    live.attachPlayLog(&log);
+
+    srand(267);
+    for (int i = 0; i < 5000; i++) {
+        live.play(rand() % 100);
+    }
+    live.setPlayCount(3, 1500000);
+    live.resetPlayCount(4);
+    PlayEvent batch[3] = { { 5, 10 }, { 6, -1000000 }, { 5, 2 } };
+    live.applyPlayEvents(batch, 3);
+    if (!log.close()) {
+        return false;
+    }
+
+    TrackCatalog rebuilt;
+    addTracks(rebuilt, 100);
+    return PlayLog::replay(LOG_PATH, rebuilt) && sameCounts(live, rebuilt);
+}
+
+void test_replay() {
+    cout << "\n🧪 Testing Replay..." << endl;
+
+    test_assert(replayMatches(PLAYLOG_BUFFERED), "Replay should rebuild counts (buffered)");
+    test_assert(replayMatches(PLAYLOG_GROUP_COMMIT), "Replay should rebuild counts (group commit)");
+    test_assert(replayMatches(PLAYLOG_SYNC_EACH), "Replay should rebuild counts (sync each)");
+
+    TrackCatalog catalog;
+    addTracks(catalog, 10);
+    PlayLogReplay report;
+    test_assert(PlayLog::replay("does_not_exist.log", catalog, &report) && report.eventsRead == 0,
+                "Missing log should replay as empty");
+
+    // Appending to an existing log continues its frame sequence
+    remove(LOG_PATH.c_str());
+    PlayLog log;
+    log.open(LOG_PATH, PLAYLOG_SYNC_EACH);
+    log.append(1, 5);
+    log.close();
+    log.open(LOG_PATH, PLAYLOG_SYNC_EACH);
+    log.append(1, 7);
+    log.append(99, 1);   // no such track
+    log.close();
+    test_assert(PlayLog::replay(LOG_PATH, catalog, &report) && catalog.getPlayCount(1) == 12,
+                "Reopened log should append after the old frames");
+    test_assert(report.framesRead == 3 && report.eventsRead == 3 && report.eventsApplied == 2 && !report.truncatedTail,
+                "Replay should report what it read");
+
+    catalog.attachPlayLog(&log);
+    test_assert(!PlayLog::replay(LOG_PATH, catalog), "Replay into a logging catalog should be refused");
+    catalog.attachPlayLog(NULL);
+
+    // reset() empties the log but keeps numbering frames
+    log.open(LOG_PATH, PLAYLOG_SYNC_EACH);
+    uint64_t before = log.getLastSequence();
+    test_assert(log.reset() && log.append(2, 4) && log.getLastSequence() == before + 1, "reset() should keep the frame sequence");
+    log.close();
+    TrackCatalog afterReset;
+    addTracks(afterReset, 10);
+    test_assert(PlayLog::replay(LOG_PATH, afterReset, &report) && report.eventsRead == 1 &&
+                report.lastSequence == before + 1 && afterReset.getPlayCount(2) == 4, "Reset log should replay only new frames");
+
+    FILE* file = fopen(LOG_PATH.c_str(), "wb");
+    fputs("Est-ce que tu m'aimes? Je ne sais pas si tu m'aimes", file);
+    fclose(file);
+    test_assert(!log.open(LOG_PATH) && !PlayLog::replay(LOG_PATH, catalog), "Files that are not logs should be rejected");
+}
+
+void test_torn_tail() {
+    cout << "\n🧪 Testing Torn Tail Recovery..." << endl;
+
+    remove(LOG_PATH.c_str());
+    PlayLog log;
+    log.open(LOG_PATH, PLAYLOG_SYNC_EACH);
+    for (int i = 0; i < 10; i++) {
+        log.append(0, 1);
+    }
+    log.close();
+
+    // A crash in the middle of the last frame
+    FILE* file = fopen(LOG_PATH.c_str(), "ab");
+    PlayLogFrameHeader header = { 50, 12345, 11 };
+    fwrite(&header, sizeof(header), 1, file);
+    fwrite("Zombie", 1, 6, file);
+    fclose(file);
+
+    TrackCatalog catalog;
+    addTracks(catalog, 1);
+    PlayLogReplay report;
+    test_assert(PlayLog::replay(LOG_PATH, catalog, &report) && catalog.getPlayCount(0) == 10 && report.truncatedTail,
+                "Torn frame should be ignored by replay");
+
+    // A damaged event fails the checksum
+    file = fopen(LOG_PATH.c_str(), "r+b");
+    fseek(file, sizeof(PlayLogFileHeader) + 9 * (sizeof(PlayLogFrameHeader) + sizeof(PlayEvent)) +
+                sizeof(PlayLogFrameHeader) + sizeof(int), SEEK_SET);
+    int damaged = 1000;
+    fwrite(&damaged, sizeof(damaged), 1, file);
+    fclose(file);
+
+    log.open(LOG_PATH, PLAYLOG_SYNC_EACH);
+    log.append(0, 100);
+    log.close();
+    TrackCatalog recovered;
+    addTracks(recovered, 1);
+    test_assert(PlayLog::replay(LOG_PATH, recovered, &report) && !report.truncatedTail && report.framesRead == 10,
+                "open() should cut the log at its last good frame");
+    test_assert(recovered.getPlayCount(0) == 109, "Events before the damage and after reopening should be kept");
+}
+
+void test_durability_modes() {
+    cout << "\n🧪 Testing Durability Modes..." << endl;
+
+    remove(LOG_PATH.c_str());
+    PlayLog log;
+    test_assert(!log.append(0, 1), "Closed log should reject events");
+    log.open(LOG_PATH, PLAYLOG_GROUP_COMMIT);
+    log.setGroupInterval(0);
+    log.setGroupSize(100);
+    test_assert(log.getGroupSize() == 100 && log.getGroupInterval() == 0, "Group settings should be stored");
+
+    for (int i = 0; i < 250; i++) {
+        log.append(i % 7, 1);
+    }
+    test_assert(log.getSyncCount() == 2 && log.getDurableCount() == 200, "Group commit should sync once per group");
+    test_assert(log.sync() && log.getDurableCount() == 250 && log.getSyncCount() == 3, "sync() should flush the partial group");
+
+    log.setDurability(PLAYLOG_BUFFERED);
+    for (int i = 0; i < 250; i++) {
+        log.append(i % 7, 1);
+    }
+    test_assert(log.getSyncCount() == 3 && log.getDurableCount() == 250, "Buffered mode should not sync on its own");
+
+    log.setDurability(PLAYLOG_SYNC_EACH);
+    log.append(1, 1);
+    test_assert(log.getDurableCount() == log.getEventCount() && log.getSyncCount() == 4,
+                "Sync-each append should return durable");
+    test_assert(log.close() && !log.isOpen() && !log.hasFailed(), "close() should succeed");
+
+    log.open(LOG_PATH, PLAYLOG_GROUP_COMMIT);
+    log.setGroupInterval(20);
+    log.setGroupSize(1000000);
+    log.append(2, 1);
+    log.append(2, 1);
+    usleep(200000);
+    test_assert(log.getDurableCount() == 2 && log.getSyncCount() == 1, "Open groups should be committed after the interval");
+    log.close();
+
+    TrackCatalog catalog;
+    addTracks(catalog, 7);
+    PlayLogReplay report;
+    PlayLog::replay(LOG_PATH, catalog, &report);
+    test_assert(report.eventsRead == 503 && catalog.playCountStats().sum == 503, "Every mode should reach the file");
+}
+
+struct AppendTask {
+    PlayLog* log;
+    int trackId;
+    int events;
+};
+
+void* appendEvents(void* arg) {
+    AppendTask* task = (AppendTask*)arg;
+    for (int i = 0; i < task->events; i++) {
+        task->log->append(task->trackId, 1);
+    }
+    return NULL;
+}
+
+void test_shared_sync() {
+    cout << "\n🧪 Testing Shared Syncs Across Threads..." << endl;
+
+    const int NUM_THREADS = 8;
+    const int EVENTS_PER_THREAD = 200;
+    remove(LOG_PATH.c_str());
+    PlayLog log;
+    log.open(LOG_PATH, PLAYLOG_SYNC_EACH);
+
+    AppendTask tasks[NUM_THREADS];
+    pthread_t threads[NUM_THREADS];
+    for (int t = 0; t < NUM_THREADS; t++) {
+        tasks[t].log = &log;
+        tasks[t].trackId = t;
+        tasks[t].events = EVENTS_PER_THREAD;
+        pthread_create(&threads[t], NULL, appendEvents, &tasks[t]);
+    }
+    for (int t = 0; t < NUM_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    cout << "   " << log.getEventCount() << " events, " << log.getSyncCount() << " syncs" << endl;
+    test_assert(log.getDurableCount() == NUM_THREADS * EVENTS_PER_THREAD, "Every event should be durable");
+    test_assert(log.getSyncCount() < NUM_THREADS * EVENTS_PER_THREAD, "Threads should share syncs");
+    log.close();
+
+    TrackCatalog catalog;
+    addTracks(catalog, NUM_THREADS);
+    PlayLog::replay(LOG_PATH, catalog);
+    bool allCounted = true;
+    for (int t = 0; t < NUM_THREADS; t++) {
+        allCounted = allCounted && catalog.getPlayCount(t) == EVENTS_PER_THREAD;
+    }
+    test_assert(allCounted, "Concurrent appends should all replay");
+
+    // Concurrent catalog plays are logged when collected
+    remove(LOG_PATH.c_str());
+    TrackCatalog live;
+    addTracks(live, 4);
+    live.enableConcurrentPlays();
+    log.open(LOG_PATH);
+    live.attachPlayLog(&log);
+    for (int i = 0; i < 1000; i++) {
+        live.play(i % 4);
+    }
+    live.collectConcurrentPlays();
+    log.close();
+    TrackCatalog rebuilt;
+    addTracks(rebuilt, 4);
+    PlayLog::replay(LOG_PATH, rebuilt);
+    test_assert(sameCounts(live, rebuilt), "Collected concurrent plays should be logged");
+    remove(LOG_PATH.c_str());
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Play Log Tests" << endl;
+    cout << "============================================" << endl;
+
+    test_replay();
+    test_torn_tail();
+    test_durability_modes();
+    test_shared_sync();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All play log tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some play log tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "../src/trackcatalog.h"
+#include "../src/popularityindex.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+// Reference ordering for the brute-force checks
+const TrackCatalog* sortCatalog = NULL;
+
+bool mostPlayedFirst(int a, int b) {
+    int playsA = sortCatalog->getPlayCount(a);
+    int playsB = sortCatalog->getPlayCount(b);
+    return playsA > playsB || (playsA == playsB && a < b);
+}
+
+vector<int> scanOrder(const TrackCatalog& catalog) {
+    vector<int> ids(catalog.size());
+    for (int i = 0; i < catalog.size(); i++) {
+        ids[i] = i;
+    }
+    sortCatalog = &catalog;
+    sort(ids.begin(), ids.end(), mostPlayedFirst);
+    return ids;
+}
+
+void test_index_basics() {
+    cout << "\n🧪 Testing PopularityIndex..." << endl;
+
+    PopularityIndex index;
+    test_assert(index.size() == 0 && index.topTracks(3).empty(), "New index should be empty");
+
+    index.addTrack(500);      // 0
+    index.addTrack(1500000);  // 1
+    index.addTrack(500);      // 2
+    index.addTrack(2000000);  // 3
+
+    vector<int> top = index.topTracks(3);
+    test_assert(top.size() == 3 && top[0] == 3 && top[1] == 1 && top[2] == 0,
+                "topTracks() should list the most played first");
+    test_assert(index.rank(3) == 1 && index.rank(2) == 4, "rank() should count from 1");
+    test_assert(index.rank(0) < index.rank(2), "Ties should rank the lower id first");
+    test_assert(index.countAbove(1000000) == 2, "countAbove() should count popular tracks");
+
+    index.update(2, 3000000);
+    test_assert(index.rank(2) == 1 && index.topTracks(1)[0] == 2, "update() should move a track up");
+    index.update(2, 0);
+    test_assert(index.rank(2) == 4 && index.getPlayCount(2) == 0, "update() should move a track down");
+
+    test_assert(index.rank(-1) == 0 && index.rank(4) == 0, "Invalid ids should have rank 0");
+    test_assert(index.topTracks(10).size() == 4, "Asking for too many tracks should return them all");
+    index.clear();
+    test_assert(index.size() == 0 && index.countAbove(-1) == 0, "clear() should empty the index");
+}
+
+void test_catalog_index() {
+    cout << "\n🧪 Testing Catalog Popularity Queries..." << endl;
+
+    TrackCatalog catalog;
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");
+    catalog.setPlayCount(1, 5000000);
+
+    test_assert(catalog.topTracks(1).empty() && catalog.getPopularityRank(1) == 0,
+                "Queries should be empty before the index is enabled");
+
+    catalog.enablePopularityIndex();
+    test_assert(catalog.hasPopularityIndex(), "Index should be enabled");
+    test_assert(catalog.topTracks(1)[0] == 1, "Existing counts should be indexed");
+
+    int zombie = catalog.addTrack("Zombie", 223, "Hip-Hop");
+    catalog.setPlayCount(zombie, 7000000);
+    test_assert(catalog.getPopularityRank(zombie) == 1, "New tracks and setPlayCount() should be indexed");
+
+    for (int i = 0; i < 2000; i++) {
+        catalog.play(0);
+    }
+    test_assert(catalog.getPopularityRank(0) == 3, "play() should keep the index current");
+
+    PlayEvent events[] = { { 0, 9000000 }, { zombie, -7000000 } };
+    catalog.applyPlayEvents(events, 2);
+    vector<int> popular = catalog.tracksAbove(1000000);
+    test_assert(popular.size() == 2 && popular[0] == 0 && popular[1] == 1,
+                "applyPlayEvents() should keep the index current");
+}
+
+void test_against_scan() {
+    cout << "\n🧪 Testing Index Against Full Scans..." << endl;
+
+    const int NUM_TRACKS = 3000;
+    TrackCatalog catalog;
+    catalog.enablePopularityIndex();
+    srand(110);
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        int id = catalog.addTrack("Track", 180, "Pop");
+        catalog.setPlayCount(id, rand() % 2000000);
+    }
+
+    // Random mix of updates, including lots of ties
+    for (int step = 0; step < 20000; step++) {
+        int id = rand() % NUM_TRACKS;
+        switch (step % 4) {
+        case 0: catalog.play(id); break;
+        case 1: catalog.setPlayCount(id, rand() % 50); break;
+        case 2: catalog.setPlayCount(id, 1000000 + rand() % 3); break;
+        default: {
+            PlayEvent event = { id, rand() % 1000 - 500 };
+            catalog.applyPlayEvents(&event, 1);
+        }
+        }
+    }
+
+    vector<int> expected = scanOrder(catalog);
+    test_assert(catalog.topTracks(NUM_TRACKS) == expected, "Full index order should match a sorted scan");
+
+    bool ranksMatch = true;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        ranksMatch = ranksMatch && catalog.getPopularityRank(expected[i]) == i + 1;
+    }
+    test_assert(ranksMatch, "Every rank should match the sorted scan");
+
+    int popularCount = 0;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        if (catalog.isPopular(i)) {
+            popularCount++;
+        }
+    }
+    vector<int> popular = catalog.tracksAbove(1000000);
+    bool allPopular = (int)popular.size() == popularCount;
+    for (size_t i = 0; i < popular.size(); i++) {
+        allPopular = allPopular && catalog.isPopular(popular[i]);
+    }
+    test_assert(allPopular, "tracksAbove(1000000) should match isPopular()");
+}
+
+void test_concurrent_collect() {
+    cout << "\n🧪 Testing Index With Concurrent Plays..." << endl;
+
+    TrackCatalog catalog;
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    catalog.addTrack("Zombie", 223, "Hip-Hop");
+    catalog.setPlayCount(0, 10);
+    catalog.enablePopularityIndex();
+    catalog.enableConcurrentPlays(4);
+
+    for (int i = 0; i < 20; i++) {
+        catalog.play(1);
+    }
+    test_assert(catalog.topTracks(1)[0] == 0, "Uncollected plays should not move the index yet");
+    catalog.collectConcurrentPlays();
+    test_assert(catalog.topTracks(1)[0] == 1, "collectConcurrentPlays() should update the index");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Popularity Index Tests" << endl;
+    cout << "====================================================" << endl;
+
+    test_index_basics();
+    test_catalog_index();
+    test_against_scan();
+    test_concurrent_collect();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All popularity index tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some popularity index tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
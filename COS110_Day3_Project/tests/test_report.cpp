@@ -0,0 +1,158 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <string>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../src/trackreport.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+const char* REPORT_PATH = "test_report.tmp";
+
+// The layout displayTrackInfo() in main.cpp has always printed
+string expectedRecord(MusicTrack& track) {
+    stringstream out;
+    out << "🎵 Track: " << track.getTitle() << endl;
+    out << "   Duration: " << track.getFormattedDuration()
+        << " (" << track.getDuration() << " seconds)" << endl;
+    out << "   Genre: " << track.getGenre() << endl;
+    out << "   Play Count: " << track.getPlayCount() << endl;
+    out << "   Popular: " << (track.isPopular() ? "Yes" : "No") << endl;
+    out << endl;
+    return out.str();
+}
+
+int openReport() {
+    return open(REPORT_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+}
+
+string readReport() {
+    string text;
+    FILE* file = fopen(REPORT_PATH, "rb");
+    if (file != NULL) {
+        char chunk[4096];
+        size_t count;
+        while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            text.append(chunk, count);
+        }
+        fclose(file);
+    }
+    return text;
+}
+
+void test_track_layout() {
+    cout << "\n🧪 Testing Report Layout..." << endl;
+
+    MusicTrack bella("Bella", 206, "Hip-Hop");
+    bella.setPlayCount(1500000);
+    MusicTrack ouAller("Où aller", 267, "R&B");
+    ouAller.setPlayCount(1000000);
+    MusicTrack longTrack("Long Track", 3661, "Test");
+    TitleArena arena;
+    MusicTrack zombie(arena, "Zombie", 223, "Hip-Hop");
+
+    int fd = openReport();
+    {
+        TrackReportWriter report(fd);
+        report.writeTrack(bella);
+        test_assert(report.getBytesWritten() == 0, "Short reports should stay buffered");
+        report.writeTrack(ouAller);
+        report.writeTrack(longTrack);
+        report.writeTrack(zombie);
+        test_assert(report.flush() && !report.hasFailed(), "flush() should succeed");
+        report.writeText("🎤 Merci!\n");
+    }
+    close(fd);
+
+    string expected = expectedRecord(bella) + expectedRecord(ouAller) +
+                      expectedRecord(longTrack) + expectedRecord(zombie);
+    string report = readReport();
+    test_assert(report.compare(0, expected.size(), expected) == 0,
+                "Records should match displayTrackInfo() byte for byte");
+    test_assert(report.find("   Popular: Yes\n") != string::npos && report.find("   Popular: No\n") != string::npos,
+                "Popular line should say Yes or No");
+    test_assert(report == expected + "🎤 Merci!\n", "Destructor should flush the rest");
+}
+
+void test_catalog_report() {
+    cout << "\n🧪 Testing Catalog Reports..." << endl;
+
+    const int NUM_TRACKS = 20000;
+    TrackCatalog catalog;
+    string expected;
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << "J'me tire (Live " << i << ")";
+        int id = catalog.addTrack(ss.str(), 60 + i % 600, (i % 3 == 0) ? "Hip-Hop" : "Pop");
+        catalog.setPlayCount(id, i * 100);
+        MusicTrack track = catalog.getTrack(id);
+        expected += expectedRecord(track);
+    }
+
+    // A small buffer so the report goes out in many chunks
+    int fd = openReport();
+    TrackReportWriter report(fd, 4096);
+    report.writeCatalog(catalog);
+    report.writeTrack(catalog, -1);
+    report.writeTrack(catalog, NUM_TRACKS);
+    test_assert(report.flush(), "Catalog report should be written");
+    test_assert(report.getBytesWritten() == (long long)expected.size(), "Byte count should match the text");
+    close(fd);
+    test_assert(readReport() == expected, "Catalog report should match the MusicTrack layout");
+}
+
+void test_large_text_and_failures() {
+    cout << "\n🧪 Testing Oversized Text and Failed Writes..." << endl;
+
+    MusicTrack epic(string(10000, 'a'), 600, "Pop");
+    int fd = openReport();
+    {
+        TrackReportWriter report(fd, 100);
+        report.writeTrack(epic);
+    }
+    close(fd);
+    test_assert(readReport() == expectedRecord(epic), "Titles larger than the buffer should be written through");
+
+    TrackReportWriter broken(-1);
+    broken.writeTrack(epic);
+    test_assert(!broken.flush() && broken.hasFailed(), "Failed writes should be reported");
+    test_assert(broken.getBytesWritten() == 0, "Nothing should count as written after a failure");
+
+    remove(REPORT_PATH);
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Report Writer Tests" << endl;
+    cout << "=================================================" << endl;
+
+    test_track_layout();
+    test_catalog_report();
+    test_large_text_and_failures();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All report writer tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some report writer tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
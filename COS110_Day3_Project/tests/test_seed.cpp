@@ -0,0 +1,113 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "../src/seedcatalog.h"
+#include "../src/musictrack.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+#if __cplusplus >= 201703L
+// Checked while compiling, before the test even runs
+static_assert(GIMS_SEED_COUNT == 6, "six seed tracks");
+static_assert(GIMS_SEED_TRACKS[0].titleView() == "Bella" && GIMS_SEED_TRACKS[0].duration == 206,
+              "Bella is the first seed track");
+static_assert(GIMS_SEED_TRACKS[3].genreView() == "R&B", "seed genres are views");
+#endif
+
+static SEED_CONSTEXPR SeedTrack BROKEN_SEEDS[] = {
+    SEED_TRACK("", 0, 0, ""),
+    SEED_TRACK("Sapés comme jamais", 3, 35, "Hip-Hop")
+};
+
+void test_seed_data() {
+    cout << "\n🧪 Testing Seed Data..." << endl;
+
+    test_assert(GIMS_SEED_COUNT == 6 && seedTracksValid(GIMS_SEED_TRACKS, GIMS_SEED_COUNT),
+                "The built-in seed should be valid");
+    test_assert(string(GIMS_SEED_TRACKS[1].title, GIMS_SEED_TRACKS[1].titleLength) == "Est-ce que tu m'aimes" &&
+                GIMS_SEED_TRACKS[1].duration == 234, "Durations should be worked out from minutes and seconds");
+    test_assert(GIMS_SEED_TRACKS[3].titleLength == (int)string("Où aller").size(), "Title lengths should count bytes");
+    test_assert(!seedTracksValid(BROKEN_SEEDS, 2) && seedTracksValid(BROKEN_SEEDS + 1, 1),
+                "Entries without title, genre or duration should be invalid");
+}
+
+void test_seed_tracks() {
+    cout << "\n🧪 Testing Tracks From Seeds..." << endl;
+
+    MusicTrack defaultTrack;
+    test_assert(defaultTrack.getTitle() == "Bella" && defaultTrack.getDuration() == 206 &&
+                defaultTrack.getGenre() == "Hip-Hop" && defaultTrack.getPlayCount() == 0,
+                "Default track should still be Bella");
+
+    MusicTrack ouAller(GIMS_SEED_TRACKS[3]);
+    MusicTrack same("Où aller", 267, "R&B");
+    test_assert(ouAller.getTitle() == same.getTitle() && ouAller.getDuration() == same.getDuration() &&
+                ouAller.getGenreId() == same.getGenreId() && ouAller.getPlayCount() == 0,
+                "A seed track should match the string constructor");
+
+    MusicTrack broken(BROKEN_SEEDS[0]);
+    test_assert(broken.getTitle() == "Untitled Track" && broken.getDuration() == 180 && broken.getGenre() == "Unknown",
+                "Invalid seed fields should get the usual defaults");
+}
+
+void test_seed_catalog() {
+    cout << "\n🧪 Testing Seeded Catalog..." << endl;
+
+    TrackCatalog catalog;
+    catalog.addTrack("Sapés comme jamais", 215, "Hip-Hop");
+    catalog.enableTitleIndex();
+    int first = catalog.addSeedTracks(GIMS_SEED_TRACKS, GIMS_SEED_COUNT);
+    test_assert(first == 1 && catalog.size() == 1 + GIMS_SEED_COUNT, "Seed tracks should get consecutive ids");
+
+    bool sameTracks = true;
+    for (int i = 0; i < GIMS_SEED_COUNT; i++) {
+        MusicTrack expected(GIMS_SEED_TRACKS[i]);
+        sameTracks = sameTracks && catalog.getTitle(first + i) == expected.getTitle() &&
+                     catalog.getDuration(first + i) == expected.getDuration() &&
+                     catalog.getGenre(first + i) == expected.getGenre() && catalog.getPlayCount(first + i) == 0;
+    }
+    test_assert(sameTracks, "Seeded catalog should hold every seed track");
+    test_assert(catalog.genreCount() == 3 && catalog.findTitle("Zombie") == first + 4,
+                "Genres should be shared and indexes kept up to date");
+
+    TrackCatalog broken;
+    broken.addSeedTracks(BROKEN_SEEDS, 2);
+    test_assert(broken.getTitle(0) == "Untitled Track" && broken.getDuration(0) == 180 && broken.getGenre(0) == "Unknown",
+                "Invalid seed fields should get the catalog defaults");
+    test_assert(broken.addSeedTracks(NULL, 3) == 2 && broken.size() == 2, "An empty seed should add nothing");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Seed Catalog Tests" << endl;
+    cout << "================================================" << endl;
+
+    test_seed_data();
+    test_seed_tracks();
+    test_seed_catalog();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All seed catalog tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some seed catalog tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
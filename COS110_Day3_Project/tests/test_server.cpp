@@ -0,0 +1,251 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "../src/trackcatalog.h"
+#include "../src/catalogserver.h"
+#include "../src/catalogclient.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+void buildCatalog(TrackCatalog& catalog) {
+    catalog.addTrack("Bella", 206, "Hip-Hop");
+    catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");
+    catalog.addTrack("Zombie", 223, "Hip-Hop");
+}
+
+string answer(CatalogServer& server, const string& request) {
+    string response;
+    server.handleRequest(request.data(), (int)request.size(), response);
+    return response;
+}
+
+void test_protocol() {
+    cout << "\n🧪 Testing Request Handling..." << endl;
+
+    TrackCatalog catalog;
+    buildCatalog(catalog);
+    CatalogServer server(catalog);
+
+    test_assert(answer(server, "PING") == "OK PONG\n" && answer(server, "SIZE") == "OK 3\n",
+                "PING and SIZE should answer");
+    test_assert(answer(server, "PLAY 1") == "OK 1\n" && answer(server, "PLAY 1 41") == "OK 42\n" &&
+                answer(server, "GET 1") == "OK 42\n" && catalog.getPlayCount(1) == 42,
+                "PLAY should count plays, one or many");
+    test_assert(answer(server, "SET 0 1500000") == "OK 1500000\n" && answer(server, "POPULAR 0") == "OK 1\n" &&
+                answer(server, "POPULAR 2") == "OK 0\n", "SET and POPULAR should match the catalog");
+    test_assert(answer(server, "TITLE 1") == "OK Est-ce que tu m'aimes\n", "TITLE should return the whole title");
+    test_assert(answer(server, "TOP 2") == "OK 2 0:1500000 1:42\n" && answer(server, "TOP 10") == "OK 3 0:1500000 1:42 2:0\n",
+                "TOP should list the most played tracks");
+    test_assert(answer(server, "  GET   1 \r") == "OK 42\n", "Extra spaces and a CR should be ignored");
+
+    test_assert(answer(server, "") == "ERR empty request\n" && answer(server, "DANCE 1") == "ERR unknown command\n",
+                "Unknown requests should get an error");
+    test_assert(answer(server, "GET 3") == "ERR bad track id\n" && answer(server, "GET -1") == "ERR bad number\n" &&
+                answer(server, "GET 99999999999") == "ERR bad number\n", "Bad ids should get an error");
+    test_assert(answer(server, "SET 1") == "ERR usage: SET <id> <count>\n" &&
+                answer(server, "GET 1 2") == "ERR wrong number of arguments\n" &&
+                answer(server, "PLAY 1 2 3") == "ERR too many arguments\n" && catalog.getPlayCount(1) == 42,
+                "Wrong arguments should change nothing");
+    test_assert(server.requestCount() == 20, "Every request should be counted");
+}
+
+void test_shard_commands() {
+    cout << "\n🧪 Testing Shard Commands..." << endl;
+
+    TrackCatalog catalog;
+    buildCatalog(catalog);
+    CatalogServer server(catalog);
+
+    test_assert(answer(server, "ADD 267 1200000 R&B\tOù aller") == "OK 3\n" && catalog.getTitle(3) == "Où aller" &&
+                catalog.getGenre(3) == "R&B" && catalog.getPlayCount(3) == 1200000,
+                "ADD should append a track with its plays");
+    test_assert(answer(server, "ADD 0 0 \tUntitled") == "OK 4\n" && catalog.getDuration(4) == 180 &&
+                catalog.getGenre(4) == "Unknown", "ADD should apply the usual defaults");
+    test_assert(answer(server, "ADD 200 0 Pop") == "ERR usage: ADD <duration> <plays> <genre>\\t<title>\n" &&
+                catalog.size() == 5, "ADD without a title should change nothing");
+    test_assert(answer(server, "TRACK 3") == "OK 267 1200000 R&B\tOù aller\n", "TRACK should return every field");
+    test_assert(answer(server, "STATS") == "OK 5 1200000 1\n", "STATS should total the catalog");
+}
+
+struct ServerThread {
+    CatalogServer* server;
+};
+
+void* runServer(void* arg) {
+    ((ServerThread*)arg)->server->run();
+    return NULL;
+}
+
+struct PlayWorker {
+    int port;
+    int track;
+    bool ok;
+};
+
+void* playMany(void* arg) {
+    PlayWorker* worker = (PlayWorker*)arg;
+    CatalogClient client;
+    worker->ok = client.connectTcp("127.0.0.1", worker->port);
+    stringstream request;
+    request << "PLAY " << worker->track;
+    for (int batch = 0; batch < 10 && worker->ok; batch++) {
+        for (int i = 0; i < 100; i++) {
+            client.send(request.str());
+        }
+        string response;
+        for (int i = 0; i < 100 && worker->ok; i++) {
+            worker->ok = client.receive(response) && response.compare(0, 3, "OK ") == 0;
+        }
+    }
+    return NULL;
+}
+
+void test_network() {
+    cout << "\n🧪 Testing Clients Over Sockets..." << endl;
+
+    TrackCatalog catalog;
+    buildCatalog(catalog);
+    CatalogServer server(catalog);
+    string socketPath = "/tmp/test_server_catalog.sock";
+    test_assert(server.listenTcp(0) && server.getPort() > 0 && server.listenUnix(socketPath),
+                "Server should listen on TCP and a Unix socket");
+
+    ServerThread context = { &server };
+    pthread_t thread;
+    pthread_create(&thread, NULL, runServer, &context);
+
+    CatalogClient client;
+    string response;
+    test_assert(client.connectTcp("127.0.0.1", server.getPort()) && client.call("PING", response) &&
+                response == "OK PONG", "TCP client should get an answer");
+
+    // 1000 requests in one batch, answered in order
+    for (int i = 1; i <= 1000; i++) {
+        client.send(i % 2 == 1 ? "PLAY 2" : "GET 2");
+    }
+    bool inOrder = true;
+    for (int i = 1; i <= 1000; i++) {
+        stringstream expected;
+        expected << "OK " << (i + 1) / 2;
+        inOrder = client.receive(response) && response == expected.str() && inOrder;
+    }
+    test_assert(inOrder, "Pipelined requests should be answered in order");
+
+    CatalogClient local;
+    test_assert(local.connectUnix(socketPath) && local.call("GET 2", response) && response == "OK 500",
+                "Unix socket client should see the same catalog");
+
+    const int NUM_CLIENTS = 4;
+    PlayWorker workers[NUM_CLIENTS];
+    pthread_t clients[NUM_CLIENTS];
+    for (int i = 0; i < NUM_CLIENTS; i++) {
+        workers[i].port = server.getPort();
+        workers[i].track = 0;
+        workers[i].ok = false;
+        pthread_create(&clients[i], NULL, playMany, &workers[i]);
+    }
+    bool allOk = true;
+    for (int i = 0; i < NUM_CLIENTS; i++) {
+        pthread_join(clients[i], NULL);
+        allOk = allOk && workers[i].ok;
+    }
+    test_assert(allOk && client.call("GET 0", response) && response == "OK 4000",
+                "Plays from many clients should all be counted");
+
+    server.stop();
+    pthread_join(thread, NULL);
+    test_assert(true, "stop() should end run() from another thread");
+}
+
+int connectRaw(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    connect(fd, (sockaddr*)&address, sizeof(address));
+    return fd;
+}
+
+string readAll(CatalogServer& server, int fd) {
+    for (int i = 0; i < 5; i++) {
+        server.poll(20);
+    }
+    char buffer[8192];
+    ssize_t got = recv(fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    return got > 0 ? string(buffer, got) : "";
+}
+
+void test_partial_requests() {
+    cout << "\n🧪 Testing Partial and Oversized Requests..." << endl;
+
+    TrackCatalog catalog;
+    buildCatalog(catalog);
+    CatalogServer server(catalog);
+    server.listenTcp(0);
+
+    int fd = connectRaw(server.getPort());
+    send(fd, "PI", 2, 0);
+    test_assert(readAll(server, fd) == "" && server.connectionCount() == 1, "Half a request should wait for the rest");
+    send(fd, "NG\nPLAY 2\nGE", 12, 0);
+    test_assert(readAll(server, fd) == "OK PONG\nOK 1\n", "A request split over two reads should be answered");
+    send(fd, "T 2\n", 4, 0);
+    test_assert(readAll(server, fd) == "OK 1\n", "The rest of a pipelined batch should follow");
+
+    string tooLong(CatalogServer::MAX_REQUEST_BYTES + 100, 'A');
+    send(fd, tooLong.data(), tooLong.size(), 0);
+    test_assert(readAll(server, fd) == "ERR request too long\n" && server.connectionCount() == 0,
+                "An oversized request should end the connection");
+    close(fd);
+
+    // A client that closes right after sending still gets its answers
+    fd = connectRaw(server.getPort());
+    send(fd, "PLAY 2\nGET 2\n", 13, 0);
+    shutdown(fd, SHUT_WR);
+    test_assert(readAll(server, fd) == "OK 2\nOK 2\n" && server.connectionCount() == 0,
+                "A half-closed client should be answered, then dropped");
+    close(fd);
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Catalog Server Tests" << endl;
+    cout << "==================================================" << endl;
+
+    test_protocol();
+    test_shard_commands();
+    test_network();
+    test_partial_requests();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All catalog server tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some catalog server tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
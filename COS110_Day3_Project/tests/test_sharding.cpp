@@ -0,0 +1,451 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <signal.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "../src/trackcatalog.h"
+#include "../src/catalogserver.h"
+#include "../src/catalogclient.h"
+#include "../src/shardrouter.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+struct ShardProcess {
+    pid_t pid;
+    string address;
+};
+
+/**
+ * Start a catalog server in a child process on an ephemeral port
+ * @return The child and its address ("port"), or pid -1 on failure
+ */
+ShardProcess startShard() {
+    ShardProcess shard = { -1, "" };
+    int ready[2];
+    if (pipe(ready) != 0) {
+        return shard;
+    }
+    cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(ready[0]);
+        TrackCatalog catalog;
+        CatalogServer server(catalog);
+        int port = server.listenTcp(0) ? server.getPort() : 0;
+        ssize_t written = write(ready[1], &port, sizeof(port));
+        close(ready[1]);
+        if (port > 0 && written == sizeof(port)) {
+            server.run();
+        }
+        _exit(0);
+    }
+    close(ready[1]);
+    int port = 0;
+    if (pid > 0 && read(ready[0], &port, sizeof(port)) == sizeof(port) && port > 0) {
+        stringstream ss;
+        ss << port;
+        shard.pid = pid;
+        shard.address = ss.str();
+    }
+    close(ready[0]);
+    return shard;
+}
+
+void stopShard(const ShardProcess& shard) {
+    if (shard.pid > 0) {
+        kill(shard.pid, SIGTERM);
+        waitpid(shard.pid, NULL, 0);
+    }
+}
+
+void test_hash_ring() {
+    cout << "\n🧪 Testing Consistent Hash Ring..." << endl;
+
+    HashRing ring;
+    test_assert(ring.owner(42) == -1 && ring.nodeCount() == 0, "An empty ring should own nothing");
+
+    ring.addNode(0, "shard-a");
+    ring.addNode(1, "shard-b");
+    ring.addNode(2, "shard-c");
+    const int NUM_KEYS = 30000;
+    vector<int> before(NUM_KEYS);
+    int perNode[4] = { 0, 0, 0, 0 };
+    for (int key = 0; key < NUM_KEYS; key++) {
+        before[key] = ring.owner(key);
+        perNode[before[key]]++;
+    }
+    test_assert(ring.nodeCount() == 3 && perNode[0] > NUM_KEYS / 6 && perNode[1] > NUM_KEYS / 6 &&
+                perNode[2] > NUM_KEYS / 6, "Keys should spread over every node");
+
+    ring.addNode(3, "shard-d");
+    int moved = 0;
+    bool onlyToNewNode = true;
+    for (int key = 0; key < NUM_KEYS; key++) {
+        int now = ring.owner(key);
+        if (now != before[key]) {
+            moved++;
+            onlyToNewNode = onlyToNewNode && now == 3;
+        }
+    }
+    test_assert(onlyToNewNode && moved > NUM_KEYS / 8 && moved < NUM_KEYS * 3 / 8,
+                "Adding a node should only move about 1/4 of the keys, all to it");
+
+    ring.removeNode(3);
+    bool restored = true;
+    for (int key = 0; key < NUM_KEYS; key++) {
+        restored = restored && ring.owner(key) == before[key];
+    }
+    test_assert(restored && ring.nodeCount() == 3, "Removing the node should give its keys back");
+}
+
+/**
+ * Reference catalog built next to the router, for comparing answers
+ */
+void addBoth(ShardRouter& router, TrackCatalog& reference, int count) {
+    for (int i = 0; i < count; i++) {
+        stringstream title;
+        title << "Shard Session " << reference.size();
+        router.addTrack(title.str(), 150 + i % 200, i % 3 == 0 ? "R&B" : "Hip-Hop");
+        reference.addTrack(title.str(), 150 + i % 200, i % 3 == 0 ? "R&B" : "Hip-Hop");
+    }
+}
+
+bool sameAsReference(ShardRouter& router, TrackCatalog& reference) {
+    if (router.size() != reference.size()) {
+        return false;
+    }
+    for (int id = 0; id < reference.size(); id++) {
+        if (router.getPlayCount(id) != reference.getPlayCount(id) || router.getTitle(id) != reference.getTitle(id)) {
+            return false;
+        }
+    }
+    return router.totalPlays() == reference.playCountStats().sum && router.countPopular() == reference.countPopular();
+}
+
+void test_routing(const vector<ShardProcess>& processes) {
+    cout << "\n🧪 Testing Routed Catalog..." << endl;
+
+    ShardRouter router;
+    test_assert(router.addTrack("Bella", 206, "Hip-Hop") == -1, "Adding a track without shards should fail");
+    test_assert(router.addShard("1") == -1 && router.shardCount() == 0, "An unreachable shard should be refused");
+    for (int i = 0; i < 3; i++) {
+        router.addShard(processes[i].address);
+    }
+    test_assert(router.shardCount() == 3 && router.getLastMoveCount() == 0, "Three shards should connect");
+
+    TrackCatalog reference;
+    reference.enablePopularityIndex();
+    const int NUM_TRACKS = 3000;
+    addBoth(router, reference, NUM_TRACKS);
+    int perShard[3] = { 0, 0, 0 };
+    for (int id = 0; id < NUM_TRACKS; id++) {
+        perShard[router.getShardOf(id)]++;
+    }
+    test_assert(router.size() == NUM_TRACKS && perShard[0] > 500 && perShard[1] > 500 && perShard[2] > 500,
+                "Tracks should be spread over the shards");
+
+    test_assert(router.play(7) && router.play(7, 9) && router.getPlayCount(7) == 10 &&
+                router.setPlayCount(8, 1500000) && router.isPopular(8) && !router.isPopular(7) &&
+                router.getTitle(8) == "Shard Session 8", "Single-track calls should be forwarded");
+    reference.setPlayCount(7, 10);
+    reference.setPlayCount(8, 1500000);
+    test_assert(!router.play(NUM_TRACKS) && router.getPlayCount(-1) == 0 && router.getTitle(NUM_TRACKS) == "",
+                "Invalid ids should not be forwarded");
+
+    // 20000 events over all shards, with some duplicates and bad ids
+    vector<PlayEvent> events;
+    unsigned int seed = 12345u;
+    for (int i = 0; i < 20000; i++) {
+        seed = seed * 1103515245u + 12345u;
+        PlayEvent event = { (int)((seed >> 8) % (NUM_TRACKS + 10)), 1 + (int)((seed >> 4) % 50) * 1000 };
+        events.push_back(event);
+    }
+    vector<PlayEvent> referenceEvents = events;
+    int applied = router.applyPlayEvents(&events[0], (int)events.size());
+    test_assert(applied == reference.applyPlayEvents(&referenceEvents[0], (int)referenceEvents.size()) &&
+                applied < 20000, "A batch should apply the same events as one catalog");
+    test_assert(sameAsReference(router, reference), "Counts, totals and popular tracks should match one catalog");
+
+    vector<int> top = router.topTracks(10);
+    vector<int> expected = reference.topTracks(10);
+    test_assert(top == expected, "Top tracks should be merged from every shard");
+
+    // Rebalance onto a fourth shard
+    vector<int> before(NUM_TRACKS);
+    for (int id = 0; id < NUM_TRACKS; id++) {
+        before[id] = router.getShardOf(id);
+    }
+    int added = router.addShard(processes[3].address);
+    int moved = 0;
+    bool onlyToNewShard = true;
+    for (int id = 0; id < NUM_TRACKS; id++) {
+        if (router.getShardOf(id) != before[id]) {
+            moved++;
+            onlyToNewShard = onlyToNewShard && router.getShardOf(id) == added;
+        }
+    }
+    test_assert(added == 3 && router.shardCount() == 4 && moved == router.getLastMoveCount() &&
+                onlyToNewShard && moved > NUM_TRACKS / 8 && moved < NUM_TRACKS * 3 / 8,
+                "A new shard should take about 1/4 of the tracks");
+    test_assert(sameAsReference(router, reference) && router.topTracks(10) == expected,
+                "Moved tracks should keep their plays and titles");
+
+    // Remove a shard: only its own tracks move
+    for (int id = 0; id < NUM_TRACKS; id++) {
+        before[id] = router.getShardOf(id);
+    }
+    test_assert(router.removeShard(1) && router.shardCount() == 3 && !router.removeShard(1),
+                "A shard should be removed once");
+    bool onlyItsTracks = true;
+    moved = 0;
+    for (int id = 0; id < NUM_TRACKS; id++) {
+        if (router.getShardOf(id) != before[id]) {
+            moved++;
+            onlyItsTracks = onlyItsTracks && before[id] == 1;
+        }
+        onlyItsTracks = onlyItsTracks && router.getShardOf(id) != 1;
+    }
+    test_assert(onlyItsTracks && moved == router.getLastMoveCount() && moved > 0,
+                "Removing a shard should only move its tracks");
+
+    router.play(NUM_TRACKS - 1, 2000000);
+    reference.setPlayCount(NUM_TRACKS - 1, reference.getPlayCount(NUM_TRACKS - 1) + 2000000);
+    addBoth(router, reference, 100);
+    test_assert(sameAsReference(router, reference) && router.topTracks(25) == reference.topTracks(25),
+                "The catalog should keep working after rebalancing");
+
+    test_assert(router.removeShard(0) && router.removeShard(2) && !router.removeShard(3) &&
+                router.shardCount() == 1 && sameAsReference(router, reference),
+                "The last shard holding tracks should not be removed");
+}
+
+/**
+ * TCP proxy in front of one shard that stops passing requests on after
+ * lineLimit request lines: the shard still answers the ones it got,
+ * then the connection closes, as if the shard had died mid-batch
+ */
+struct CuttingProxy {
+    int listenFd;
+    int port;
+    int targetPort;
+    int forwardedLines;     // request lines passed on so far
+    int lineLimit;          // -1 for no limit
+    pthread_t thread;
+};
+
+int connectLocal(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons((uint16_t)port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void* runProxy(void* arg) {
+    CuttingProxy* proxy = (CuttingProxy*)arg;
+    int clientFd = accept(proxy->listenFd, NULL, NULL);
+    int shardFd = connectLocal(proxy->targetPort);
+    bool cut = false;
+    char buffer[16 * 1024];
+    while (clientFd >= 0 && shardFd >= 0) {
+        pollfd fds[2] = { { clientFd, (short)(cut ? 0 : POLLIN), 0 }, { shardFd, POLLIN, 0 } };
+        poll(fds, 2, -1);
+        if (fds[0].revents != 0) {
+            ssize_t got = recv(clientFd, buffer, sizeof(buffer), 0);
+            if (got <= 0) {
+                break;
+            }
+            ssize_t pass = got;
+            int limit = __atomic_load_n(&proxy->lineLimit, __ATOMIC_ACQUIRE);
+            for (ssize_t i = 0; i < got && !cut; i++) {
+                if (buffer[i] == '\n' && __atomic_add_fetch(&proxy->forwardedLines, 1, __ATOMIC_RELEASE) == limit) {
+                    pass = i + 1;
+                    cut = true;
+                }
+            }
+            send(shardFd, buffer, pass, MSG_NOSIGNAL);
+            if (cut) {
+                shutdown(shardFd, SHUT_WR);
+            }
+        }
+        if (fds[1].revents != 0) {
+            ssize_t got = recv(shardFd, buffer, sizeof(buffer), 0);
+            if (got <= 0) {
+                break;
+            }
+            send(clientFd, buffer, got, MSG_NOSIGNAL);
+        }
+    }
+    close(clientFd);
+    close(shardFd);
+    return NULL;
+}
+
+bool startProxy(CuttingProxy& proxy, const string& target) {
+    proxy.targetPort = atoi(target.c_str());
+    proxy.forwardedLines = 0;
+    proxy.lineLimit = -1;
+    proxy.listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (bind(proxy.listenFd, (sockaddr*)&address, sizeof(address)) != 0 || listen(proxy.listenFd, 1) != 0 ||
+        getsockname(proxy.listenFd, (sockaddr*)&address, &length) != 0) {
+        return false;
+    }
+    proxy.port = ntohs(address.sin_port);
+    return pthread_create(&proxy.thread, NULL, runProxy, &proxy) == 0;
+}
+
+void test_failed_move() {
+    cout << "\n🧪 Testing A Shard Failing Mid-Move..." << endl;
+
+    vector<ShardProcess> processes;
+    for (int i = 0; i < 4; i++) {
+        processes.push_back(startShard());
+    }
+    CuttingProxy proxy;
+    bool started = startProxy(proxy, processes[0].address);
+    for (size_t i = 0; i < processes.size(); i++) {
+        started = started && processes[i].pid > 0;
+    }
+    test_assert(started, "Shards and the proxy should start");
+    if (!started) {
+        return;
+    }
+
+    // Shard 0 is reached through the proxy
+    stringstream proxied;
+    proxied << proxy.port;
+    ShardRouter router;
+    HashRing ring;
+    router.addShard(proxied.str());
+    ring.addNode(0, proxied.str());
+    for (int i = 1; i < 3; i++) {
+        router.addShard(processes[i].address);
+        ring.addNode(i, processes[i].address);
+    }
+    TrackCatalog reference;
+    const int NUM_TRACKS = 3000;
+    addBoth(router, reference, NUM_TRACKS);
+    for (int id = 0; id < NUM_TRACKS; id++) {
+        router.setPlayCount(id, 1000 + id);
+        reference.setPlayCount(id, 1000 + id);
+    }
+
+    // Let shard 0 answer every TRACK but only half of its SET 0 requests
+    ring.addNode(3, processes[3].address);
+    int moving = 0;
+    int movingFromProxied = 0;
+    for (int id = 0; id < NUM_TRACKS; id++) {
+        if (ring.owner(id) == 3) {
+            moving++;
+            movingFromProxied += router.getShardOf(id) == 0 ? 1 : 0;
+        }
+    }
+    int zeroed = movingFromProxied / 2;
+    __atomic_store_n(&proxy.lineLimit, __atomic_load_n(&proxy.forwardedLines, __ATOMIC_ACQUIRE) + movingFromProxied + zeroed,
+                     __ATOMIC_RELEASE);
+
+    int added = router.addShard(processes[3].address);
+    int expectedMoves = moving - movingFromProxied + zeroed;
+    test_assert(added == 3 && movingFromProxied > 0 && router.getLastMoveCount() == expectedMoves,
+                "Moves that completed before the failure should be kept and counted");
+
+    int onNewShard = 0;
+    long long expectedPlays = 0;
+    bool playsKept = true;
+    bool stayed = true;
+    for (int id = 0; id < NUM_TRACKS; id++) {
+        if (router.getShardOf(id) == 3) {
+            onNewShard++;
+            expectedPlays += reference.getPlayCount(id);
+            playsKept = playsKept && router.getPlayCount(id) == reference.getPlayCount(id);
+        } else if (ring.owner(id) == 3) {
+            stayed = stayed && router.getShardOf(id) == 0;
+        }
+    }
+    test_assert(onNewShard == expectedMoves && playsKept && stayed,
+                "Tracks that did not move should stay on the failed shard");
+
+    // Copies of the unfinished moves are on the new shard but must hold no plays
+    CatalogClient direct;
+    string stats;
+    stringstream expected;
+    expected << "OK " << moving << " " << expectedPlays << " 0";
+    test_assert(direct.connectTcp("127.0.0.1", atoi(processes[3].address.c_str())) && direct.call("STATS", stats) &&
+                stats == expected.str(), "Copies of unfinished moves should be zeroed, not counted twice");
+
+    pthread_join(proxy.thread, NULL);
+    close(proxy.listenFd);
+    for (size_t i = 0; i < processes.size(); i++) {
+        stopShard(processes[i]);
+    }
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Sharded Catalog Tests" << endl;
+    cout << "===================================================" << endl;
+
+    test_hash_ring();
+
+    vector<ShardProcess> processes;
+    for (int i = 0; i < 4; i++) {
+        processes.push_back(startShard());
+    }
+    bool started = true;
+    for (size_t i = 0; i < processes.size(); i++) {
+        started = started && processes[i].pid > 0;
+    }
+    test_assert(started, "Four shard processes should start");
+    if (started) {
+        test_routing(processes);
+    }
+    for (size_t i = 0; i < processes.size(); i++) {
+        stopShard(processes[i]);
+    }
+    test_failed_move();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All sharded catalog tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some sharded catalog tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include "../src/playsketch.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+bool within(long long estimate, long long actual, double tolerance) {
+    double error = (double)(estimate - actual) / (double)actual;
+    return error <= tolerance && error >= -tolerance;
+}
+
+/**
+ * Play stream for the heavy-hitter tests: key 1000 + k (k < 10) gets
+ * 2000 - 100 * k plays from as many listeners, then 50000 keys that
+ * nobody will add to a catalog get 1 play each. Events are interleaved
+ * so no part of the stream is sorted.
+ */
+struct StreamEvent {
+    uint64_t key;
+    uint64_t listener;
+};
+
+vector<StreamEvent> buildStream() {
+    vector<StreamEvent> stream;
+    for (int round = 0; round < 2000; round++) {
+        for (int k = 0; k < 10; k++) {
+            if (round < 2000 - 100 * k) {
+                StreamEvent event = { (uint64_t)(1000 + k), (uint64_t)round };
+                stream.push_back(event);
+            }
+        }
+        for (int n = 0; n < 25; n++) {
+            StreamEvent noise = { (uint64_t)(1000000 + round * 25 + n), (uint64_t)round };
+            stream.push_back(noise);
+        }
+    }
+    return stream;
+}
+
+void test_count_min() {
+    cout << "\n🧪 Testing Count-Min Sketch..." << endl;
+
+    CountMinSketch sketch(1000, 4);
+    test_assert(sketch.getWidth() == 1024 && sketch.getDepth() == 4 && sketch.memoryBytes() == 1024 * 4 * 4,
+                "Width should round up to a power of two");
+
+    bool neverBelow = true;
+    for (uint64_t key = 0; key < 5000; key++) {
+        sketch.add(key, (int)(key % 7) + 1);
+    }
+    long long overcount = 0;
+    for (uint64_t key = 0; key < 5000; key++) {
+        long long estimate = sketch.estimate(key);
+        neverBelow = neverBelow && estimate >= (long long)(key % 7) + 1;
+        overcount += estimate - (long long)(key % 7) - 1;
+    }
+    test_assert(neverBelow, "Estimates should never be below the true count");
+    test_assert(overcount / 5000 < 40, "Estimates should stay close on average");
+    test_assert(sketch.add(7, 0) == sketch.estimate(7), "A zero count should only read");
+
+    CountMinSketch left(1024, 4);
+    CountMinSketch right(1024, 4);
+    left.add(42, 10);
+    right.add(42, 5);
+    test_assert(left.merge(right) && left.estimate(42) == 15, "Merged sketches should add up");
+    test_assert(!left.merge(CountMinSketch(2048, 4)), "Sketches of a different size should not merge");
+}
+
+void test_hyperloglog() {
+    cout << "\n🧪 Testing HyperLogLog..." << endl;
+
+    HyperLogLog listeners;
+    test_assert(listeners.estimate() == 0 && listeners.memoryBytes() == 1024, "A new sketch should be empty");
+    for (uint64_t id = 0; id < 100; id++) {
+        listeners.add(id);
+        listeners.add(id);
+    }
+    test_assert(within(listeners.estimate(), 100, 0.05), "Small sets should be counted almost exactly");
+
+    HyperLogLog big(12);
+    HyperLogLog firstHalf(12);
+    HyperLogLog secondHalf(12);
+    for (uint64_t id = 0; id < 200000; id++) {
+        big.add(id * 31 + 7);
+        (id % 2 == 0 ? firstHalf : secondHalf).add(id * 31 + 7);
+    }
+    test_assert(within(big.estimate(), 200000, 0.05), "Large sets should be within a few percent");
+    test_assert(firstHalf.merge(secondHalf) && firstHalf.estimate() == big.estimate(), "Merging should give the union");
+    test_assert(!firstHalf.merge(HyperLogLog(10)), "Different precisions should not merge");
+}
+
+void test_heavy_hitters() {
+    cout << "\n🧪 Testing Heavy Hitters..." << endl;
+
+    vector<StreamEvent> stream = buildStream();
+    PlayStreamSketch sketch(4096, 4, 20, 10);
+    for (size_t i = 0; i < stream.size(); i++) {
+        sketch.record(stream[i].key, stream[i].listener);
+    }
+    sketch.record(1000, 1, 0);
+
+    vector<HeavyHitter> hitters = sketch.heavyHitters();
+    bool topTen = hitters.size() == 20;
+    for (int k = 0; k < 10 && topTen; k++) {
+        topTen = hitters[k].key == (uint64_t)(1000 + k) && hitters[k].plays >= 2000 - 100 * k;
+    }
+    test_assert(topTen, "The ten most played keys should lead the candidates");
+    test_assert(sketch.getTotalPlays() == (long long)stream.size(), "Every play should be counted");
+    test_assert(within(sketch.estimateListeners(1000), 2000, 0.1) && within(sketch.estimateListeners(1009), 1100, 0.1),
+                "Listeners should be estimated per candidate");
+    test_assert(sketch.estimateListeners(1000001) == 0, "Keys that are not candidates have no listener count");
+
+    size_t bound = sketch.memoryBytes();
+    for (uint64_t key = 5000000; key < 5100000; key++) {
+        sketch.record(key, key);
+    }
+    test_assert(sketch.memoryBytes() == bound, "Memory should not grow with the number of keys");
+    test_assert(!sketch.merge(PlayStreamSketch(4096, 4, 50, 10)), "Different settings should not merge");
+}
+
+struct IngestWorker {
+    const vector<StreamEvent>* stream;
+    int first;
+    int step;
+    PlayStreamSketch sketch;
+
+    IngestWorker() : stream(NULL), first(0), step(1), sketch(4096, 4, 20, 10) {
+    }
+};
+
+void* ingest(void* arg) {
+    IngestWorker* worker = (IngestWorker*)arg;
+    for (size_t i = worker->first; i < worker->stream->size(); i += worker->step) {
+        worker->sketch.record((*worker->stream)[i].key, (*worker->stream)[i].listener);
+    }
+    return NULL;
+}
+
+void test_merge_threads() {
+    cout << "\n🧪 Testing Per-Thread Sketches..." << endl;
+
+    const int NUM_THREADS = 4;
+    vector<StreamEvent> stream = buildStream();
+    IngestWorker workers[NUM_THREADS];
+    pthread_t threads[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        workers[i].stream = &stream;
+        workers[i].first = i;
+        workers[i].step = NUM_THREADS;
+        pthread_create(&threads[i], NULL, ingest, &workers[i]);
+    }
+    for (int i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    PlayStreamSketch merged(4096, 4, 20, 10);
+    PlayStreamSketch single(4096, 4, 20, 10);
+    for (int i = 0; i < NUM_THREADS; i++) {
+        merged.merge(workers[i].sketch);
+    }
+    for (size_t i = 0; i < stream.size(); i++) {
+        single.record(stream[i].key, stream[i].listener);
+    }
+
+    bool sameEstimates = merged.getTotalPlays() == single.getTotalPlays();
+    for (uint64_t key = 1000; key < 1010; key++) {
+        sameEstimates = sameEstimates && merged.estimatePlays(key) == single.estimatePlays(key);
+    }
+    test_assert(sameEstimates, "Merged thread sketches should count like one sketch");
+
+    vector<HeavyHitter> hitters = merged.heavyHitters();
+    bool topTen = hitters.size() == 20;
+    for (int k = 0; k < 10 && topTen; k++) {
+        topTen = hitters[k].key == (uint64_t)(1000 + k) && hitters[k].plays == single.estimatePlays(1000 + k);
+    }
+    test_assert(topTen, "Merged candidates should find the same heavy hitters");
+    test_assert(within(merged.estimateListeners(1000), 2000, 0.1), "Listeners should merge across threads");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Play Sketch Tests" << endl;
+    cout << "===============================================" << endl;
+
+    test_count_min();
+    test_hyperloglog();
+    test_heavy_hitters();
+    test_merge_threads();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All play sketch tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some play sketch tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+// Reference prefix search: scan, then sort by (title, id)
+const TrackCatalog* sortCatalog = NULL;
+
+bool titleThenId(int a, int b) {
+    string ta = sortCatalog->getTitle(a);
+    string tb = sortCatalog->getTitle(b);
+    return ta < tb || (ta == tb && a < b);
+}
+
+vector<int> scanPrefix(const TrackCatalog& catalog, const string& prefix, int limit) {
+    vector<int> ids;
+    for (int i = 0; i < catalog.size(); i++) {
+        if (catalog.getTitle(i).compare(0, prefix.size(), prefix) == 0) {
+            ids.push_back(i);
+        }
+    }
+    sortCatalog = &catalog;
+    sort(ids.begin(), ids.end(), titleThenId);
+    if ((int)ids.size() > limit) {
+        ids.resize(limit);
+    }
+    return ids;
+}
+
+void addDiscography(TrackCatalog& catalog) {
+    catalog.addTrack("Bella", 206, "Hip-Hop");                 // 0
+    catalog.addTrack("Est-ce que tu m'aimes", 234, "Pop");     // 1
+    catalog.addTrack("Où aller", 267, "R&B");                  // 2
+    catalog.addTrack("J'me tire", 205, "Hip-Hop");             // 3
+    catalog.addTrack("Zombie", 223, "Hip-Hop");                // 4
+    catalog.addTrack("Bella", 210, "Hip-Hop");                 // 5 (live version)
+    catalog.addTrack("Oui ou non", 190, "Pop");                // 6
+    catalog.addTrack("J'me tue à vous le dire", 220, "Pop");   // 7
+}
+
+void test_exact_lookup() {
+    cout << "\n🧪 Testing Exact Title Lookup..." << endl;
+
+    TrackCatalog catalog;
+    addDiscography(catalog);
+    test_assert(catalog.findTitle("Zombie") == 4, "Scan fallback should find a title");
+
+    catalog.enableTitleIndex();
+    test_assert(catalog.hasTitleIndex(), "Title index should be enabled");
+    test_assert(catalog.findTitle("Où aller") == 2, "Accented title should be found");
+    test_assert(catalog.findTitle("J'me tire") == 3, "Title with an apostrophe should be found");
+    test_assert(catalog.findTitle("Bella") == 0, "Duplicate titles should return the lowest id");
+    test_assert(catalog.findTitle("Bell") == -1 && catalog.findTitle("Bellaa") == -1,
+                "Only exact matches should be found");
+    test_assert(catalog.findTitle("ou aller") == -1, "Lookup should be accent- and case-sensitive");
+}
+
+void test_prefix_lookup() {
+    cout << "\n🧪 Testing Prefix Title Lookup..." << endl;
+
+    TrackCatalog catalog;
+    addDiscography(catalog);
+    test_assert(catalog.findTitlePrefix("Bel", 10).empty(), "Prefix search should need the index");
+    catalog.enableTitleIndex();
+
+    vector<int> jme = catalog.findTitlePrefix("J'me", 10);
+    test_assert(jme.size() == 2 && jme[0] == 3 && jme[1] == 7, "Prefix should list matches in title order");
+
+    vector<int> o = catalog.findTitlePrefix("O", 10);
+    test_assert(o.size() == 2 && o[0] == 6 && o[1] == 2, "Accented titles should sort after plain ones");
+    test_assert(catalog.findTitlePrefix("Où", 10).size() == 1, "Accented prefix should match");
+
+    vector<int> bella = catalog.findTitlePrefix("Bella", 1);
+    test_assert(bella.size() == 1 && bella[0] == 0, "limit should cap the results");
+    test_assert(catalog.findTitlePrefix("", 100).size() == 8, "Empty prefix should list every track");
+    test_assert(catalog.findTitlePrefix("Xyz", 10).empty(), "Unknown prefix should match nothing");
+}
+
+void test_incremental_updates() {
+    cout << "\n🧪 Testing Title Index Updates..." << endl;
+
+    TrackCatalog catalog;
+    addDiscography(catalog);
+    catalog.enableTitleIndex();
+
+    catalog.setTitle(4, "Zombie (remix)");
+    test_assert(catalog.findTitle("Zombie") == -1, "Old title should disappear after setTitle()");
+    test_assert(catalog.findTitle("Zombie (remix)") == 4, "New title should be found after setTitle()");
+
+    catalog.setTitle(4, "Sapés comme jamais");
+    catalog.setTitle(0, "Tout donner");
+    test_assert(catalog.findTitle("Zombie (remix)") == -1 && catalog.findTitle("Sapés comme jamais") == 4,
+                "Renaming twice should keep only the latest title");
+    test_assert(catalog.findTitle("Bella") == 5, "Other track with the old title should still be found");
+
+    catalog.setTitle(0, "Bella");
+    test_assert(catalog.findTitle("Bella") == 0, "Renaming back should restore the lookup");
+
+    int added = catalog.addTrack("Bella ciao", 200, "Pop");
+    vector<int> bella = catalog.findTitlePrefix("Bella", 10);
+    test_assert(bella.size() == 3 && bella[2] == added, "Added tracks should be indexed");
+
+    catalog.setTitle(3, "");
+    test_assert(catalog.findTitle("Untitled Track") == 3, "Empty title should be indexed as 'Untitled Track'");
+
+    catalog.compactTitles();
+    test_assert(catalog.findTitle("Sapés comme jamais") == 4 && catalog.findTitlePrefix("Bella", 10) == bella,
+                "Index should survive compactTitles()");
+}
+
+void test_against_scan() {
+    cout << "\n🧪 Testing Title Index Against Full Scans..." << endl;
+
+    const int NUM_TRACKS = 5000;
+    const char* WORDS[] = { "Bella", "Zombie", "Où", "J'me", "Tout", "Est-ce", "Sapés", "Laissez" };
+
+    TrackCatalog catalog;
+    srand(110);
+    for (int i = 0; i < NUM_TRACKS; i++) {
+        stringstream ss;
+        ss << WORDS[rand() % 8] << " " << rand() % 100;
+        catalog.addTrack(ss.str(), 180, "Pop");
+    }
+    catalog.enableTitleIndex();
+
+    // Enough renames and adds to go through several merges
+    for (int step = 0; step < 6000; step++) {
+        stringstream ss;
+        ss << WORDS[rand() % 8] << " " << rand() % 100;
+        if (step % 10 == 0) {
+            catalog.addTrack(ss.str(), 180, "Pop");
+        } else {
+            catalog.setTitle(rand() % catalog.size(), ss.str());
+        }
+    }
+
+    bool prefixesMatch = true;
+    const char* PREFIXES[] = { "B", "Bella 1", "Où", "J'me 4", "Sapés 99", "Z", "" };
+    for (int p = 0; p < 7; p++) {
+        prefixesMatch = prefixesMatch && catalog.findTitlePrefix(PREFIXES[p], 50) == scanPrefix(catalog, PREFIXES[p], 50);
+        prefixesMatch = prefixesMatch && catalog.findTitlePrefix(PREFIXES[p], 100000) ==
+                                         scanPrefix(catalog, PREFIXES[p], 100000);
+    }
+    test_assert(prefixesMatch, "Prefix results should match a sorted scan");
+
+    bool exactMatches = true;
+    for (int i = 0; i < catalog.size(); i += 13) {
+        string title = catalog.getTitle(i);
+        vector<int> expected = scanPrefix(catalog, title, 100000);
+        int lowest = catalog.size();
+        for (size_t k = 0; k < expected.size(); k++) {
+            if (catalog.getTitle(expected[k]) == title && expected[k] < lowest) {
+                lowest = expected[k];
+            }
+        }
+        exactMatches = exactMatches && catalog.findTitle(title) == lowest;
+    }
+    test_assert(exactMatches, "Exact lookups should match a scan");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Title Index Tests" << endl;
+    cout << "===============================================" << endl;
+
+    test_exact_lookup();
+    test_prefix_lookup();
+    test_incremental_updates();
+    test_against_scan();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All title index tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some title index tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}
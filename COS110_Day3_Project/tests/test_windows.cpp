@@ -0,0 +1,155 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include "../src/playwindows.h"
+#include "../src/trackcatalog.h"
+
+using namespace std;
+
+// Test counter for scoring
+int tests_passed = 0;
+int total_tests = 0;
+
+void test_assert(bool condition, const string& test_name) {
+    total_tests++;
+    if (condition) {
+        cout << "✅ " << test_name << " - PASSED" << endl;
+        tests_passed++;
+    } else {
+        cout << "❌ " << test_name << " - FAILED" << endl;
+    }
+}
+
+// Fake clock, moved by hand
+long long fakeSeconds = 1000000;
+
+long long fakeClock() {
+    return fakeSeconds;
+}
+
+void test_windows() {
+    cout << "\n🧪 Testing Play Windows..." << endl;
+
+    PlayWindows windows(fakeClock);
+    windows.addTrack();
+    windows.addTrack();
+    long long start = windows.now();
+
+    windows.record(0, 5, start);
+    windows.record(0, 1, start + 10);
+    test_assert(windows.getPlays(0, PLAY_WINDOW_MINUTE, start + 10) == 6 &&
+                windows.getPlays(0, PLAY_WINDOW_HOUR, start + 10) == 6 &&
+                windows.getPlays(0, PLAY_WINDOW_DAY, start + 10) == 6, "Plays should count in every window");
+    test_assert(windows.getPlays(1, PLAY_WINDOW_DAY, start) == 0 && windows.getPlays(7, PLAY_WINDOW_DAY, start) == 0,
+                "Unplayed and invalid tracks should have no plays");
+
+    // Reads move with the clock even without new plays
+    test_assert(windows.getPlays(0, PLAY_WINDOW_MINUTE, start + 120) == 0 &&
+                windows.getPlays(0, PLAY_WINDOW_HOUR, start + 120) == 6, "The minute window should expire first");
+    test_assert(windows.getPlays(0, PLAY_WINDOW_HOUR, start + 2 * 3600) == 0 &&
+                windows.getPlays(0, PLAY_WINDOW_DAY, start + 2 * 3600) == 6, "The hour window should expire next");
+    test_assert(windows.getPlays(0, PLAY_WINDOW_DAY, start + 2 * 86400) == 0, "Nothing should outlive the day window");
+
+    // Old buckets are cleared when the ring comes round again
+    windows.record(0, 2, start + 2 * 86400);
+    test_assert(windows.getPlays(0, PLAY_WINDOW_DAY, start + 2 * 86400) == 2, "Reused buckets should start from zero");
+
+    // A window is the current bucket plus the previous ones
+    windows.record(1, 1, start);
+    windows.record(1, 1, start + 30);
+    test_assert(windows.getPlays(1, PLAY_WINDOW_MINUTE, start + 30) == 2, "Plays within a minute should add up");
+    test_assert(windows.getPlays(1, PLAY_WINDOW_MINUTE, start + 75) == 1, "Plays a minute old should drop out");
+
+    windows.record(1, 1, start);
+    test_assert(windows.getPlays(1, PLAY_WINDOW_MINUTE, start + 30) == 3, "A clock that goes back should count as now");
+    windows.record(1, 0, start + 30);
+    windows.record(1, -4, start + 30);
+    test_assert(windows.getPlays(1, PLAY_WINDOW_MINUTE, start + 30) == 3, "Non-positive counts should be ignored");
+}
+
+void test_trending() {
+    cout << "\n🧪 Testing Trending Tracks..." << endl;
+
+    PlayWindows windows(fakeClock);
+    for (int id = 0; id < 4; id++) {
+        windows.addTrack();
+    }
+    long long start = fakeSeconds;
+
+    // Track 0 was big this morning, track 1 is taking off now
+    windows.record(0, 10000, start);
+    windows.record(2, 50, start);
+    long long later = start + 8 * 3600;
+    windows.record(0, 100, later);
+    windows.record(1, 500, later);
+    windows.record(2, 30, later);
+
+    test_assert(windows.trendScore(1, later) == 500 - 500 / 24 && windows.trendScore(0, later) < 0,
+                "Trend should compare the hour with the day's average hour");
+    vector<int> trending = windows.trendingTracks(10, later);
+    test_assert(trending.size() == 2 && trending[0] == 1 && trending[1] == 2, "Rising tracks should rank first");
+    test_assert(windows.trendingTracks(1, later) == vector<int>(1, 1), "k should cap the result");
+    test_assert(windows.trendingTracks(0, later).empty(), "k = 0 should return nothing");
+}
+
+void test_catalog_windows() {
+    cout << "\n🧪 Testing Catalog Play Windows..." << endl;
+
+    TrackCatalog catalog;
+    int bella = catalog.addTrack("Bella", 206, "Hip-Hop");
+    int zombie = catalog.addTrack("Zombie", 190, "Pop");
+    catalog.setPlayCount(bella, 2000000);
+    test_assert(catalog.getRecentPlays(bella, PLAY_WINDOW_DAY) == 0 && catalog.trendingTracks(5).empty(),
+                "Windows should be off by default");
+
+    catalog.enablePlayWindows(fakeClock);
+    int tout = catalog.addTrack("Tout donner", 240, "R&B");
+    catalog.play(bella);
+    catalog.play(tout);
+    catalog.play(tout);
+    PlayEvent events[3] = { { zombie, 4 }, { tout, 3 }, { bella, -1 } };
+    catalog.applyPlayEvents(events, 3);
+    catalog.resetPlayCount(tout);
+
+    test_assert(catalog.hasPlayWindows() && catalog.getRecentPlays(bella, PLAY_WINDOW_MINUTE) == 1 &&
+                catalog.getRecentPlays(zombie, PLAY_WINDOW_MINUTE) == 4 &&
+                catalog.getRecentPlays(tout, PLAY_WINDOW_MINUTE) == 5, "Plays and play events should be counted");
+    test_assert(catalog.getPlayCount(bella) == 2000000 && catalog.getPlayCount(tout) == 0,
+                "The lifetime count should be unchanged");
+
+    catalog.enableConcurrentPlays();
+    catalog.play(zombie);
+    catalog.play(zombie);
+    test_assert(catalog.getRecentPlays(zombie, PLAY_WINDOW_MINUTE) == 4, "Concurrent plays should wait for collection");
+    catalog.collectConcurrentPlays();
+    test_assert(catalog.getRecentPlays(zombie, PLAY_WINDOW_MINUTE) == 6, "Collected plays should be counted");
+
+    vector<int> trending = catalog.trendingTracks(3);
+    test_assert(trending.size() == 3 && trending[0] == zombie && trending[1] == tout && trending[2] == bella,
+                "Trending should rank by recent plays");
+
+    fakeSeconds += 120;
+    test_assert(catalog.getRecentPlays(zombie, PLAY_WINDOW_MINUTE) == 0 &&
+                catalog.getRecentPlays(zombie, PLAY_WINDOW_HOUR) == 6, "Catalog windows should follow the clock");
+}
+
+int main() {
+    cout << "🎵 Maître Gims Music Studio - Play Window Tests" << endl;
+    cout << "===============================================" << endl;
+
+    test_windows();
+    test_trending();
+    test_catalog_windows();
+
+    cout << "\n📊 Test Results:" << endl;
+    cout << "Tests Passed: " << tests_passed << "/" << total_tests << endl;
+
+    if (tests_passed == total_tests) {
+        cout << "🎉 All play window tests passed!" << endl;
+    } else {
+        cout << "⚠️  Some play window tests failed." << endl;
+    }
+
+    return (tests_passed == total_tests) ? 0 : 1;
+}